@@ -8,6 +8,8 @@
 #include <sys/socket.h> // socket, bind, listen, accept...
 #include <unistd.h>     // close
 
+#include "packets.h" // [Lv.6] UdpBlast 스키마
+
 using namespace std;
 using namespace std::chrono;
 
@@ -16,12 +18,10 @@ using namespace std::chrono;
 // 이 값을 늘릴수록 서버가 느려지고, TCP 속도 저하와 UDP 유실이 심해집니다.
 const int SERVER_DELAY_US = 100;
 
-// [UDP용 패킷 구조체]
-// 1024 바이트 크기에 맞춤 (int 4 + char 1020)
-struct UdpPacket {
-  int seq;         // 일련번호 (0, 1, 2...)
-  char data[1020]; // 더미 데이터
-};
+// [UDP용 패킷]
+// 예전에는 struct UdpPacket { int seq; char data[1020]; }을 그대로 보냈음
+// (호스트 바이트 순서). [Lv.6] 이제 packets.h의 UdpBlast 스키마로 송신 버퍼에
+// 바로 쓰고 수신 버퍼를 바로 읽음: 헤더 8 + seq 4 + 더미 1012 = 1024 바이트
 
 void RunTcpServer(int port);
 void RunUdpServer(int port);
@@ -277,11 +277,12 @@ void RunUdpServer(int port) {
 
   struct sockaddr_in clientAddr;
   socklen_t clientAddrSize = sizeof(clientAddr);
-  UdpPacket packet;
+  uint8_t packet[2048]; // 큰 데이터그램이 와도 잘리는지 parse가 확인
 
   int lastSeq = -1;        // 직전에 받은 번호 (초기값 -1)
   int totalRecv = 0;       // 총 수신 개수
   long long lostCount = 0; // 유실된 패킷 수 추정치
+  long long badCount = 0;  // [Lv.6] 스키마 검사에 걸린 데이터그램
 
   // [Lv.4] 속도 측정을 위한 변수
   auto startTime = high_resolution_clock::now();
@@ -290,7 +291,7 @@ void RunUdpServer(int port) {
   while (true) {
     // recvfrom: UDP는 연결 과정이 없으므로, 받을 때마다 보낸 사람
     // 주소(clientAddr)를 채워줌
-    ssize_t recvLen = recvfrom(sock, &packet, sizeof(packet), 0,
+    ssize_t recvLen = recvfrom(sock, packet, sizeof(packet), 0,
                                (struct sockaddr *)&clientAddr, &clientAddrSize);
 
     if (recvLen == -1) {
@@ -322,8 +323,16 @@ void RunUdpServer(int port) {
       isFirstPacket = false;
     }
 
+    // [Lv.6] 길이/종류/버전 확인 (통과하면 필드는 버퍼에서 바로 읽음)
+    schema::View<UdpBlast> view;
+    if (!view.parse(packet, (size_t)recvLen)) {
+      badCount++;
+      continue;
+    }
+    int seq = view.get<UdpBlast::Seq>();
+
     // 종료 신호 확인 (Client가 seq -1을 보내면 종료)
-    if (packet.seq == -1) {
+    if (seq == -1) {
       cout << "[System] 전송 종료 신호 수신." << endl;
       break;
     }
@@ -332,24 +341,24 @@ void RunUdpServer(int port) {
     // [Debug] 서버 생존 확인용 로그 (1000개마다 출력)
     if (totalRecv % 1000 == 0) {
       cout << "[Server] Processing... Received: " << totalRecv
-           << " / Current Seq: " << packet.seq << "\r" << flush;
+           << " / Current Seq: " << seq << "\r" << flush;
     }
 
     // 유실 확인 로직
     // 정상적이라면 이번 seq는 lastSeq + 1이어야 함.
-    if (packet.seq != lastSeq + 1) {
+    if (seq != lastSeq + 1) {
       // 이번 seq가 예상보다 크다면? 그 사이 패킷들은 증발한 것.
-      if (packet.seq > lastSeq + 1) {
-        int gap = packet.seq - (lastSeq + 1);
+      if (seq > lastSeq + 1) {
+        int gap = seq - (lastSeq + 1);
         lostCount += gap;
         // 너무 많이 찍히면 보기 힘드니까 1000개 단위로만 로그 출력
         // cout << "[Loss] " << gap << "개 패킷 유실! (Last: " << lastSeq << ",
-        // Curr: " << packet.seq << ")" << endl;
+        // Curr: " << seq << ")" << endl;
       }
       // 이번 seq가 예상보다 작다면? 순서 뒤바뀜 (Out of Order)
-      else if (packet.seq <= lastSeq) {
+      else if (seq <= lastSeq) {
         // 이 예제에서는 단순화를 위해 별도 카운팅은 안 함
-        // cout << "[Order] 순서 뒤바뀜 발생! (Seq: " << packet.seq << ")" <<
+        // cout << "[Order] 순서 뒤바뀜 발생! (Seq: " << seq << ")" <<
         // endl;
       }
     }
@@ -357,8 +366,8 @@ void RunUdpServer(int port) {
     // 현재 seq를 마지막으로 갱신
     // (주의: 순서가 뒤바뀌어 옛날 패킷이 오면 lastSeq를 갱신하면 안 되지만,
     // 여기서는 단순 유실 체크만 수행)
-    if (packet.seq > lastSeq) {
-      lastSeq = packet.seq;
+    if (seq > lastSeq) {
+      lastSeq = seq;
     }
   }
 
@@ -367,12 +376,13 @@ void RunUdpServer(int port) {
   duration<double> diff = endTime - startTime;
   double seconds = diff.count();
   // UDP는 헤더 포함 실제 전송량을 추정하기 위해 packet size 사용
-  long long totalBytes = (long long)totalRecv * sizeof(UdpPacket);
+  long long totalBytes = (long long)totalRecv * UDP_BLAST_WIRE_SIZE;
 
   cout << "== 결과 리포트 ==" << endl;
   cout << "총 수신 패킷 수: " << totalRecv << endl;
   cout << "마지막 시퀀스 번호: " << lastSeq << endl;
   cout << "추정 유실 패킷 수: " << lostCount << endl;
+  cout << "잘못된 패킷 수: " << badCount << endl;
   cout << "총 수신 데이터: " << totalBytes << " bytes" << endl;
 
   if (seconds > 0) {
@@ -496,8 +506,10 @@ void RunUdpClient(const char *ip, int port) {
 
   // 2. 패킷 폭격 (Blast)
   const int PACKET_COUNT = 1000000; // 10만 개 전송
-  UdpPacket packet;
-  memset(packet.data, 'A', sizeof(packet.data)); // 더미 데이터 채움
+  // [Lv.6] 헤더는 한 번만 쓰고, 매번 seq 필드만 제자리에서 갱신
+  uint8_t buffer[UDP_BLAST_WIRE_SIZE];
+  schema::Builder<UdpBlast> packet(buffer, sizeof(buffer), UDP_BLAST_TAIL);
+  memset(packet.tail(), 'A', UDP_BLAST_TAIL); // 더미 데이터 채움
 
   cout << "[System] " << PACKET_COUNT << "개의 패킷 전송을 시작합니다..."
        << endl;
@@ -505,11 +517,11 @@ void RunUdpClient(const char *ip, int port) {
   auto startTime = high_resolution_clock::now();
 
   for (int i = 0; i < PACKET_COUNT; ++i) {
-    packet.seq = i;
+    packet.set<UdpBlast::Seq>(i);
 
     // sendto(소켓, 데이터, 길이, 플래그, 목적지주소, 주소길이)
     // UDP는 connect가 필수가 아니므로 매번 목적지 주소를 넣어줌
-    ssize_t sent = sendto(sock, &packet, sizeof(packet), 0,
+    ssize_t sent = sendto(sock, buffer, packet.size(), 0,
                           (struct sockaddr *)&serverAddr, sizeof(serverAddr));
 
     if (sent == -1) {
@@ -532,7 +544,7 @@ void RunUdpClient(const char *ip, int port) {
   cout << endl << "[System] 데이터 패킷 전송 완료." << endl;
 
   // 속도 계산 (UDP는 헤더 오버헤드 제외하고 Payload 기준 계산)
-  long long totalBytes = (long long)PACKET_COUNT * sizeof(packet);
+  long long totalBytes = (long long)PACKET_COUNT * packet.size();
   if (seconds > 0) {
     double mbps = (totalBytes * 8.0) / (seconds * 1000000.0);
     cout << fixed << setprecision(2);
@@ -542,9 +554,9 @@ void RunUdpClient(const char *ip, int port) {
 
   // 3. 종료 신호 전송 (seq = -1)
   // UDP는 유실될 수 있으므로, 종료 신호도 여러 번 보냄 (확인 사살)
-  packet.seq = -1;
+  packet.set<UdpBlast::Seq>(-1);
   for (int i = 0; i < 10; ++i) {
-    sendto(sock, &packet, sizeof(packet), 0, (struct sockaddr *)&serverAddr,
+    sendto(sock, buffer, packet.size(), 0, (struct sockaddr *)&serverAddr,
            sizeof(serverAddr));
   }
   cout << "[System] 종료 신호 전송 완료." << endl;
@@ -0,0 +1,310 @@
+/**
+ * [Lv.6] 고정 레이아웃 패킷 스키마 (헤더 전용, C++11)
+ *
+ * UdpPacket처럼 구조체를 그대로 sendto 하면 (1) 호스트 바이트 순서,
+ * (2) 컴파일러가 넣는 패딩, (3) 버전 구분 없음 -> 다른 CPU/컴파일러/버전과
+ * 섞이면 깨진다. 여기서는 메시지를 필드 목록으로 한 번만 선언하고, 오프셋은
+ * 컴파일 타임에 계산, 읽기/쓰기는 수신/송신 버퍼 위에서 바로 한다.
+ *
+ *   struct PlayerMove {
+ *     static const uint16_t TYPE = 2;
+ *     static const uint8_t VERSION = 2;       // 보내는 쪽 버전
+ *     static const uint8_t MIN_VERSION = 1;   // 이보다 오래된 건 거절
+ *     typedef schema::First<PlayerMove, uint32_t> EntityId;
+ *     typedef schema::Next<EntityId, float> X;
+ *     typedef schema::Next<X, float> Y;
+ *     typedef X REQUIRED_END;                 // ... v1에 있던 마지막 필드
+ *     typedef schema::Next<Y, uint16_t> Yaw;  // v2에서 추가 (끝에만 붙임)
+ *     typedef Yaw LAST;
+ *   };
+ *
+ *   // 송신: 송신 버퍼에 바로 씀 (구조체 -> memcpy 단계 없음)
+ *   schema::Builder<PlayerMove> b(sendBuf, sizeof(sendBuf));
+ *   b.set<PlayerMove::EntityId>(7);
+ *   sendto(sock, sendBuf, b.size(), ...);
+ *
+ *   // 수신: 받은 버퍼를 그대로 보는 뷰 (역직렬화 단계 없음)
+ *   schema::View<PlayerMove> v;
+ *   if (v.parse(recvBuf, recvLen)) { float x = v.get<PlayerMove::X>(); }
+ *
+ * 선(wire) 형식: [헤더 8B: type u16 | version u8 | flags u8 | bodyLen u32] + 본문
+ * - 모든 정수/실수는 리틀 엔디언, 필드 사이 패딩 없음 (오프셋 = 앞 필드의 끝)
+ * - 필드는 정렬되어 있지 않을 수 있어서 memcpy로 읽고 씀 (x86/ARM64에서는
+ *   mov 한 번으로 컴파일됨). 빅 엔디언 호스트에서만 바이트 교환
+ * - parse: 길이(헤더 + REQUIRED_END까지) / type / 버전을 한 번 확인. 그 뒤의
+ *   get은 검사 없이 읽음 (REQUIRED_END 이후 필드는 has()로 확인하거나
+ *   get(기본값))
+ * - 버전 규칙: 필드는 끝에만 추가. 새 버전이 보낸 긴 본문은 옛 버전이 뒤쪽을
+ *   무시, 옛 버전이 보낸 짧은 본문은 새 버전이 기본값으로 읽음
+ * - 가변 길이 꼬리(tail)는 선택 필드가 없는 메시지(LAST == REQUIRED_END)만.
+ *   선택 필드가 있는지는 본문 길이로 판단하는데, 꼬리가 붙으면 옛 버전이 보낸
+ *   짧은 본문 + 꼬리가 새 필드처럼 읽힘 (컴파일 에러로 막음)
+ * - 필드 타입은 메시지 태그를 가짐 -> 다른 메시지의 필드로 get/set 하면 컴파일 에러
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace schema {
+
+const size_t HEADER_SIZE = 8;
+
+// ==========================================
+// 리틀 엔디언 load/store (정렬 무관)
+// ==========================================
+template <typename T> inline T loadLE(const uint8_t *p) {
+  static_assert(std::is_arithmetic<T>::value, "scalar fields only");
+  T value;
+  memcpy(&value, p, sizeof(T));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  uint8_t *bytes = reinterpret_cast<uint8_t *>(&value);
+  for (size_t i = 0; i < sizeof(T) / 2; i++) {
+    uint8_t tmp = bytes[i];
+    bytes[i] = bytes[sizeof(T) - 1 - i];
+    bytes[sizeof(T) - 1 - i] = tmp;
+  }
+#endif
+  return value;
+}
+
+template <typename T> inline void storeLE(uint8_t *p, T value) {
+  static_assert(std::is_arithmetic<T>::value, "scalar fields only");
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  uint8_t *bytes = reinterpret_cast<uint8_t *>(&value);
+  for (size_t i = 0; i < sizeof(T) / 2; i++) {
+    uint8_t tmp = bytes[i];
+    bytes[i] = bytes[sizeof(T) - 1 - i];
+    bytes[sizeof(T) - 1 - i] = tmp;
+  }
+#endif
+  memcpy(p, &value, sizeof(T));
+}
+
+// ==========================================
+// 필드 선언 (오프셋은 앞 필드에서 계산)
+// ==========================================
+// 스칼라 필드 (정수, float, double)
+template <typename Msg, typename T, size_t Offset> struct Field {
+  typedef Msg message;
+  typedef T type;
+  static const size_t offset = Offset;
+  static const size_t size = sizeof(T);
+  static const size_t end = Offset + sizeof(T);
+  static const bool isBytes = false;
+};
+
+// 고정 길이 바이트 배열 (문자열, 해시 등). 복사 없이 포인터로 접근
+template <typename Msg, size_t N, size_t Offset> struct BytesField {
+  typedef Msg message;
+  static const size_t offset = Offset;
+  static const size_t size = N;
+  static const size_t end = Offset + N;
+  static const bool isBytes = true;
+};
+
+// 본문의 첫 필드
+template <typename Msg, typename T> struct First : Field<Msg, T, 0> {};
+template <typename Msg, size_t N> struct FirstBytes : BytesField<Msg, N, 0> {};
+
+// Prev 바로 뒤 필드 (패딩 없음)
+template <typename Prev, typename T>
+struct Next : Field<typename Prev::message, T, Prev::end> {};
+template <typename Prev, size_t N>
+struct NextBytes : BytesField<typename Prev::message, N, Prev::end> {};
+
+// 본문 크기 (Msg::LAST까지) / 필수 크기 (Msg::REQUIRED_END까지)
+template <typename Msg> struct Layout {
+  static const size_t bodySize = Msg::LAST::end;
+  static const size_t requiredSize = Msg::REQUIRED_END::end;
+  static const size_t wireSize = HEADER_SIZE + bodySize;
+  static_assert(requiredSize <= bodySize, "REQUIRED_END must not follow LAST");
+  // 꼬리를 붙일 수 있나 (선택 필드가 있으면 본문 길이로 구분이 안 됨)
+  static const bool allowsTail =
+      std::is_same<typename Msg::LAST, typename Msg::REQUIRED_END>::value;
+};
+
+// 헤더 필드 (메시지 종류와 무관)
+struct Header {
+  typedef First<Header, uint16_t> Type;
+  typedef Next<Type, uint8_t> Version;
+  typedef Next<Version, uint8_t> Flags;
+  typedef Next<Flags, uint32_t> BodyLen;
+  typedef BodyLen LAST;
+  static_assert(LAST::end == HEADER_SIZE, "header layout");
+};
+
+// 받은 데이터그램의 type만 먼저 볼 때 (디스패치용). 길이가 모자라면 false
+inline bool peekType(const void *buf, size_t len, uint16_t &type) {
+  if (len < HEADER_SIZE) {
+    return false;
+  }
+  type = loadLE<uint16_t>(static_cast<const uint8_t *>(buf) +
+                          Header::Type::offset);
+  return true;
+}
+
+enum ParseError {
+  PARSE_OK = 0,
+  PARSE_SHORT,       // 헤더 또는 필수 필드보다 짧음 / bodyLen이 버퍼를 넘음
+  PARSE_WRONG_TYPE,  // 다른 메시지
+  PARSE_OLD_VERSION, // MIN_VERSION보다 오래됨
+};
+
+// ==========================================
+// 읽기 뷰 (수신 버퍼를 가리킬 뿐, 버퍼가 살아 있는 동안만 유효)
+// ==========================================
+template <typename Msg> class View {
+public:
+  typedef Layout<Msg> layout;
+
+  View() : body_(nullptr), bodyLen_(0), version_(0), error_(PARSE_SHORT) {}
+
+  bool parse(const void *buf, size_t len) {
+    const uint8_t *p = static_cast<const uint8_t *>(buf);
+    body_ = nullptr;
+    bodyLen_ = 0;
+    if (len < HEADER_SIZE) {
+      error_ = PARSE_SHORT;
+      return false;
+    }
+    if (loadLE<uint16_t>(p + Header::Type::offset) != Msg::TYPE) {
+      error_ = PARSE_WRONG_TYPE;
+      return false;
+    }
+    version_ = loadLE<uint8_t>(p + Header::Version::offset);
+    if (version_ < Msg::MIN_VERSION) {
+      error_ = PARSE_OLD_VERSION;
+      return false;
+    }
+    uint32_t bodyLen = loadLE<uint32_t>(p + Header::BodyLen::offset);
+    if (bodyLen > len - HEADER_SIZE || bodyLen < layout::requiredSize) {
+      error_ = PARSE_SHORT;
+      return false;
+    }
+    body_ = p + HEADER_SIZE;
+    bodyLen_ = bodyLen;
+    error_ = PARSE_OK;
+    return true;
+  }
+
+  ParseError error() const { return error_; }
+  uint8_t version() const { return version_; }
+  uint32_t bodyLen() const { return bodyLen_; }
+
+  // 보낸 쪽 본문에 이 필드가 들어 있나 (REQUIRED_END까지는 항상 true)
+  template <typename F> bool has() const {
+    checkField<F>();
+    return F::end <= layout::requiredSize || F::end <= bodyLen_;
+  }
+
+  // 필수 필드 (parse가 길이를 확인했으므로 검사 없음)
+  template <typename F> typename F::type get() const {
+    checkField<F>();
+    static_assert(!F::isBytes, "use bytes<F>() for byte fields");
+    static_assert(F::end <= layout::requiredSize,
+                  "optional field: use get<F>(default)");
+    return loadLE<typename F::type>(body_ + F::offset);
+  }
+
+  // 새 버전에서 추가된 필드 (보낸 쪽이 옛 버전이면 기본값)
+  template <typename F>
+  typename F::type get(typename F::type fallback) const {
+    checkField<F>();
+    static_assert(!F::isBytes, "use bytes<F>() for byte fields");
+    return F::end <= bodyLen_ ? loadLE<typename F::type>(body_ + F::offset)
+                              : fallback;
+  }
+
+  // 바이트 필드 (복사 없이 버퍼 안을 가리킴, 없으면 nullptr)
+  template <typename F> const uint8_t *bytes() const {
+    checkField<F>();
+    static_assert(F::isBytes, "scalar field: use get<F>()");
+    return F::end <= bodyLen_ ? body_ + F::offset : nullptr;
+  }
+
+  // LAST 뒤의 가변 길이 꼬리 (채팅 본문 등)
+  const uint8_t *tail() const {
+    static_assert(layout::allowsTail, "tail needs LAST == REQUIRED_END");
+    return body_ + layout::bodySize;
+  }
+  size_t tailLen() const {
+    static_assert(layout::allowsTail, "tail needs LAST == REQUIRED_END");
+    return bodyLen_ > layout::bodySize ? bodyLen_ - layout::bodySize : 0;
+  }
+
+private:
+  template <typename F> static void checkField() {
+    static_assert(std::is_same<typename F::message, Msg>::value,
+                  "field belongs to another message");
+  }
+
+  const uint8_t *body_;
+  uint32_t bodyLen_;
+  uint8_t version_;
+  ParseError error_;
+};
+
+// ==========================================
+// 빌더 (송신 버퍼에 헤더를 쓰고, 필드를 제자리에 씀)
+// ==========================================
+template <typename Msg> class Builder {
+public:
+  typedef Layout<Msg> layout;
+
+  /**
+   * @param tailLen LAST 뒤에 붙일 가변 길이 꼬리 (tail()로 채움, 선택 필드가
+   *                있는 메시지는 0이어야 함)
+   * 버퍼가 모자라면 ok() == false, set은 아무것도 안 함
+   */
+  Builder(void *buf, size_t cap, size_t tailLen = 0)
+      : p_(static_cast<uint8_t *>(buf)),
+        size_(layout::wireSize + tailLen),
+        ok_(size_ <= cap && (tailLen == 0 || layout::allowsTail)) {
+    if (!ok_) {
+      size_ = 0;
+      return;
+    }
+    storeLE<uint16_t>(p_ + Header::Type::offset, Msg::TYPE);
+    storeLE<uint8_t>(p_ + Header::Version::offset, Msg::VERSION);
+    storeLE<uint8_t>(p_ + Header::Flags::offset, 0);
+    storeLE<uint32_t>(p_ + Header::BodyLen::offset,
+                      (uint32_t)(size_ - HEADER_SIZE));
+  }
+
+  bool ok() const { return ok_; }
+  size_t size() const { return size_; } // sendto에 넘길 길이
+
+  template <typename F> Builder &set(typename F::type value) {
+    static_assert(std::is_same<typename F::message, Msg>::value,
+                  "field belongs to another message");
+    static_assert(!F::isBytes, "use bytes<F>() for byte fields");
+    if (ok_) {
+      storeLE<typename F::type>(p_ + HEADER_SIZE + F::offset, value);
+    }
+    return *this;
+  }
+
+  // 바이트 필드에 직접 쓰기 (버퍼가 모자라면 nullptr)
+  template <typename F> uint8_t *bytes() {
+    static_assert(std::is_same<typename F::message, Msg>::value,
+                  "field belongs to another message");
+    static_assert(F::isBytes, "scalar field: use set<F>()");
+    return ok_ ? p_ + HEADER_SIZE + F::offset : nullptr;
+  }
+
+  uint8_t *tail() {
+    static_assert(layout::allowsTail, "tail needs LAST == REQUIRED_END");
+    return ok_ ? p_ + layout::wireSize : nullptr;
+  }
+
+private:
+  uint8_t *p_;
+  size_t size_;
+  bool ok_;
+};
+
+} // namespace schema
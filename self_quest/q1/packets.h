@@ -0,0 +1,80 @@
+/**
+ * [Lv.6] 메시지 선언 (packet_schema.h 사용)
+ *
+ * 필드를 추가할 때는 LAST 뒤에만 붙이고 VERSION을 올린다. 옛 버전이 꼭 보내야
+ * 하는 필드까지가 REQUIRED_END (이 범위는 바꾸지 않음).
+ */
+
+#pragma once
+
+#include "packet_schema.h"
+
+enum PacketType {
+  PACKET_UDP_BLAST = 1,
+  PACKET_PLAYER_MOVE = 2,
+  PACKET_SNAPSHOT = 3,
+  PACKET_SNAPSHOT_ACK = 4,
+};
+
+// Lv.3 UDP 폭격 패킷 (예전 struct UdpPacket { int seq; char data[1020]; })
+struct UdpBlast {
+  static const uint16_t TYPE = PACKET_UDP_BLAST;
+  static const uint8_t VERSION = 1;
+  static const uint8_t MIN_VERSION = 1;
+
+  typedef schema::First<UdpBlast, int32_t> Seq; // -1: 전송 종료
+  typedef Seq LAST;
+  typedef Seq REQUIRED_END;
+  // 뒤는 더미 데이터 (tail)
+};
+
+// 데이터그램 전체 크기는 예전과 같은 1024 바이트
+const size_t UDP_BLAST_WIRE_SIZE = 1024;
+const size_t UDP_BLAST_TAIL =
+    UDP_BLAST_WIRE_SIZE - schema::Layout<UdpBlast>::wireSize;
+
+// 게임 이동 패킷 예시 (schema_bench.cpp)
+struct PlayerMove {
+  static const uint16_t TYPE = PACKET_PLAYER_MOVE;
+  static const uint8_t VERSION = 2;
+  static const uint8_t MIN_VERSION = 1;
+
+  typedef schema::First<PlayerMove, uint32_t> EntityId;
+  typedef schema::Next<EntityId, uint32_t> Tick;
+  typedef schema::Next<Tick, float> X;
+  typedef schema::Next<X, float> Y;
+  typedef schema::Next<Y, float> Z;
+  typedef schema::Next<Z, uint16_t> Yaw; // 0~65535 = 0~360도
+  typedef schema::Next<Yaw, uint8_t> Flags;
+  typedef Flags REQUIRED_END; // v1은 여기까지
+  typedef schema::Next<Flags, uint16_t> Stamina; // v2
+  typedef Stamina LAST;
+};
+
+// [Lv.7] 델타 스냅샷 조각 (snapshot.h). 꼬리 = 엔티티 기록 비트열
+struct SnapshotMsg {
+  static const uint16_t TYPE = PACKET_SNAPSHOT;
+  static const uint8_t VERSION = 1;
+  static const uint8_t MIN_VERSION = 1;
+
+  typedef schema::First<SnapshotMsg, uint32_t> Tick;
+  typedef schema::Next<Tick, uint32_t> BaselineTick; // 0: 전체 스냅샷
+  typedef schema::Next<BaselineTick, uint8_t> FragIndex;
+  typedef schema::Next<FragIndex, uint8_t> FragCount;
+  typedef schema::Next<FragCount, uint16_t> FirstEntity;
+  typedef schema::Next<FirstEntity, uint16_t> Records;  // 이 조각의 엔티티 기록 수
+  typedef schema::Next<Records, uint16_t> BitCount;     // 꼬리의 유효 비트 수
+  typedef BitCount LAST;
+  typedef BitCount REQUIRED_END;
+};
+
+// 클라이언트 -> 서버: 마지막으로 완성한 스냅샷 틱
+struct SnapshotAck {
+  static const uint16_t TYPE = PACKET_SNAPSHOT_ACK;
+  static const uint8_t VERSION = 1;
+  static const uint8_t MIN_VERSION = 1;
+
+  typedef schema::First<SnapshotAck, uint32_t> Tick;
+  typedef Tick LAST;
+  typedef Tick REQUIRED_END;
+};
@@ -0,0 +1,281 @@
+/**
+ * [Lv.6] 패킷 스키마 vs 구조체 memcpy 인코딩/디코딩 비용
+ *
+ *   struct : 구조체를 버퍼에 memcpy (호스트 순서 + 패딩, 지금까지의 UdpPacket 방식)
+ *            디코딩도 버퍼 -> 지역 구조체 memcpy 후 필드 읽기
+ *   schema : schema::Builder로 송신 버퍼에 필드를 바로 씀 (헤더 포함)
+ *            디코딩은 View::parse (길이/type/버전 확인) + get
+ *
+ * 연산:
+ *   encode : 메시지 하나를 버퍼에 씀
+ *   decode : 모든 필드를 읽음
+ *   peek   : 필드 2개만 읽음 (라우팅/필터링처럼 일부만 보는 경우)
+ *
+ * 메시지 4096개짜리 원본/버퍼 배열을 돌면서 재고 (상수 접기 방지), 5회 중 최솟값.
+ * verified: 인코딩 -> 디코딩 왕복 일치 + v1(짧은) 메시지를 v2 뷰가 기본값으로
+ *           읽음 + 잘린/다른 type/옛 버전 데이터그램 거절
+ *
+ * 컴파일: g++ -o schema_bench schema_bench.cpp -std=c++11 -O2
+ * 실행: ./schema_bench [iterations]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "packets.h" // [Lv.6]
+
+using namespace std;
+using namespace std::chrono;
+
+const int MESSAGES = 4096;
+const int ROUNDS = 5;
+const size_t SLOT = 64; // 버퍼 한 칸 (메시지 최대 크기보다 큼)
+
+// 지금까지의 방식: 구조체 그대로 (sizeof에 패딩 포함)
+struct MoveStruct {
+  uint32_t entityId;
+  uint32_t tick;
+  float x, y, z;
+  uint16_t yaw;
+  uint8_t flags;
+  uint16_t stamina;
+};
+
+typedef schema::Layout<PlayerMove> MoveLayout;
+
+// 최적화로 사라지지 않게 결과를 흘려 보냄
+volatile uint64_t g_sink;
+
+inline uint64_t mix(uint64_t acc, uint64_t v) { return acc * 31 + v; }
+
+inline uint32_t float_bits(float f) {
+  uint32_t u;
+  memcpy(&u, &f, sizeof(u));
+  return u;
+}
+
+void encode_struct(const MoveStruct &m, uint8_t *buf) {
+  memcpy(buf, &m, sizeof(m));
+}
+
+size_t encode_schema(const MoveStruct &m, uint8_t *buf) {
+  schema::Builder<PlayerMove> b(buf, SLOT);
+  b.set<PlayerMove::EntityId>(m.entityId)
+      .set<PlayerMove::Tick>(m.tick)
+      .set<PlayerMove::X>(m.x)
+      .set<PlayerMove::Y>(m.y)
+      .set<PlayerMove::Z>(m.z)
+      .set<PlayerMove::Yaw>(m.yaw)
+      .set<PlayerMove::Flags>(m.flags)
+      .set<PlayerMove::Stamina>(m.stamina);
+  return b.size();
+}
+
+uint64_t decode_struct(const uint8_t *buf) {
+  MoveStruct m;
+  memcpy(&m, buf, sizeof(m));
+  uint64_t acc = m.entityId;
+  acc = mix(acc, m.tick);
+  acc = mix(acc, float_bits(m.x));
+  acc = mix(acc, float_bits(m.y));
+  acc = mix(acc, float_bits(m.z));
+  acc = mix(acc, m.yaw);
+  acc = mix(acc, m.flags);
+  acc = mix(acc, m.stamina);
+  return acc;
+}
+
+uint64_t decode_schema(const uint8_t *buf, size_t len) {
+  schema::View<PlayerMove> v;
+  if (!v.parse(buf, len)) {
+    return 0;
+  }
+  uint64_t acc = v.get<PlayerMove::EntityId>();
+  acc = mix(acc, v.get<PlayerMove::Tick>());
+  acc = mix(acc, float_bits(v.get<PlayerMove::X>()));
+  acc = mix(acc, float_bits(v.get<PlayerMove::Y>()));
+  acc = mix(acc, float_bits(v.get<PlayerMove::Z>()));
+  acc = mix(acc, v.get<PlayerMove::Yaw>());
+  acc = mix(acc, v.get<PlayerMove::Flags>());
+  acc = mix(acc, v.get<PlayerMove::Stamina>(100));
+  return acc;
+}
+
+uint64_t peek_struct(const uint8_t *buf) {
+  MoveStruct m;
+  memcpy(&m, buf, sizeof(m));
+  return mix(m.entityId, float_bits(m.x));
+}
+
+uint64_t peek_schema(const uint8_t *buf, size_t len) {
+  schema::View<PlayerMove> v;
+  if (!v.parse(buf, len)) {
+    return 0;
+  }
+  return mix(v.get<PlayerMove::EntityId>(), float_bits(v.get<PlayerMove::X>()));
+}
+
+// ==========================================
+// 측정
+// ==========================================
+template <class Fn> double best_ns_per_msg(long long iterations, Fn fn) {
+  double best = 1e18;
+  for (int r = 0; r < ROUNDS; r++) {
+    auto start = steady_clock::now();
+    uint64_t acc = 0;
+    for (long long i = 0; i < iterations; i++) {
+      acc += fn((int)(i & (MESSAGES - 1)));
+    }
+    duration<double, nano> elapsed = steady_clock::now() - start;
+    g_sink = acc;
+    best = min(best, elapsed.count() / iterations);
+  }
+  return best;
+}
+
+void print_row(const char *codec, const char *op, size_t bytes, double ns) {
+  cout << codec << "," << op << "," << bytes << "," << ns << endl;
+}
+
+// ==========================================
+// 검증
+// ==========================================
+bool verify(const vector<MoveStruct> &src) {
+  uint8_t buf[SLOT];
+  for (size_t i = 0; i < src.size(); i++) {
+    size_t len = encode_schema(src[i], buf);
+    schema::View<PlayerMove> v;
+    if (!v.parse(buf, len) || v.get<PlayerMove::EntityId>() != src[i].entityId ||
+        v.get<PlayerMove::Tick>() != src[i].tick ||
+        v.get<PlayerMove::X>() != src[i].x ||
+        v.get<PlayerMove::Y>() != src[i].y ||
+        v.get<PlayerMove::Z>() != src[i].z ||
+        v.get<PlayerMove::Yaw>() != src[i].yaw ||
+        v.get<PlayerMove::Flags>() != src[i].flags ||
+        v.get<PlayerMove::Stamina>(0) != src[i].stamina) {
+      return false;
+    }
+  }
+
+  // 선 형식 고정: 헤더 type=2, version=2, bodyLen=25, EntityId 리틀 엔디언
+  MoveStruct m = src[0];
+  m.entityId = 0x04030201;
+  size_t len = encode_schema(m, buf);
+  const uint8_t expected[] = {2, 0, 2, 0, 25, 0, 0, 0, 1, 2, 3, 4};
+  if (len != schema::HEADER_SIZE + 25 ||
+      memcmp(buf, expected, sizeof(expected)) != 0) {
+    return false;
+  }
+
+  // v1이 보낸 짧은 본문 (Stamina 없음) -> 기본값
+  buf[schema::Header::Version::offset] = 1;
+  uint32_t v1Len = (uint32_t)MoveLayout::requiredSize;
+  schema::storeLE<uint32_t>(buf + schema::Header::BodyLen::offset, v1Len);
+  schema::View<PlayerMove> v;
+  if (!v.parse(buf, schema::HEADER_SIZE + v1Len) ||
+      v.has<PlayerMove::Stamina>() || v.get<PlayerMove::Stamina>(100) != 100) {
+    return false;
+  }
+
+  // 거절: 필수 필드보다 짧음, bodyLen이 데이터그램보다 김, 다른 type, 옛 버전
+  if (v.parse(buf, schema::HEADER_SIZE + v1Len - 1) ||
+      v.error() != schema::PARSE_SHORT) {
+    return false;
+  }
+  schema::storeLE<uint32_t>(buf + schema::Header::BodyLen::offset, 1000);
+  if (v.parse(buf, len) || v.error() != schema::PARSE_SHORT) {
+    return false;
+  }
+  schema::storeLE<uint32_t>(buf + schema::Header::BodyLen::offset, 25);
+  buf[schema::Header::Version::offset] = 0;
+  if (v.parse(buf, len) || v.error() != schema::PARSE_OLD_VERSION) {
+    return false;
+  }
+  buf[schema::Header::Version::offset] = 2;
+  schema::View<UdpBlast> other;
+  if (other.parse(buf, len) || other.error() != schema::PARSE_WRONG_TYPE) {
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char *argv[]) {
+  long long iterations = 20000000;
+  if (argc >= 2) {
+    iterations = atoll(argv[1]);
+  }
+
+  vector<MoveStruct> src(MESSAGES);
+  uint32_t rng = 2463534242u;
+  for (int i = 0; i < MESSAGES; i++) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    MoveStruct &m = src[i];
+    memset(&m, 0, sizeof(m)); // 패딩까지 0 (struct 방식 비교를 공평하게)
+    m.entityId = rng % 100000;
+    m.tick = (uint32_t)i;
+    m.x = (float)(rng % 10000) * 0.1f;
+    m.y = (float)((rng >> 8) % 10000) * 0.1f;
+    m.z = (float)((rng >> 16) % 100) * 0.1f;
+    m.yaw = (uint16_t)rng;
+    m.flags = (uint8_t)(rng >> 24);
+    m.stamina = (uint16_t)(rng % 1000);
+  }
+
+  // 버퍼는 칸 단위로 (struct는 칸 시작이 정렬됨, schema 필드는 정렬 안 됨)
+  vector<uint8_t> struct_bufs(MESSAGES * SLOT), schema_bufs(MESSAGES * SLOT);
+  vector<size_t> schema_lens(MESSAGES);
+  for (int i = 0; i < MESSAGES; i++) {
+    encode_struct(src[i], &struct_bufs[i * SLOT]);
+    schema_lens[i] = encode_schema(src[i], &schema_bufs[i * SLOT]);
+  }
+
+  cerr << "[*] iterations=" << iterations << " messages=" << MESSAGES
+       << " struct=" << sizeof(MoveStruct) << "B (fields "
+       << MoveLayout::bodySize << "B + padding)"
+       << " schema=" << MoveLayout::wireSize << "B (header "
+       << schema::HEADER_SIZE << "B + body " << MoveLayout::bodySize << "B)"
+       << endl;
+  cout << "codec,op,bytes,ns_per_msg" << endl;
+
+  uint8_t *sb = struct_bufs.data();
+  uint8_t *cb = schema_bufs.data();
+  const size_t *lens = schema_lens.data();
+  const MoveStruct *s = src.data();
+
+  print_row("struct", "encode", sizeof(MoveStruct),
+            best_ns_per_msg(iterations, [&](int i) -> uint64_t {
+              encode_struct(s[i], sb + i * SLOT);
+              return sb[i * SLOT];
+            }));
+  print_row("schema", "encode", MoveLayout::wireSize,
+            best_ns_per_msg(iterations, [&](int i) -> uint64_t {
+              return encode_schema(s[i], cb + i * SLOT);
+            }));
+  print_row("struct", "decode", sizeof(MoveStruct),
+            best_ns_per_msg(iterations, [&](int i) -> uint64_t {
+              return decode_struct(sb + i * SLOT);
+            }));
+  print_row("schema", "decode", MoveLayout::wireSize,
+            best_ns_per_msg(iterations, [&](int i) -> uint64_t {
+              return decode_schema(cb + i * SLOT, lens[i]);
+            }));
+  print_row("struct", "peek", sizeof(MoveStruct),
+            best_ns_per_msg(iterations, [&](int i) -> uint64_t {
+              return peek_struct(sb + i * SLOT);
+            }));
+  print_row("schema", "peek", MoveLayout::wireSize,
+            best_ns_per_msg(iterations, [&](int i) -> uint64_t {
+              return peek_schema(cb + i * SLOT, lens[i]);
+            }));
+
+  bool ok = verify(src);
+  cerr << "[*] verified=" << (ok ? "yes" : "no") << endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,662 @@
+/**
+ * [Lv.7] 델타 압축 월드 스냅샷 (헤더 전용, C++11)
+ *
+ * 매 틱 엔티티 상태(float 4개 + 2B)를 그대로 보내면 1000개 x 18B = 18KB를
+ * 틱마다 클라이언트마다 보내야 한다. 대부분은 지난 틱과 같으므로, 클라이언트가
+ * 마지막으로 ack한 스냅샷(baseline)과의 차이만 비트 단위로 보낸다.
+ *
+ *   snap::SnapshotServer server(ENTITIES, CLIENTS);
+ *   server.beginTick(tick, world);                     // 틱마다 한 번 (양자화 + 기록)
+ *   const snap::EncodedSnapshot &s = server.snapshotFor(client);
+ *   for (size_t f = 0; f < s.fragmentCount(); f++)
+ *     sendto(sock, s.fragment(f), s.fragmentLen(f), ...);
+ *   server.onAck(client, buf, len);                    // 클라이언트의 ack 데이터그램
+ *
+ *   snap::SnapshotClient client(ENTITIES);
+ *   if (client.onDatagram(buf, len)) {                 // 스냅샷 하나 완성
+ *     size_t n = client.buildAck(ackBuf, sizeof(ackBuf));
+ *     sendto(sock, ackBuf, n, ...);
+ *   }
+ *
+ * - 양자화: 위치 1/64m (x, y: ±2048m -> 18비트, z: 0~256m -> 14비트),
+ *   방향 10비트 (0.35도), 체력 7비트, 애니메이션 4비트
+ * - 엔티티 기록: [앞 기록과의 번호 간격 (exp-Golomb)] [바뀐 필드 4비트]
+ *   + 바뀐 필드만. 위치 축은 차이가 작으면(|d| < 64) 7비트, 아니면 전체 값
+ *   안 바뀐 엔티티는 한 비트도 안 씀
+ * - baseline: 서버는 최근 BASELINE_RING 틱의 양자화 상태를 전체에 하나만 보관
+ *   (클라이언트마다 복사하지 않음). 클라이언트별로는 보낸 틱 기록 + 마지막 ack
+ * - 유실: 클라이언트는 모든 조각을 받아야 ack. ack가 없는 동안 서버는 계속 옛
+ *   baseline 기준으로 보냄 (그 사이 잃어버린 델타는 필요 없음). baseline이
+ *   링에서 밀려나면 (BASELINE_RING 틱 동안 ack 없음) 전체 스냅샷으로
+ * - 조각: 데이터그램 하나 <= MAX_DATAGRAM. 조각마다 엔티티 구간이 달라서
+ *   받은 순서와 무관하게 적용
+ * - 같은 틱에 같은 baseline을 쓰는 클라이언트는 인코딩 결과가 같음 -> 틱마다
+ *   baseline별로 한 번만 인코딩하고 공유
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <vector>
+
+#include "packets.h" // SnapshotMsg, SnapshotAck
+
+namespace snap {
+
+const int BASELINE_RING = 32;
+const size_t MAX_DATAGRAM = 1200; // 일반적인 MTU 안쪽
+const int MAX_FRAGMENTS = 64;
+
+// 양자화
+const float POS_SCALE = 64.0f; // 1/64m
+const float WORLD_HALF = 2048.0f;
+const float Z_MAX = 256.0f;
+const int POS_BITS = 18; // (2 * 2048) * 64 = 2^18
+const int Z_BITS = 14;   // 256 * 64 = 2^14
+const int YAW_BITS = 10;
+const int HEALTH_BITS = 7;
+const int ANIM_BITS = 4;
+const int SMALL_DELTA_BITS = 7; // zigzag로 |d| < 64
+
+// 바뀐 필드 마스크
+const uint32_t CHANGED_POS = 1, CHANGED_YAW = 2, CHANGED_HEALTH = 4,
+               CHANGED_ANIM = 8;
+const int CHANGED_BITS = 4;
+
+// 엔티티 기록 하나의 최대 비트 수 (간격 23 + 마스크 + 축 3개 + 나머지)
+const size_t MAX_RECORD_BITS = 23 + CHANGED_BITS + 2 * (1 + POS_BITS) +
+                               (1 + Z_BITS) + YAW_BITS + HEALTH_BITS + ANIM_BITS;
+
+// 서버 시뮬레이션 쪽 상태
+struct EntityState {
+  float x, y, z;
+  float yaw; // 라디안 [0, 2pi)
+  uint8_t health;
+  uint8_t anim;
+};
+
+// 선으로 보내는 값 (양자화된 정수)
+struct QState {
+  uint32_t x, y, z;
+  uint16_t yaw;
+  uint8_t health;
+  uint8_t anim;
+
+  bool operator==(const QState &o) const {
+    return x == o.x && y == o.y && z == o.z && yaw == o.yaw &&
+           health == o.health && anim == o.anim;
+  }
+  bool operator!=(const QState &o) const { return !(*this == o); }
+};
+
+inline uint32_t quantizeRange(float v, float lo, float hi, int bits) {
+  float clamped = v < lo ? lo : (v > hi ? hi : v);
+  uint32_t q = (uint32_t)lrintf((clamped - lo) * POS_SCALE);
+  uint32_t maxQ = (1u << bits) - 1;
+  return q > maxQ ? maxQ : q;
+}
+
+inline QState quantize(const EntityState &e) {
+  QState q;
+  q.x = quantizeRange(e.x, -WORLD_HALF, WORLD_HALF, POS_BITS);
+  q.y = quantizeRange(e.y, -WORLD_HALF, WORLD_HALF, POS_BITS);
+  q.z = quantizeRange(e.z, 0.0f, Z_MAX, Z_BITS);
+  const float TWO_PI = 6.28318530718f;
+  float turns = e.yaw / TWO_PI;
+  turns -= floorf(turns);
+  q.yaw = (uint16_t)((uint32_t)lrintf(turns * (1 << YAW_BITS)) &
+                     ((1u << YAW_BITS) - 1));
+  q.health = (uint8_t)(e.health > 127 ? 127 : e.health);
+  q.anim = (uint8_t)(e.anim & ((1u << ANIM_BITS) - 1));
+  return q;
+}
+
+inline EntityState dequantize(const QState &q) {
+  EntityState e;
+  e.x = q.x / POS_SCALE - WORLD_HALF;
+  e.y = q.y / POS_SCALE - WORLD_HALF;
+  e.z = q.z / POS_SCALE;
+  e.yaw = q.yaw * (6.28318530718f / (1 << YAW_BITS));
+  e.health = q.health;
+  e.anim = q.anim;
+  return e;
+}
+
+// ==========================================
+// 비트 스트림 (LSB부터 채움)
+// ==========================================
+class BitWriter {
+public:
+  BitWriter(uint8_t *buf, size_t capBytes)
+      : buf_(buf), cap_(capBytes), acc_(0), accBits_(0), bytes_(0),
+        overflow_(false) {}
+
+  void write(uint32_t value, int bits) {
+    acc_ |= (uint64_t)(value & ((bits == 32) ? 0xffffffffu : ((1u << bits) - 1)))
+            << accBits_;
+    accBits_ += bits;
+    while (accBits_ >= 8) {
+      putByte((uint8_t)acc_);
+      acc_ >>= 8;
+      accBits_ -= 8;
+    }
+  }
+
+  // exp-Golomb (value >= 1): 작은 값일수록 짧음 (1 -> 1비트, 2~3 -> 3비트)
+  void writeGamma(uint32_t value) {
+    int len = 31 - __builtin_clz(value);
+    write(0, len);
+    write(1, 1);
+    write(value, len); // 맨 위 1비트는 위에서 씀
+  }
+
+  size_t bitCount() const { return bytes_ * 8 + accBits_; }
+
+  // 남은 비트를 바이트로 내보냄. @return 쓴 바이트 수
+  size_t finish() {
+    if (accBits_ > 0) {
+      putByte((uint8_t)acc_);
+      acc_ = 0;
+      accBits_ = 0;
+    }
+    return bytes_;
+  }
+
+  bool overflow() const { return overflow_; }
+
+private:
+  void putByte(uint8_t b) {
+    if (bytes_ < cap_) {
+      buf_[bytes_++] = b;
+    } else {
+      overflow_ = true;
+    }
+  }
+
+  uint8_t *buf_;
+  size_t cap_;
+  uint64_t acc_;
+  int accBits_;
+  size_t bytes_;
+  bool overflow_;
+};
+
+class BitReader {
+public:
+  BitReader(const uint8_t *buf, size_t bits)
+      : buf_(buf), bits_(bits), pos_(0) {}
+
+  // 남은 비트가 모자라면 false (잘린/조작된 데이터그램)
+  bool read(int bits, uint32_t &out) {
+    if (pos_ + bits > bits_) {
+      return false;
+    }
+    uint32_t value = 0;
+    for (int got = 0; got < bits;) {
+      size_t byte = (pos_ + got) >> 3;
+      int shift = (int)((pos_ + got) & 7);
+      int take = 8 - shift < bits - got ? 8 - shift : bits - got;
+      value |= (uint32_t)((buf_[byte] >> shift) & ((1u << take) - 1)) << got;
+      got += take;
+    }
+    pos_ += bits;
+    out = value;
+    return true;
+  }
+
+  bool readGamma(uint32_t &out) {
+    int len = 0;
+    uint32_t bit = 0;
+    while (true) {
+      if (!read(1, bit)) {
+        return false;
+      }
+      if (bit) {
+        break;
+      }
+      if (++len > 31) {
+        return false;
+      }
+    }
+    uint32_t low = 0;
+    if (len > 0 && !read(len, low)) {
+      return false;
+    }
+    out = (1u << len) | low;
+    return true;
+  }
+
+private:
+  const uint8_t *buf_;
+  size_t bits_;
+  size_t pos_;
+};
+
+inline uint32_t zigzag(int32_t v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+inline int32_t unzigzag(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+
+// 위치 한 축 (위치가 바뀌면 세 축 모두 씀, 안 바뀐 축은 작은 차이 0 = 8비트)
+inline void writeAxis(BitWriter &w, uint32_t cur, uint32_t base, int bits) {
+  int32_t d = (int32_t)cur - (int32_t)base;
+  if (d > -(1 << (SMALL_DELTA_BITS - 1)) && d < (1 << (SMALL_DELTA_BITS - 1))) {
+    w.write(0, 1);
+    w.write(zigzag(d), SMALL_DELTA_BITS);
+  } else {
+    w.write(1, 1);
+    w.write(cur, bits);
+  }
+}
+
+inline bool readAxis(BitReader &r, uint32_t base, int bits, uint32_t &out) {
+  uint32_t full = 0, v = 0;
+  if (!r.read(1, full)) {
+    return false;
+  }
+  if (full) {
+    return r.read(bits, out);
+  }
+  if (!r.read(SMALL_DELTA_BITS, v)) {
+    return false;
+  }
+  out = (uint32_t)((int32_t)base + unzigzag(v)) & ((1u << bits) - 1);
+  return true;
+}
+
+// ==========================================
+// 인코딩 결과 (조각 = 데이터그램 하나)
+// ==========================================
+struct EncodedSnapshot {
+  uint32_t tick = 0;
+  uint32_t baselineTick = 0; // 0: 전체 스냅샷
+  std::vector<uint8_t> bytes;     // 최대 크기로 잡아 두고 재사용 (앞쪽만 유효)
+  std::vector<uint32_t> offsets; // 조각 시작 (마지막 원소 = 유효 바이트 수)
+
+  size_t fragmentCount() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+  const uint8_t *fragment(size_t i) const { return &bytes[offsets[i]]; }
+  size_t fragmentLen(size_t i) const { return offsets[i + 1] - offsets[i]; }
+  size_t totalBytes() const { return offsets.empty() ? 0 : offsets.back(); }
+};
+
+typedef schema::Layout<SnapshotMsg> SnapshotLayout;
+const size_t FRAGMENT_PAYLOAD = MAX_DATAGRAM - SnapshotLayout::wireSize;
+
+/**
+ * cur를 base 기준으로 인코딩 (base == nullptr 이면 전체 = 0 상태 기준)
+ * 조각이 MAX_FRAGMENTS를 넘으면 false (엔티티 수가 너무 많음)
+ */
+inline bool encodeSnapshot(uint32_t tick, const std::vector<QState> &cur,
+                           const QState *base, uint32_t baselineTick,
+                           EncodedSnapshot &out) {
+  static const QState ZERO = QState();
+  out.tick = tick;
+  out.baselineTick = base != nullptr ? baselineTick : 0;
+  if (out.bytes.size() < MAX_FRAGMENTS * MAX_DATAGRAM) {
+    out.bytes.resize(MAX_FRAGMENTS * MAX_DATAGRAM); // 처음 한 번만 0으로 채움
+  }
+  out.offsets.clear();
+
+  size_t n = cur.size();
+  size_t i = 0;
+  size_t offset = 0;
+  do {
+    if (out.offsets.size() >= (size_t)MAX_FRAGMENTS) {
+      return false;
+    }
+    out.offsets.push_back((uint32_t)offset);
+    uint8_t *dgram = &out.bytes[offset];
+    schema::Builder<SnapshotMsg> b(dgram, MAX_DATAGRAM);
+    BitWriter w(b.tail(), FRAGMENT_PAYLOAD);
+
+    uint32_t first = (uint32_t)i;
+    uint32_t prev = first; // 간격 = 번호 - prev + 1 (>= 1)
+    uint32_t records = 0;
+    for (; i < n; i++) {
+      const QState &c = cur[i];
+      const QState &p = base != nullptr ? base[i] : ZERO;
+      if (c == p) {
+        continue;
+      }
+      if (w.bitCount() + MAX_RECORD_BITS > FRAGMENT_PAYLOAD * 8) {
+        break; // 다음 조각에서 이 엔티티부터
+      }
+      uint32_t mask = 0;
+      if (c.x != p.x || c.y != p.y || c.z != p.z) {
+        mask |= CHANGED_POS;
+      }
+      if (c.yaw != p.yaw) {
+        mask |= CHANGED_YAW;
+      }
+      if (c.health != p.health) {
+        mask |= CHANGED_HEALTH;
+      }
+      if (c.anim != p.anim) {
+        mask |= CHANGED_ANIM;
+      }
+      w.writeGamma((uint32_t)i - prev + 1);
+      prev = (uint32_t)i + 1;
+      w.write(mask, CHANGED_BITS);
+      if (mask & CHANGED_POS) {
+        // 축별 변경 비트 대신 "작은 차이 0"으로 (움직이면 보통 x, y 둘 다 바뀜)
+        writeAxis(w, c.x, p.x, POS_BITS);
+        writeAxis(w, c.y, p.y, POS_BITS);
+        writeAxis(w, c.z, p.z, Z_BITS);
+      }
+      if (mask & CHANGED_YAW) {
+        w.write(c.yaw, YAW_BITS);
+      }
+      if (mask & CHANGED_HEALTH) {
+        w.write(c.health, HEALTH_BITS);
+      }
+      if (mask & CHANGED_ANIM) {
+        w.write(c.anim, ANIM_BITS);
+      }
+      records++;
+    }
+    size_t bits = w.bitCount();
+    size_t payload = w.finish();
+
+    b.set<SnapshotMsg::Tick>(tick)
+        .set<SnapshotMsg::BaselineTick>(out.baselineTick)
+        .set<SnapshotMsg::FragIndex>((uint8_t)(out.offsets.size() - 1))
+        .set<SnapshotMsg::FirstEntity>((uint16_t)first)
+        .set<SnapshotMsg::Records>((uint16_t)records)
+        .set<SnapshotMsg::BitCount>((uint16_t)bits);
+    // bodyLen은 실제 꼬리 길이로 (빌더는 꼬리 0으로 헤더를 씀)
+    schema::storeLE<uint32_t>(dgram + schema::Header::BodyLen::offset,
+                              (uint32_t)(SnapshotLayout::bodySize + payload));
+    offset += SnapshotLayout::wireSize + payload;
+  } while (i < n);
+
+  out.offsets.push_back((uint32_t)offset);
+  // 조각 수는 다 만든 뒤에야 알 수 있음
+  for (size_t f = 0; f + 1 < out.offsets.size(); f++) {
+    schema::storeLE<uint8_t>(&out.bytes[out.offsets[f]] + schema::HEADER_SIZE +
+                                 SnapshotMsg::FragCount::offset,
+                             (uint8_t)(out.offsets.size() - 1));
+  }
+  return true;
+}
+
+/**
+ * 조각 하나를 state에 적용 (state는 baseline으로 시작한 것)
+ * @return false: 비트가 모자람 / 엔티티 번호 범위 밖
+ */
+inline bool applyFragment(const schema::View<SnapshotMsg> &v,
+                          std::vector<QState> &state) {
+  if (v.get<SnapshotMsg::BitCount>() > v.tailLen() * 8) {
+    return false;
+  }
+  BitReader r(v.tail(), v.get<SnapshotMsg::BitCount>());
+  uint32_t prev = v.get<SnapshotMsg::FirstEntity>();
+  uint32_t records = v.get<SnapshotMsg::Records>();
+  for (uint32_t k = 0; k < records; k++) {
+    uint32_t gap = 0, mask = 0;
+    if (!r.readGamma(gap) || !r.read(CHANGED_BITS, mask)) {
+      return false;
+    }
+    uint32_t index = prev + gap - 1;
+    if (index >= state.size()) {
+      return false;
+    }
+    prev = index + 1;
+    QState &q = state[index];
+    uint32_t value = 0;
+    if (mask & CHANGED_POS) {
+      if (!readAxis(r, q.x, POS_BITS, q.x) || !readAxis(r, q.y, POS_BITS, q.y) ||
+          !readAxis(r, q.z, Z_BITS, q.z)) {
+        return false;
+      }
+    }
+    if (mask & CHANGED_YAW) {
+      if (!r.read(YAW_BITS, value)) {
+        return false;
+      }
+      q.yaw = (uint16_t)value;
+    }
+    if (mask & CHANGED_HEALTH) {
+      if (!r.read(HEALTH_BITS, value)) {
+        return false;
+      }
+      q.health = (uint8_t)value;
+    }
+    if (mask & CHANGED_ANIM) {
+      if (!r.read(ANIM_BITS, value)) {
+        return false;
+      }
+      q.anim = (uint8_t)value;
+    }
+  }
+  return true;
+}
+
+// ==========================================
+// 서버
+// ==========================================
+class SnapshotServer {
+public:
+  struct Stats {
+    uint64_t fullSnapshots = 0;
+    uint64_t deltaSnapshots = 0;
+    uint64_t encodes = 0;   // 실제 인코딩 횟수 (나머지는 같은 틱 공유)
+    uint64_t bytesSent = 0; // 헤더 포함 (UDP/IP 헤더 제외)
+    uint64_t datagrams = 0;
+    uint64_t staleAcks = 0; // 보낸 적 없는 틱 / 이미 받은 것보다 옛날
+  };
+
+  SnapshotServer(int entities, int clients)
+      : entities_(entities), clients_(clients), tick_(0), shareEncodes_(true) {
+    for (int i = 0; i < BASELINE_RING; i++) {
+      history_[i].tick = 0;
+      history_[i].states.resize(entities);
+    }
+  }
+
+  // 틱 번호는 1부터 증가 (0은 "baseline 없음")
+  void beginTick(uint32_t tick, const std::vector<EntityState> &world) {
+    tick_ = tick;
+    History &h = history_[tick % BASELINE_RING];
+    h.tick = tick;
+    for (int i = 0; i < entities_; i++) {
+      h.states[i] = quantize(world[i]);
+    }
+    cache_.clear();
+  }
+
+  const EncodedSnapshot &snapshotFor(int client) {
+    Client &c = clients_[client];
+    uint32_t baseline = 0;
+    const History *base = nullptr;
+    if (c.acked != 0 && tick_ - c.acked < (uint32_t)BASELINE_RING) {
+      base = &history_[c.acked % BASELINE_RING];
+      baseline = c.acked;
+    }
+    EncodedSnapshot *encoded = &scratch_;
+    bool fresh = true;
+    if (shareEncodes_) {
+      std::map<uint32_t, EncodedSnapshot>::iterator it = cache_.find(baseline);
+      fresh = it == cache_.end();
+      if (fresh) {
+        it = cache_.insert(std::make_pair(baseline, EncodedSnapshot())).first;
+      }
+      encoded = &it->second;
+    }
+    if (fresh) {
+      encodeSnapshot(tick_, history_[tick_ % BASELINE_RING].states,
+                     base != nullptr ? base->states.data() : nullptr, baseline,
+                     *encoded);
+      stats_.encodes++;
+    }
+    const EncodedSnapshot &s = *encoded;
+    c.sent[tick_ % BASELINE_RING] = tick_;
+    if (baseline == 0) {
+      stats_.fullSnapshots++;
+    } else {
+      stats_.deltaSnapshots++;
+    }
+    stats_.bytesSent += s.totalBytes();
+    stats_.datagrams += s.fragmentCount();
+    return s;
+  }
+
+  // @return false: 잘못된 데이터그램 / 쓸모없는 ack
+  bool onAck(int client, const void *buf, size_t len) {
+    schema::View<SnapshotAck> v;
+    if (client < 0 || client >= (int)clients_.size() || !v.parse(buf, len)) {
+      return false;
+    }
+    Client &c = clients_[client];
+    uint32_t tick = v.get<SnapshotAck::Tick>();
+    if (tick == 0 || tick > tick_ || c.sent[tick % BASELINE_RING] != tick ||
+        tick <= c.acked) {
+      stats_.staleAcks++;
+      return false;
+    }
+    c.acked = tick;
+    return true;
+  }
+
+  // false: 클라이언트마다 따로 인코딩 (비교용). 돌려받은 참조는 다음
+  // snapshotFor까지만 유효
+  void setShareEncodes(bool share) { shareEncodes_ = share; }
+
+  uint32_t ackedTick(int client) const { return clients_[client].acked; }
+  const std::vector<QState> &quantized(uint32_t tick) const {
+    return history_[tick % BASELINE_RING].states;
+  }
+  const Stats &stats() const { return stats_; }
+
+private:
+  struct History {
+    uint32_t tick;
+    std::vector<QState> states;
+  };
+  struct Client {
+    uint32_t acked = 0; // 마지막으로 ack 받은 틱 (0: 없음)
+    uint32_t sent[BASELINE_RING] = {}; // 최근에 보낸 틱 (ack 검증용)
+  };
+
+  int entities_;
+  std::vector<Client> clients_;
+  uint32_t tick_;
+  History history_[BASELINE_RING];
+  bool shareEncodes_;
+  std::map<uint32_t, EncodedSnapshot> cache_; // 이번 틱: baseline -> 인코딩
+  EncodedSnapshot scratch_;                   // 공유하지 않을 때
+  Stats stats_;
+};
+
+// ==========================================
+// 클라이언트
+// ==========================================
+class SnapshotClient {
+public:
+  struct Stats {
+    uint64_t completed = 0;
+    uint64_t dropped = 0;        // 조각이 빠져서 다음 틱으로 넘어감
+    uint64_t missingBaseline = 0; // baseline을 이미 버림 (서버 전체 스냅샷 대기)
+    uint64_t malformed = 0;
+  };
+
+  explicit SnapshotClient(int entities)
+      : entities_(entities), latest_(0), pendingTick_(0), pendingMask_(0),
+        pendingCount_(0) {
+    for (int i = 0; i < BASELINE_RING; i++) {
+      ring_[i].tick = 0;
+      ring_[i].states.resize(entities);
+    }
+    pending_.resize(entities);
+  }
+
+  // @return true: 이 데이터그램으로 스냅샷 하나가 완성됨 (buildAck로 응답)
+  bool onDatagram(const void *buf, size_t len) {
+    schema::View<SnapshotMsg> v;
+    if (!v.parse(buf, len)) {
+      stats_.malformed++;
+      return false;
+    }
+    uint32_t tick = v.get<SnapshotMsg::Tick>();
+    uint32_t baseline = v.get<SnapshotMsg::BaselineTick>();
+    uint32_t frag = v.get<SnapshotMsg::FragIndex>();
+    uint32_t count = v.get<SnapshotMsg::FragCount>();
+    if (tick <= latest_ || count == 0 || count > MAX_FRAGMENTS || frag >= count) {
+      return false; // 옛날 것 / 순서 뒤바뀐 것
+    }
+
+    if (tick != pendingTick_) {
+      if (pendingTick_ != 0) {
+        stats_.dropped++; // 이전 틱은 끝내 완성 못 함
+      }
+      pendingTick_ = 0;
+      if (baseline == 0) {
+        std::fill(pending_.begin(), pending_.end(), QState());
+      } else {
+        const Decoded &base = ring_[baseline % BASELINE_RING];
+        if (base.tick != baseline) {
+          stats_.missingBaseline++;
+          return false;
+        }
+        pending_ = base.states;
+      }
+      pendingTick_ = tick;
+      pendingMask_ = 0;
+      pendingCount_ = count;
+    }
+    uint64_t bit = 1ull << frag;
+    if (pendingMask_ & bit) {
+      return false; // 중복
+    }
+    if (!applyFragment(v, pending_)) {
+      stats_.malformed++;
+      pendingTick_ = 0;
+      return false;
+    }
+    pendingMask_ |= bit;
+    if (pendingMask_ !=
+        (pendingCount_ == 64 ? ~0ull : (1ull << pendingCount_) - 1)) {
+      return false;
+    }
+
+    Decoded &slot = ring_[tick % BASELINE_RING];
+    slot.tick = tick;
+    slot.states.swap(pending_);
+    pending_.resize(entities_);
+    latest_ = tick;
+    pendingTick_ = 0;
+    stats_.completed++;
+    return true;
+  }
+
+  size_t buildAck(void *buf, size_t cap) const {
+    schema::Builder<SnapshotAck> b(buf, cap);
+    b.set<SnapshotAck::Tick>(latest_);
+    return b.size();
+  }
+
+  uint32_t latestTick() const { return latest_; }
+  const std::vector<QState> &state() const {
+    return ring_[latest_ % BASELINE_RING].states;
+  }
+  const Stats &stats() const { return stats_; }
+
+private:
+  struct Decoded {
+    uint32_t tick;
+    std::vector<QState> states;
+  };
+
+  int entities_;
+  uint32_t latest_;
+  Decoded ring_[BASELINE_RING];
+
+  uint32_t pendingTick_;
+  uint64_t pendingMask_;
+  uint32_t pendingCount_;
+  std::vector<QState> pending_;
+  Stats stats_;
+};
+
+} // namespace snap
@@ -0,0 +1,361 @@
+/**
+ * [Lv.7] 델타 스냅샷: 클라이언트당 틱당 바이트 + 서버 인코딩 CPU
+ *
+ * 엔티티 1000개 월드를 틱마다 움직이고 (10%는 계속 이동, 가끔 애니메이션/체력
+ * 변경, 드물게 순간이동), 클라이언트 500명에게 스냅샷을 보낸다. 데이터그램은
+ * 양방향 모두 loss% 확률로 버림 (스냅샷 조각, ack).
+ *
+ *   raw          : 엔티티 구조체를 그대로 (float 4개 + 2B = 18B/엔티티, 계산만)
+ *   full         : 양자화 + 비트 패킹, ack를 안 써서 매 틱 전체 스냅샷
+ *                  (클라이언트마다 따로 인코딩)
+ *   delta        : ack한 baseline 기준 델타, 클라이언트마다 따로 인코딩
+ *   delta_shared : 같은 baseline을 쓰는 클라이언트끼리 인코딩 결과 공유 (기본값)
+ *
+ * CSV 열: mode,loss_pct,entities,clients,bytes_per_client_tick,
+ *         datagrams_per_client_tick,full_pct,encodes_per_tick,
+ *         server_us_per_tick,completed_pct,verified
+ *   bytes: 스냅샷 데이터그램 크기 합 (UDP/IP 헤더 28B 제외)
+ *   server_us_per_tick: 모든 클라이언트의 snapshotFor 합 (양자화 제외)
+ *   completed_pct: 클라이언트가 완성한 스냅샷 비율 (조각이 하나라도 빠지면 실패)
+ *   verified: 표본 클라이언트 8명은 실제로 디코딩해서 서버 상태와 비교
+ *
+ * 마지막에 루프백 UDP 소켓으로 클라이언트 8명을 실제로 돌려 봄 (stderr).
+ *
+ * 컴파일: g++ -o snapshot_bench snapshot_bench.cpp -std=c++11 -O2
+ * 실행: ./snapshot_bench [entities] [clients] [ticks] [loss_pcts]
+ * 예시: ./snapshot_bench 1000 500 300 0,5,20 > snapshot.csv
+ */
+
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+#include "snapshot.h" // [Lv.7]
+
+using namespace std;
+using namespace std::chrono;
+
+const int SAMPLE_CLIENTS = 8; // 실제 디코더를 돌리는 클라이언트 수
+const double TICK_RATE = 30.0;
+
+struct Rng {
+  uint32_t state;
+  explicit Rng(uint32_t seed) : state(seed) {}
+  uint32_t next() {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+  }
+  float unit() { return (next() >> 8) * (1.0f / 16777216.0f); } // [0, 1)
+  bool chance(double p) { return unit() < p; }
+};
+
+// ==========================================
+// 월드 시뮬레이션
+// ==========================================
+struct World {
+  vector<snap::EntityState> entities;
+  vector<bool> mover;
+  Rng rng;
+
+  World(int n, uint32_t seed) : entities(n), mover(n), rng(seed) {
+    for (int i = 0; i < n; i++) {
+      snap::EntityState &e = entities[i];
+      e.x = (rng.unit() * 2 - 1) * 1000.0f;
+      e.y = (rng.unit() * 2 - 1) * 1000.0f;
+      e.z = rng.unit() * 50.0f;
+      e.yaw = rng.unit() * 6.28f;
+      e.health = 100;
+      e.anim = 0;
+      mover[i] = rng.chance(0.1);
+    }
+  }
+
+  void step() {
+    const float SPEED = 5.0f / (float)TICK_RATE; // 5m/s
+    for (size_t i = 0; i < entities.size(); i++) {
+      snap::EntityState &e = entities[i];
+      if (mover[i]) {
+        e.yaw += (rng.unit() - 0.5f) * 0.2f;
+        e.x += cosf(e.yaw) * SPEED;
+        e.y += sinf(e.yaw) * SPEED;
+      }
+      if (rng.chance(0.01)) {
+        e.anim = (uint8_t)(rng.next() % 16);
+      }
+      if (rng.chance(0.002)) {
+        e.health = (uint8_t)(rng.next() % 101);
+      }
+      if (rng.chance(0.0005)) { // 순간이동 (큰 차이 -> 전체 값)
+        e.x = (rng.unit() * 2 - 1) * 1000.0f;
+        e.y = (rng.unit() * 2 - 1) * 1000.0f;
+      }
+    }
+  }
+};
+
+struct Result {
+  double bytes_per_client_tick;
+  double datagrams_per_client_tick;
+  double full_pct;
+  double encodes_per_tick;
+  double server_us_per_tick;
+  double completed_pct;
+  bool verified;
+};
+
+Result run(const string &mode, int entities, int clients, int ticks,
+           double loss) {
+  World world(entities, 12345);
+  snap::SnapshotServer server(entities, clients);
+  server.setShareEncodes(mode == "delta_shared");
+  bool use_acks = mode != "full";
+  vector<snap::SnapshotClient *> decoders;
+  for (int c = 0; c < SAMPLE_CLIENTS && c < clients; c++) {
+    decoders.push_back(new snap::SnapshotClient(entities));
+  }
+  // 표본 밖 클라이언트는 조각 수만 셈 (baseline은 항상 갖고 있음: 서버는
+  // 클라이언트가 ack한, 링 안의 틱만 baseline으로 씀)
+  Rng net(777);
+  uint8_t ack[64];
+
+  bool ok = true;
+  long long completed = 0;
+  double server_ns = 0;
+  for (uint32_t tick = 1; tick <= (uint32_t)ticks; tick++) {
+    world.step();
+    server.beginTick(tick, world.entities);
+    for (int c = 0; c < clients; c++) {
+      auto start = steady_clock::now();
+      const snap::EncodedSnapshot &s = server.snapshotFor(c);
+      server_ns += duration<double, nano>(steady_clock::now() - start).count();
+
+      bool done = false;
+      size_t got = 0;
+      for (size_t f = 0; f < s.fragmentCount(); f++) {
+        if (net.chance(loss)) {
+          continue;
+        }
+        got++;
+        if (c < (int)decoders.size() &&
+            decoders[c]->onDatagram(s.fragment(f), s.fragmentLen(f))) {
+          done = true;
+          if (decoders[c]->state() != server.quantized(tick)) {
+            ok = false;
+          }
+        }
+      }
+      if (c >= (int)decoders.size()) {
+        done = got == s.fragmentCount();
+      }
+      if (!done) {
+        continue;
+      }
+      completed++;
+      if (!use_acks || net.chance(loss)) {
+        continue;
+      }
+      size_t n;
+      if (c < (int)decoders.size()) {
+        n = decoders[c]->buildAck(ack, sizeof(ack));
+      } else {
+        schema::Builder<SnapshotAck> b(ack, sizeof(ack));
+        b.set<SnapshotAck::Tick>(tick);
+        n = b.size();
+      }
+      server.onAck(c, ack, n);
+    }
+  }
+  for (size_t i = 0; i < decoders.size(); i++) {
+    ok = ok && decoders[i]->stats().malformed == 0;
+    delete decoders[i];
+  }
+
+  const snap::SnapshotServer::Stats &st = server.stats();
+  double sends = (double)clients * ticks;
+  Result r;
+  r.bytes_per_client_tick = st.bytesSent / sends;
+  r.datagrams_per_client_tick = st.datagrams / sends;
+  r.full_pct = 100.0 * st.fullSnapshots / sends;
+  r.encodes_per_tick = (double)st.encodes / ticks;
+  r.server_us_per_tick = server_ns / ticks / 1000.0;
+  r.completed_pct = 100.0 * completed / sends;
+  r.verified = ok;
+  return r;
+}
+
+// ==========================================
+// 루프백 UDP로 실제 송수신
+// ==========================================
+int udp_socket() {
+  int sock = socket(PF_INET, SOCK_DGRAM, 0);
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0; // 커널이 고름
+  if (sock == -1 ||
+      ::bind(sock, (struct sockaddr *)&addr, sizeof(addr)) == -1) {
+    perror("udp socket");
+    exit(1);
+  }
+  int rcvbuf = 1 << 20;
+  setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+  return sock;
+}
+
+struct sockaddr_in local_addr(int sock) {
+  struct sockaddr_in addr;
+  socklen_t len = sizeof(addr);
+  getsockname(sock, (struct sockaddr *)&addr, &len);
+  return addr;
+}
+
+bool run_udp_loopback(int entities, int clients, int ticks) {
+  World world(entities, 999);
+  snap::SnapshotServer server(entities, clients);
+  int server_sock = udp_socket();
+  struct sockaddr_in server_addr = local_addr(server_sock);
+  vector<int> socks(clients);
+  vector<struct sockaddr_in> addrs(clients);
+  vector<snap::SnapshotClient *> decoders(clients);
+  for (int c = 0; c < clients; c++) {
+    socks[c] = udp_socket();
+    addrs[c] = local_addr(socks[c]);
+    decoders[c] = new snap::SnapshotClient(entities);
+  }
+
+  bool ok = true;
+  uint8_t buf[2048];
+  long long wire_bytes = 0;
+  for (uint32_t tick = 1; tick <= (uint32_t)ticks; tick++) {
+    world.step();
+    server.beginTick(tick, world.entities);
+    for (int c = 0; c < clients; c++) {
+      const snap::EncodedSnapshot &s = server.snapshotFor(c);
+      for (size_t f = 0; f < s.fragmentCount(); f++) {
+        sendto(server_sock, s.fragment(f), s.fragmentLen(f), 0,
+               (struct sockaddr *)&addrs[c], sizeof(addrs[c]));
+        wire_bytes += s.fragmentLen(f) + 28; // UDP 8 + IPv4 20
+      }
+    }
+    // 클라이언트: 받은 만큼 디코딩 -> 완성되면 ack
+    for (int c = 0; c < clients; c++) {
+      ssize_t n;
+      while ((n = recv(socks[c], buf, sizeof(buf), MSG_DONTWAIT)) > 0) {
+        if (decoders[c]->onDatagram(buf, (size_t)n)) {
+          ok = ok && decoders[c]->state() == server.quantized(tick);
+          size_t len = decoders[c]->buildAck(buf, sizeof(buf));
+          sendto(socks[c], buf, len, 0, (struct sockaddr *)&server_addr,
+                 sizeof(server_addr));
+        }
+      }
+    }
+    // 서버: ack 수거 (보낸 포트로 클라이언트를 찾음)
+    struct sockaddr_in from;
+    socklen_t from_len = sizeof(from);
+    ssize_t n;
+    while ((n = recvfrom(server_sock, buf, sizeof(buf), MSG_DONTWAIT,
+                         (struct sockaddr *)&from, &from_len)) > 0) {
+      for (int c = 0; c < clients; c++) {
+        if (addrs[c].sin_port == from.sin_port) {
+          server.onAck(c, buf, (size_t)n);
+        }
+      }
+      from_len = sizeof(from);
+    }
+  }
+
+  long long completed = 0;
+  for (int c = 0; c < clients; c++) {
+    completed += decoders[c]->stats().completed;
+    ok = ok && decoders[c]->latestTick() == (uint32_t)ticks;
+    delete decoders[c];
+    close(socks[c]);
+  }
+  close(server_sock);
+  cerr << "[*] udp loopback: clients=" << clients << " ticks=" << ticks
+       << " completed=" << completed << " full="
+       << server.stats().fullSnapshots << " wire_bytes_per_client_tick="
+       << wire_bytes / ((long long)clients * ticks)
+       << " verified=" << (ok ? "yes" : "no") << endl;
+  return ok;
+}
+
+vector<string> split(const string &text) {
+  vector<string> out;
+  stringstream ss(text);
+  string item;
+  while (getline(ss, item, ',')) {
+    if (!item.empty()) {
+      out.push_back(item);
+    }
+  }
+  return out;
+}
+
+void print_row(const string &mode, double loss_pct, int entities, int clients,
+               const Result &r) {
+  cout << mode << "," << loss_pct << "," << entities << "," << clients << ","
+       << r.bytes_per_client_tick << "," << r.datagrams_per_client_tick << ","
+       << r.full_pct << "," << r.encodes_per_tick << "," << r.server_us_per_tick
+       << "," << r.completed_pct << "," << (r.verified ? "yes" : "no") << endl;
+}
+
+int main(int argc, char *argv[]) {
+  int entities = 1000;
+  int clients = 500;
+  int ticks = 300;
+  string losses = "0,5,20";
+  if (argc >= 2) {
+    entities = atoi(argv[1]);
+  }
+  if (argc >= 3) {
+    clients = atoi(argv[2]);
+  }
+  if (argc >= 4) {
+    ticks = atoi(argv[3]);
+  }
+  if (argc >= 5) {
+    losses = argv[4];
+  }
+
+  cerr << "[*] entities=" << entities << " clients=" << clients
+       << " ticks=" << ticks << " (" << TICK_RATE << "Hz)"
+       << " max_datagram=" << snap::MAX_DATAGRAM << endl;
+  cout << "mode,loss_pct,entities,clients,bytes_per_client_tick,"
+          "datagrams_per_client_tick,full_pct,encodes_per_tick,"
+          "server_us_per_tick,completed_pct,verified"
+       << endl;
+
+  Result raw;
+  raw.bytes_per_client_tick = entities * 18.0;
+  raw.datagrams_per_client_tick =
+      (double)((entities * 18 + snap::MAX_DATAGRAM - 1) / snap::MAX_DATAGRAM);
+  raw.full_pct = 100;
+  raw.encodes_per_tick = 0;
+  raw.server_us_per_tick = 0;
+  raw.completed_pct = 0;
+  raw.verified = true;
+  print_row("raw", 0, entities, clients, raw);
+
+  bool ok = true;
+  for (const string &l : split(losses)) {
+    double loss_pct = atof(l.c_str());
+    const char *modes[] = {"full", "delta", "delta_shared"};
+    for (const char *mode : modes) {
+      Result r = run(mode, entities, clients, ticks, loss_pct / 100.0);
+      ok = ok && r.verified;
+      print_row(mode, loss_pct, entities, clients, r);
+    }
+  }
+  ok = run_udp_loopback(entities, SAMPLE_CLIENTS, 100) && ok;
+  return ok ? 0 : 1;
+}
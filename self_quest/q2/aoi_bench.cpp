@@ -0,0 +1,225 @@
+/**
+ * [Task 11] 관심 영역 격자 벤치마크
+ *
+ * 한 방(존)에 N명이 매 틱 움직이고, 각자 이동 메시지를 하나씩 보낼 때
+ *   1) 방 전체 브로드캐스트 : 메시지 하나 -> 나머지 N-1명 (틱당 N*(N-1))
+ *   2) aoi::Grid           : 메시지 하나 -> 주변 3x3 칸의 멤버만
+ * 의 틱당 전송 메시지 수와 틱 처리 시간(격자 갱신 + 수신자 열거)을 비교한다.
+ * 격자 쪽은 칸이 바뀐 이동에서 나온 입장/퇴장 알림 수도 같이 센다 (서버에서는
+ * 이것도 메시지).
+ *
+ * 시나리오:
+ *   uniform : 월드 전체에 고르게 흩어져 돌아다님
+ *   cluster : 절반이 중앙 한 곳(마을)에 몰려 있음 - 주변 칸이 붐비는 최악 쪽
+ *
+ * verified: 입장/퇴장 알림만으로 추적한 "보이는 쌍"이 마지막 틱에 위치로 직접
+ *           계산한 쌍과 일치 + 수신자 열거 결과가 같은 기준과 일치
+ *
+ * 컴파일: g++ -o aoi_bench aoi_bench.cpp -std=c++17 -O2
+ * 실행: ./aoi_bench [players] [ticks] [radius]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "aoi_grid.h"
+
+using namespace std;
+using namespace std::chrono;
+
+const float WORLD = 1024;
+const float SPEED = 4; // 틱당 이동 거리 (30Hz 기준 약 120/s)
+
+long long checksum = 0; // 최적화로 지워지지 않게
+
+struct Player {
+  float x, y;
+  float dx, dy;
+};
+
+uint32_t rng = 2463534242u;
+float randUnit() { // [0, 1)
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  return (rng >> 8) * (1.0f / 16777216.0f);
+}
+
+vector<Player> spawn(int players, bool cluster) {
+  vector<Player> out(players);
+  for (int k = 0; k < players; ++k) {
+    Player &p = out[k];
+    if (cluster && k % 2 == 0) { // 중앙 반경 64 안
+      p.x = WORLD / 2 + (randUnit() - 0.5f) * 128;
+      p.y = WORLD / 2 + (randUnit() - 0.5f) * 128;
+    } else {
+      p.x = randUnit() * WORLD;
+      p.y = randUnit() * WORLD;
+    }
+    float angle = randUnit() * 6.2831853f;
+    p.dx = cosf(angle) * SPEED;
+    p.dy = sinf(angle) * SPEED;
+  }
+  return out;
+}
+
+// 가끔 방향을 틀고, 벽에 닿으면 튕김 (마을 사람은 마을 근처를 맴돎)
+void step(vector<Player> &players, bool cluster) {
+  for (size_t k = 0; k < players.size(); ++k) {
+    Player &p = players[k];
+    if (randUnit() < 0.05f) {
+      float angle = randUnit() * 6.2831853f;
+      p.dx = cosf(angle) * SPEED;
+      p.dy = sinf(angle) * SPEED;
+    }
+    if (cluster && k % 2 == 0 &&
+        fabsf(p.x + p.dx - WORLD / 2) + fabsf(p.y + p.dy - WORLD / 2) > 128) {
+      p.dx = -p.dx;
+      p.dy = -p.dy;
+    }
+    p.x += p.dx;
+    p.y += p.dy;
+    if (p.x < 0 || p.x >= WORLD) {
+      p.dx = -p.dx;
+      p.x += 2 * p.dx;
+    }
+    if (p.y < 0 || p.y >= WORLD) {
+      p.dy = -p.dy;
+      p.y += 2 * p.dy;
+    }
+  }
+}
+
+// 기준: 위치만으로 계산한 "서로 보임" (같거나 이웃한 칸)
+bool seesByPosition(const aoi::Grid &grid, int a, int b) {
+  float cs = grid.cellSize();
+  int last = grid.side() - 1;
+  int ax = min((int)(grid.x(a) / cs), last), ay = min((int)(grid.y(a) / cs), last);
+  int bx = min((int)(grid.x(b) / cs), last), by = min((int)(grid.y(b) / cs), last);
+  return abs(ax - bx) <= 1 && abs(ay - by) <= 1;
+}
+
+struct Result {
+  double fullMsgsPerTick;
+  double gridMsgsPerTick;
+  double eventsPerTick;
+  double fullUsPerTick;
+  double gridUsPerTick;
+  bool verified;
+};
+
+Result run(int players, int ticks, float radius, bool cluster) {
+  Result r = {};
+  rng = 2463534242u;
+  vector<Player> state = spawn(players, cluster);
+
+  // 1. 방 전체: 보낸 사람마다 방 멤버 전체를 훑으며 자기 빼고 전송
+  long long fullMsgs = 0;
+  auto t0 = high_resolution_clock::now();
+  for (int t = 0; t < ticks; ++t) {
+    step(state, cluster);
+    for (int s = 0; s < players; ++s) {
+      for (int k = 0; k < players; ++k) {
+        if (k != s) {
+          fullMsgs++;
+          checksum += k;
+        }
+      }
+    }
+  }
+  duration<double, micro> fullTime = high_resolution_clock::now() - t0;
+
+  // 2. 격자: 이동 반영(입장/퇴장 통보) 후 주변 칸에만 전송
+  rng = 2463534242u; // 같은 이동 경로를 재현
+  state = spawn(players, cluster);
+  aoi::Grid grid(WORLD, radius);
+  vector<char> visible((size_t)players * players, 0); // 알림으로만 갱신
+  long long events = 0;
+  auto track = [&](int self) {
+    return [&, self](int other, bool entered) {
+      visible[(size_t)self * players + other] = entered;
+      visible[(size_t)other * players + self] = entered;
+      events += 2; // 양쪽 모두에게 알림
+    };
+  };
+  for (int k = 0; k < players; ++k) {
+    grid.add(k, state[k].x, state[k].y, track(k)); // 엔티티 번호 = k
+  }
+  events = 0; // 처음 배치는 빼고 이동 중 알림만 셈
+
+  long long gridMsgs = 0;
+  t0 = high_resolution_clock::now();
+  for (int t = 0; t < ticks; ++t) {
+    step(state, cluster);
+    for (int k = 0; k < players; ++k) {
+      grid.move(k, state[k].x, state[k].y, track(k));
+    }
+    for (int s = 0; s < players; ++s) {
+      grid.forEachNear(s, [&](int other) {
+        gridMsgs++;
+        checksum += other;
+      });
+    }
+  }
+  duration<double, micro> gridTime = high_resolution_clock::now() - t0;
+
+  // 검증: 알림으로 추적한 쌍 == 위치로 계산한 쌍 == 수신자 열거
+  bool ok = true;
+  vector<char> near(players);
+  for (int a = 0; a < players && ok; ++a) {
+    fill(near.begin(), near.end(), 0);
+    grid.forEachNear(a, [&](int other) { near[other] = 1; });
+    for (int b = 0; b < players; ++b) {
+      bool expected = a != b && seesByPosition(grid, a, b);
+      if (visible[(size_t)a * players + b] != expected || near[b] != expected) {
+        ok = false;
+        break;
+      }
+    }
+  }
+
+  r.fullMsgsPerTick = (double)fullMsgs / ticks;
+  r.gridMsgsPerTick = (double)gridMsgs / ticks;
+  r.eventsPerTick = (double)events / ticks;
+  r.fullUsPerTick = fullTime.count() / ticks;
+  r.gridUsPerTick = gridTime.count() / ticks;
+  r.verified = ok;
+  return r;
+}
+
+int main(int argc, char *argv[]) {
+  int players = 1000;
+  int ticks = 300;
+  float radius = 32;
+  if (argc >= 2)
+    players = atoi(argv[1]);
+  if (argc >= 3)
+    ticks = atoi(argv[2]);
+  if (argc >= 4)
+    radius = (float)atof(argv[3]);
+
+  cout << "=== 관심 영역 격자 벤치마크 (" << players << "명, " << ticks
+       << "틱, 월드 " << WORLD << ", 반경 " << radius << ") ===" << endl;
+
+  bool allOk = true;
+  const char *names[] = {"uniform", "cluster"};
+  for (int c = 0; c < 2; ++c) {
+    Result r = run(players, ticks, radius, c == 1);
+    allOk = allOk && r.verified;
+    cout << "[" << names[c] << "]" << endl;
+    cout << "  방 전체 : " << (long long)r.fullMsgsPerTick << " msgs/tick, "
+         << r.fullUsPerTick << " us/tick" << endl;
+    cout << "  격자    : " << (long long)r.gridMsgsPerTick << " msgs/tick (+"
+         << (long long)r.eventsPerTick << " 입장/퇴장), " << r.gridUsPerTick
+         << " us/tick" << endl;
+    cout << "  감소율  : x"
+         << r.fullMsgsPerTick / (r.gridMsgsPerTick + r.eventsPerTick)
+         << "  검증: " << (r.verified ? "[PASS]" : "[FAIL]") << endl;
+  }
+  cerr << "[*] checksum=" << checksum << endl;
+  return allOk ? 0 : 1;
+}
@@ -0,0 +1,227 @@
+/**
+ * [Task 11] 관심 영역(AOI) 균일 격자 (C++17, 헤더 전용)
+ *
+ * - 월드를 cellSize(= 관심 반경) 크기의 칸으로 나눔. 반경 원은 항상
+ *   자기 칸 + 주변 8칸(3x3) 안에 들어가므로, 브로드캐스트는 그 9칸의
+ *   멤버에게만 보냄 (방 전체 N명 -> 주변 k명)
+ * - 좌표/칸/칸 안 위치는 엔티티 번호로 찾는 배열 묶음(SoA),
+ *   칸 멤버는 칸마다 dense 배열 (삭제는 마지막 원소와 자리 바꾸기)
+ * - 이동 시 칸이 바뀔 때만 입장/퇴장 계산, 그것도 "새로 보이는 칸"과
+ *   "안 보이게 된 칸"의 멤버만 훑음 (옆 칸 이동이면 9칸 중 3~5칸)
+ *
+ * 사용법:
+ *   aoi::Grid grid(1024, 32);
+ *   int id = grid.add(sock, x, y, [](int other, bool entered) {...});
+ *   grid.move(id, nx, ny, onChange);    // 칸이 바뀌면 바뀐 상대만 통보
+ *   grid.forEachNear(id, [](int other) {...});  // 자기 자신 제외
+ *   grid.remove(id, onChange);
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace aoi {
+
+class Grid {
+public:
+  explicit Grid(float worldSize = 1024, float cellSize = 32) {
+    configure(worldSize, cellSize);
+  }
+
+  // 칸 크기 변경 (엔티티가 있으면 안 됨 - 빈 격자에서만 호출)
+  void configure(float worldSize, float cellSize) {
+    worldSize_ = worldSize > 0 ? worldSize : 1;
+    cellSize_ = cellSize > 0 ? cellSize : 1;
+    side_ = (int)(worldSize_ / cellSize_) + 1;
+    cells_.assign((size_t)side_ * side_, std::vector<int>());
+  }
+
+  // 엔티티 추가. onChange(other, true)로 처음 보이는 상대를 모두 통보
+  template <typename Fn> int add(int tag, float x, float y, Fn onChange) {
+    int id;
+    if (!freeIds_.empty()) {
+      id = freeIds_.back();
+      freeIds_.pop_back();
+    } else {
+      id = (int)tags_.size();
+      xs_.push_back(0);
+      ys_.push_back(0);
+      tags_.push_back(0);
+      cellOf_.push_back(-1);
+      slotOf_.push_back(-1);
+    }
+    tags_[id] = tag;
+    xs_[id] = clamp(x);
+    ys_[id] = clamp(y);
+    insertIntoCell(id, cellIndex(xs_[id], ys_[id]));
+    count_++;
+    forEachNear(id, [&](int other) { onChange(other, true); });
+    return id;
+  }
+
+  // 엔티티 제거. onChange(other, false)로 주변 상대에게 퇴장 통보
+  template <typename Fn> void remove(int id, Fn onChange) {
+    if (!alive(id))
+      return;
+    forEachNear(id, [&](int other) { onChange(other, false); });
+    eraseFromCell(id);
+    freeIds_.push_back(id);
+    count_--;
+  }
+
+  // 위치 갱신. 칸이 바뀌면 새로 보이는/안 보이게 된 상대만 통보
+  template <typename Fn> void move(int id, float x, float y, Fn onChange) {
+    if (!alive(id))
+      return;
+    xs_[id] = clamp(x);
+    ys_[id] = clamp(y);
+    int from = cellOf_[id];
+    int to = cellIndex(xs_[id], ys_[id]);
+    if (from == to)
+      return; // 대부분의 이동은 여기서 끝 (칸 안에서 움직임)
+
+    moves_++;
+    int fx = from % side_, fy = from / side_;
+    int tx = to % side_, ty = to / side_;
+
+    // 예전 주변에만 있던 칸 -> 퇴장
+    for (int cy = fy - 1; cy <= fy + 1; ++cy) {
+      for (int cx = fx - 1; cx <= fx + 1; ++cx) {
+        if (inside(cx, cy) && !adjacent(cx, cy, tx, ty)) {
+          notifyCell(id, cy * side_ + cx, false, onChange);
+        }
+      }
+    }
+    // 새 주변에만 있는 칸 -> 입장 (자기 자신은 아직 예전 칸에 있음)
+    for (int cy = ty - 1; cy <= ty + 1; ++cy) {
+      for (int cx = tx - 1; cx <= tx + 1; ++cx) {
+        if (inside(cx, cy) && !adjacent(cx, cy, fx, fy)) {
+          notifyCell(id, cy * side_ + cx, true, onChange);
+        }
+      }
+    }
+
+    eraseFromCell(id);
+    insertIntoCell(id, to);
+  }
+
+  // 주변 3x3 칸의 멤버 (자기 자신 제외)
+  template <typename Fn> void forEachNear(int id, Fn fn) const {
+    int cell = cellOf_[id];
+    int cx0 = cell % side_, cy0 = cell / side_;
+    for (int cy = cy0 - 1; cy <= cy0 + 1; ++cy) {
+      for (int cx = cx0 - 1; cx <= cx0 + 1; ++cx) {
+        if (!inside(cx, cy))
+          continue;
+        for (int other : cells_[cy * side_ + cx]) {
+          if (other != id)
+            fn(other);
+        }
+      }
+    }
+  }
+
+  // 주변 멤버 수 (보낼 메시지 수 미리 세기용)
+  size_t countNear(int id) const {
+    int cell = cellOf_[id];
+    int cx0 = cell % side_, cy0 = cell / side_;
+    size_t n = 0;
+    for (int cy = cy0 - 1; cy <= cy0 + 1; ++cy) {
+      for (int cx = cx0 - 1; cx <= cx0 + 1; ++cx) {
+        if (inside(cx, cy))
+          n += cells_[cy * side_ + cx].size();
+      }
+    }
+    return n - 1; // 자기 자신
+  }
+
+  // 두 엔티티가 서로 보이는지 (같거나 이웃한 칸)
+  bool sees(int a, int b) const {
+    int ca = cellOf_[a], cb = cellOf_[b];
+    return adjacent(ca % side_, ca / side_, cb % side_, cb / side_);
+  }
+
+  bool alive(int id) const {
+    return id >= 0 && id < (int)cellOf_.size() && cellOf_[id] != -1;
+  }
+  int tag(int id) const { return tags_[id]; }
+  float x(int id) const { return xs_[id]; }
+  float y(int id) const { return ys_[id]; }
+  size_t size() const { return count_; }
+  size_t capacity() const { return tags_.size(); } // 엔티티 번호 상한
+  int side() const { return side_; }
+  float cellSize() const { return cellSize_; }
+  long long cellMoves() const { return moves_; } // 칸을 넘은 이동 횟수
+
+private:
+  float clamp(float v) const {
+    if (!(v >= 0)) // NaN 포함
+      return 0;
+    return v < worldSize_ ? v : worldSize_;
+  }
+
+  int cellIndex(float x, float y) const {
+    int cx = (int)(x / cellSize_), cy = (int)(y / cellSize_);
+    if (cx >= side_)
+      cx = side_ - 1;
+    if (cy >= side_)
+      cy = side_ - 1;
+    return cy * side_ + cx;
+  }
+
+  bool inside(int cx, int cy) const {
+    return cx >= 0 && cy >= 0 && cx < side_ && cy < side_;
+  }
+
+  static bool adjacent(int ax, int ay, int bx, int by) {
+    int dx = ax - bx, dy = ay - by;
+    return dx >= -1 && dx <= 1 && dy >= -1 && dy <= 1;
+  }
+
+  template <typename Fn>
+  void notifyCell(int id, int cell, bool entered, Fn &onChange) {
+    for (int other : cells_[cell]) {
+      if (other != id)
+        onChange(other, entered);
+    }
+  }
+
+  void insertIntoCell(int id, int cell) {
+    std::vector<int> &members = cells_[cell];
+    cellOf_[id] = cell;
+    slotOf_[id] = (int)members.size();
+    members.push_back(id);
+  }
+
+  // 마지막 멤버를 빈 자리로 옮김 (O(1))
+  void eraseFromCell(int id) {
+    std::vector<int> &members = cells_[cellOf_[id]];
+    int slot = slotOf_[id];
+    int last = members.back();
+    members[slot] = last;
+    slotOf_[last] = slot;
+    members.pop_back();
+    cellOf_[id] = -1;
+    slotOf_[id] = -1;
+  }
+
+  float worldSize_ = 1;
+  float cellSize_ = 1;
+  int side_ = 1; // 한 변의 칸 수
+
+  // 엔티티별 (SoA): 브로드캐스트/이동 경로는 필요한 배열만 건드림
+  std::vector<float> xs_, ys_;
+  std::vector<int> tags_;   // 호출 측 식별자 (서버: 소켓 번호)
+  std::vector<int> cellOf_; // -1: 빈 번호
+  std::vector<int> slotOf_; // cells_[cellOf_] 안의 위치
+
+  std::vector<std::vector<int>> cells_; // 칸별 멤버 (엔티티 번호)
+  std::vector<int> freeIds_;
+  size_t count_ = 0;
+  long long moves_ = 0;
+};
+
+} // namespace aoi
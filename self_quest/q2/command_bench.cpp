@@ -0,0 +1,127 @@
+/**
+ * [Task 7] 명령어 처리 벤치마크
+ *
+ * 게임 서버 수준(수십 개)의 명령어가 있을 때
+ *   1) 기존 방식: if / strncmp 체인 + atoi
+ *   2) 새 방식  : command_table.h (컴파일 타임 완전 해시) + from_chars
+ * 의 초당 처리 명령어 수를 비교한다.
+ *
+ * 컴파일: g++ -o command_bench command_bench.cpp -std=c++17 -O2
+ * 실행: ./command_bench [iterations]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "command_table.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// 핸들러가 하는 일: 첫 번째 숫자 인자를 누적 (최적화로 지워지지 않게)
+long long checksum = 0;
+
+typedef void (*BenchHandler)(string_view args);
+
+template <int ID> void onCommand(string_view args) {
+  int value = 0;
+  cmd::nextNumber(args, value);
+  checksum += value + ID;
+}
+
+// 게임 서버에서 흔한 명령어 40개
+constexpr cmd::Entry<BenchHandler> COMMANDS[] = {
+    {"join", onCommand<0>},       {"exit", onCommand<1>},
+    {"budget", onCommand<2>},     {"history", onCommand<3>},
+    {"rooms", onCommand<4>},      {"move", onCommand<5>},
+    {"attack", onCommand<6>},     {"cast", onCommand<7>},
+    {"use", onCommand<8>},        {"equip", onCommand<9>},
+    {"unequip", onCommand<10>},   {"drop", onCommand<11>},
+    {"pickup", onCommand<12>},    {"trade", onCommand<13>},
+    {"accept", onCommand<14>},    {"decline", onCommand<15>},
+    {"party", onCommand<16>},     {"invite", onCommand<17>},
+    {"kick", onCommand<18>},      {"leave", onCommand<19>},
+    {"guild", onCommand<20>},     {"whisper", onCommand<21>},
+    {"shout", onCommand<22>},     {"emote", onCommand<23>},
+    {"sit", onCommand<24>},       {"stand", onCommand<25>},
+    {"respawn", onCommand<26>},   {"teleport", onCommand<27>},
+    {"quest", onCommand<28>},     {"abandon", onCommand<29>},
+    {"shop", onCommand<30>},      {"buy", onCommand<31>},
+    {"sell", onCommand<32>},      {"repair", onCommand<33>},
+    {"craft", onCommand<34>},     {"mail", onCommand<35>},
+    {"friend", onCommand<36>},    {"block", onCommand<37>},
+    {"ping", onCommand<38>},      {"stats", onCommand<39>},
+};
+const int NUM_COMMANDS = sizeof(COMMANDS) / sizeof(COMMANDS[0]);
+
+constexpr auto COMMAND_TABLE = cmd::makeTable(COMMANDS);
+
+// 기존 방식: "/name " 접두어를 하나씩 strncmp (main4.cpp의 if 체인과 동일)
+void dispatchChain(const char *buf) {
+  for (int k = 0; k < NUM_COMMANDS; ++k) {
+    const string_view name = COMMANDS[k].name;
+    if (strncmp(buf + 1, name.data(), name.size()) == 0 &&
+        buf[1 + name.size()] == ' ') {
+      checksum += atoi(buf + 2 + name.size()) + k;
+      return;
+    }
+  }
+}
+
+void dispatchTable(const char *buf, size_t len) {
+  string_view args;
+  string_view name = cmd::splitCommand(string_view(buf, len), args);
+  BenchHandler handler = COMMAND_TABLE.find(name);
+  if (handler) {
+    handler(args);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  long long iterations = 10000000;
+  if (argc >= 2) {
+    iterations = atoll(argv[1]);
+  }
+
+  // 모든 명령어를 골고루 섞은 입력 (체인 뒤쪽 명령어도 공평하게 등장)
+  vector<string> lines;
+  for (int k = 0; k < NUM_COMMANDS; ++k) {
+    lines.push_back("/" + string(COMMANDS[k].name) + " " + to_string(k * 7));
+  }
+
+  cout << "=== 명령어 처리 벤치마크 (" << NUM_COMMANDS << "개 명령어, "
+       << iterations << "회) ===" << endl;
+
+  // 1. if / strncmp 체인
+  checksum = 0;
+  auto start = high_resolution_clock::now();
+  for (long long n = 0; n < iterations; ++n) {
+    dispatchChain(lines[n % NUM_COMMANDS].c_str());
+  }
+  duration<double> chainTime = high_resolution_clock::now() - start;
+  long long chainChecksum = checksum;
+
+  // 2. 완전 해시 테이블
+  checksum = 0;
+  start = high_resolution_clock::now();
+  for (long long n = 0; n < iterations; ++n) {
+    const string &line = lines[n % NUM_COMMANDS];
+    dispatchTable(line.data(), line.size());
+  }
+  duration<double> tableTime = high_resolution_clock::now() - start;
+  long long tableChecksum = checksum;
+
+  cout << "[strncmp chain] " << (long long)(iterations / chainTime.count())
+       << " cmds/sec (" << chainTime.count() << " 초)" << endl;
+  cout << "[hash table   ] " << (long long)(iterations / tableTime.count())
+       << " cmds/sec (" << tableTime.count() << " 초)" << endl;
+  cout << "  결과 일치    : "
+       << (chainChecksum == tableChecksum ? "[PASS]" : "[FAIL]") << endl;
+
+  return 0;
+}
@@ -0,0 +1,195 @@
+/**
+ * [Task 7] 테이블 기반 명령어 처리기 (C++17, 헤더 전용)
+ *
+ * - 명령어 이름 -> 핸들러 테이블을 컴파일 타임에 완전 해시(perfect hash)로 구성
+ *   (충돌 없는 seed를 constexpr로 찾고, 못 찾으면 컴파일 에러)
+ * - 수신 버퍼 위의 std::string_view로 파싱 (문자열 복사 X)
+ * - 숫자 인자는 std::from_chars로 파싱 (atoi와 달리 실패를 알 수 있음)
+ *
+ * 사용법:
+ *   constexpr cmd::Entry<Handler> COMMANDS[] = {
+ *       {"join", onJoin}, // 명령어 추가 = 이 배열에 한 줄
+ *   };
+ *   constexpr auto TABLE = cmd::makeTable(COMMANDS);
+ *   Handler h = TABLE.find("join");
+ */
+
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+
+namespace cmd {
+
+template <typename Handler> struct Entry {
+  std::string_view name;
+  Handler handler;
+};
+
+// FNV-1a (seed를 섞어서 충돌 없는 조합을 찾을 수 있게 함)
+constexpr uint32_t hashName(std::string_view name, uint32_t seed) {
+  uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+  for (char c : name) {
+    h ^= (uint8_t)c;
+    h *= 16777619u;
+  }
+  return h;
+}
+
+// 명령어 수의 4배 이상인 2의 거듭제곱 (빈 슬롯이 많을수록 seed를 빨리 찾음)
+constexpr size_t tableSize(size_t n) {
+  size_t size = 4;
+  while (size < n * 4) {
+    size *= 2;
+  }
+  return size;
+}
+
+template <typename Handler, size_t N> class Table {
+public:
+  static constexpr size_t SIZE = tableSize(N);
+
+  constexpr explicit Table(const Entry<Handler> (&entries)[N])
+      : entries_{}, slots_{}, seed_(0) {
+    for (size_t k = 0; k < N; ++k) {
+      entries_[k] = entries[k];
+    }
+
+    for (uint32_t seed = 0; seed < 100000; ++seed) {
+      if (tryBuild(seed)) {
+        seed_ = seed;
+        return;
+      }
+    }
+    throw "cmd::Table: no collision-free seed (duplicate command name?)";
+  }
+
+  // 없는 명령어면 nullptr
+  constexpr Handler find(std::string_view name) const {
+    int16_t index = slots_[hashName(name, seed_) & (SIZE - 1)];
+    if (index < 0 || entries_[index].name != name) {
+      return nullptr;
+    }
+    return entries_[index].handler;
+  }
+
+  constexpr const std::array<Entry<Handler>, N> &entries() const {
+    return entries_;
+  }
+
+private:
+  constexpr bool tryBuild(uint32_t seed) {
+    for (size_t k = 0; k < SIZE; ++k) {
+      slots_[k] = -1;
+    }
+    for (size_t k = 0; k < N; ++k) {
+      size_t slot = hashName(entries_[k].name, seed) & (SIZE - 1);
+      if (slots_[slot] != -1) {
+        return false;
+      }
+      slots_[slot] = (int16_t)k;
+    }
+    return true;
+  }
+
+  std::array<Entry<Handler>, N> entries_;
+  std::array<int16_t, SIZE> slots_;
+  uint32_t seed_;
+};
+
+template <typename Handler, size_t N>
+constexpr Table<Handler, N> makeTable(const Entry<Handler> (&entries)[N]) {
+  return Table<Handler, N>(entries);
+}
+
+// ============================================================
+// 파싱 도우미 (모두 string_view 위에서 동작, 복사 X)
+// ============================================================
+
+inline bool isSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+inline std::string_view trim(std::string_view text) {
+  while (!text.empty() && isSpace(text.front())) {
+    text.remove_prefix(1);
+  }
+  while (!text.empty() && isSpace(text.back())) {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+// 공백으로 구분된 다음 토큰을 잘라내고, args는 그 뒤로 전진
+inline std::string_view nextToken(std::string_view &args) {
+  args = trim(args);
+  size_t end = 0;
+  while (end < args.size() && !isSpace(args[end])) {
+    ++end;
+  }
+  std::string_view token = args.substr(0, end);
+  args.remove_prefix(end);
+  return token;
+}
+
+// 다음 토큰을 숫자로 파싱 (토큰 전체가 숫자가 아니면 실패)
+template <typename T> bool nextNumber(std::string_view &args, T &out) {
+  std::string_view token = nextToken(args);
+  if (token.empty()) {
+    return false;
+  }
+  std::from_chars_result r =
+      std::from_chars(token.data(), token.data() + token.size(), out);
+  return r.ec == std::errc() && r.ptr == token.data() + token.size();
+}
+
+// "/name args..." -> name, args 분리 (앞의 '/'는 호출 측에서 확인)
+inline std::string_view splitCommand(std::string_view line,
+                                     std::string_view &args) {
+  line = trim(line);
+  if (!line.empty() && line.front() == '/') {
+    line.remove_prefix(1);
+  }
+  args = line;
+  return nextToken(args);
+}
+
+// ============================================================
+// 응답 조립기 (sprintf 대신 고정 버퍼 + to_chars)
+// ============================================================
+
+class Reply {
+public:
+  Reply() : len_(0) {}
+
+  Reply &operator<<(std::string_view text) {
+    size_t n = text.size() < CAPACITY - len_ ? text.size() : CAPACITY - len_;
+    text.copy(buf_ + len_, n);
+    len_ += n;
+    return *this;
+  }
+
+  Reply &operator<<(long long value) {
+    std::to_chars_result r = std::to_chars(buf_ + len_, buf_ + CAPACITY, value);
+    if (r.ec == std::errc()) {
+      len_ = r.ptr - buf_;
+    }
+    return *this;
+  }
+
+  Reply &operator<<(int value) { return *this << (long long)value; }
+
+  const char *data() const { return buf_; }
+  size_t size() const { return len_; }
+
+private:
+  static constexpr size_t CAPACITY = 256;
+  char buf_[CAPACITY];
+  size_t len_;
+};
+
+} // namespace cmd
@@ -1,54 +1,848 @@
 #include <algorithm>
 #include <arpa/inet.h>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <linux/tcp.h> // TCP_INFO (tcpi_segs_out: wire 세그먼트 수)
+#include <map>
+#include <memory>
+#include <netinet/in.h>
+#include <string>
+#include <string_view>
 #include <sys/select.h> // select 함수와 fd_set 매크로 사용
 #include <sys/socket.h>
 #include <sys/time.h>
+#include <sys/uio.h> // iovec (gathered write)
 #include <unistd.h>
 #include <vector>
 
+#include "aoi_grid.h"      // [Task 11] 관심 영역 격자
+#include "command_table.h" // [Task 7] 명령어 테이블
+#include "../q4/async_log.h"  // [Task 9] 이벤트 로그는 비동기 로거로
+#include "../q4/metrics.h"    // [Task 10] 실시간 지표 (Prometheus 관리 포트)
+
 using namespace std;
+using namespace std::chrono;
 
 const int PORT = 9000;
 const int BUF_SIZE = 1024;
 const int HEARTBEAT_TIMEOUT = 5; // [Task 4] 5초 동안 말 없으면 강퇴
+const int STATS_INTERVAL = 10;   // [Task 5] 전송 통계 출력 주기 (초)
+const int MAX_IOV = 64;          // [Task 5] sendmsg 한 번에 묶을 최대 메시지 수
+const int HISTORY_CAPACITY = 50;       // [Task 6] 방별 기본 히스토리 개수
+const size_t HISTORY_MAX_BYTES = 65536; // [Task 6] 방별 기본 히스토리 메모리 한도
+// [Task 6] /history로 바꿀 수 있는 상한 (클라이언트 값으로 슬롯 배열을 잡으므로)
+const int HISTORY_CAPACITY_LIMIT = 10000;
+const size_t HISTORY_MAX_BYTES_LIMIT = 16 * 1024 * 1024;
+const float AOI_WORLD_SIZE = 1024; // [Task 11] 공간 모드 월드 한 변 (0 ~ 1024)
+
+// [Task 8] 지연 히스토그램 (log-linear 버킷, us 단위)
+// 2의 거듭제곱 구간마다 16칸 -> 상대 오차 약 6% 이내, 샘플 저장 X
+struct LatencyHistogram {
+  static const int SUB_BUCKETS = 16;
+  static const int MAGNITUDES = 32; // 최대 약 2^35 us
+  long long buckets[MAGNITUDES * SUB_BUCKETS];
+  long long count;
+  long long sum;
+  long long max;
+};
+
+// [Task 5] 브로드캐스트 메시지는 한 번만 만들고 수신자들이 공유 (복사 X)
+// [Task 8] 팬아웃 지연 측정을 위해 도착 시각과 남은 수신자 수를 함께 보관
+struct ChatMessage {
+  string text;           // 만든 뒤로는 수정하지 않음
+  int roomId;
+  long long ingressUs;   // 서버가 read()로 받은 시각 (monotonic)
+  int pendingRecipients; // 아직 소켓에 넘기지 못한 수신자 수
+  bool tracked;          // 지연 통계에 넣을지 (AOI 알림은 순서만 맞추고 X)
+};
+typedef shared_ptr<ChatMessage> Message;
 
 // [Task 3] 유저 정보를 담는 구조체
 struct User {
   int socket;
   int roomId;           // 0: 로비, 1~N: 채팅방
   time_t lastHeartbeat; // [Task 4] 마지막 생존 신고 시간
+  vector<Message> outbox; // [Task 5] 이번 틱에 쌓인 보낼 메시지들
+  long long outboxSince;  // [Task 5] outbox 첫 메시지가 쌓인 시각 (us)
+  int aoiId;              // [Task 11] 방 격자 안의 번호 (-1: 공간 모드 아님)
+};
+
+// [Task 6] 방의 최근 메시지 링 버퍼 (고정 슬롯, 가장 오래된 것부터 덮어씀)
+// 슬롯에는 브로드캐스트 때 만든 Message(shared_ptr)를 그대로 보관 -> 복사 X
+struct HistoryRing {
+  vector<Message> slots; // 크기 = 최대 보관 개수
+  size_t head;           // 가장 오래된 메시지 위치
+  size_t count;          // 현재 보관 개수
+  size_t bytes;          // 보관 중인 payload 총 바이트
+  size_t maxBytes;       // payload 메모리 한도
+};
+
+// [Task 8] 방별 지연 히스토그램
+struct RoomLatency {
+  LatencyHistogram delivery; // 도착 ~ 수신자 1명에게 전달
+  LatencyHistogram fanout;   // 도착 ~ 마지막 수신자에게 전달
+};
+
+// [Task 5] 방별 설정 (지연 예산: 메시지를 최대 몇 ms까지 모아둘지)
+// [Task 6] 방은 첫 멤버가 들어올 때 만들고 마지막 멤버가 나가면 지움
+// (히스토리/설정도 같이 사라짐 - 빈 방 번호마다 메모리를 붙잡지 않게)
+struct Room {
+  int members; // 현재 인원
+  int flushBudgetMs;
+  HistoryRing history; // [Task 6] 입장 시 재생할 최근 대화
+  unique_ptr<RoomLatency> latency; // [Task 8] 첫 전달 때 생성 (히스토그램 2개 ~8KB)
+  long long abandonedFanouts; // [Task 8] 남은 수신자가 나가서 끝난 팬아웃
+  unique_ptr<aoi::Grid> grid; // [Task 11] 공간 모드 멤버 위치 (첫 입장 때 생성)
+};
+
+// [Task 5] 전송 통계 (immediate vs tick 비교용)
+struct BroadcastStats {
+  long long delivered;  // 수신자에게 전달된 메시지 수
+  long long writeCalls; // write/sendmsg 시스템 콜 횟수
+  long long segsClosed; // 이미 닫힌 소켓들이 보낸 TCP 세그먼트 수
 };
 
 // 접속자 관리 (int 대신 User 구조체 저장)
 vector<User> users;
 
+// [Task 5] 방 목록 (없는 방은 기본 예산으로 생성)
+map<int, Room> rooms;
+
+// [Task 5] Tick 모드 설정 (기본은 즉시 전송)
+bool useTickMode = false;
+int defaultFlushBudgetMs = 2;
+
+// [Task 11] 공간 모드 설정 (기본은 방 전체 브로드캐스트)
+bool useSpatialMode = false;
+float aoiRadius = 32;
+
+// [Task 11] 소켓 번호 -> users 안 위치 (격자가 돌려준 소켓으로 바로 찾기)
+// users가 바뀌면 뒤쪽만 다시 채움, 읽을 때 socket이 맞는지 확인
+int userIndex[FD_SETSIZE];
+
+BroadcastStats stats = {0, 0, 0};
+
+// [Task 8] 전체 방 합산 지연 히스토그램
+LatencyHistogram globalDeliveryLatency;
+LatencyHistogram globalFanoutLatency;
+long long globalAbandonedFanouts = 0;
+
+// [Task 10] 관리 포트로 내보내는 지표 (select 루프가 같이 응답)
+// 소켓이 blocking이라 EAGAIN 대신 덜 써진 write를 셈
+struct ChatMetrics {
+  metrics::Counter accepts;
+  metrics::Counter closesEof;
+  metrics::Counter closesHeartbeat;
+  metrics::Counter bytesIn;
+  metrics::Counter bytesOut;
+  metrics::Counter shortWrites;
+  metrics::Gauge users;
+  metrics::Gauge outboxMessages;
+  metrics::Counter aoiEvents; // [Task 11]
+  metrics::Histogram readyPerSelect;
+  metrics::Histogram loopIterationNs;
+};
+ChatMetrics chatMetrics;
+
+void registerMetrics() {
+  chatMetrics.accepts =
+      metrics::counter("chat_accepts_total", "Accepted connections");
+  chatMetrics.closesEof = metrics::counter(
+      "chat_closes_total{reason=\"eof\"}", "Closed connections");
+  chatMetrics.closesHeartbeat = metrics::counter(
+      "chat_closes_total{reason=\"heartbeat\"}", "Closed connections");
+  chatMetrics.bytesIn =
+      metrics::counter("chat_bytes_in_total", "Bytes read from clients");
+  chatMetrics.bytesOut = metrics::counter("chat_bytes_out_total",
+                                          "Broadcast bytes written to clients");
+  chatMetrics.shortWrites = metrics::counter(
+      "chat_short_writes_total", "Broadcast writes that did not send it all");
+  chatMetrics.users = metrics::gauge("chat_users", "Connected users");
+  chatMetrics.outboxMessages = metrics::gauge(
+      "chat_outbox_messages", "Messages waiting in tick-mode outboxes");
+  chatMetrics.aoiEvents = metrics::counter(
+      "chat_aoi_events_total", "Area-of-interest enter/leave notifications");
+  chatMetrics.readyPerSelect = metrics::histogram(
+      "chat_select_ready_fds", "Ready sockets returned by select", 1.0, 11);
+  chatMetrics.loopIterationNs = metrics::histogram(
+      "chat_loop_iteration_seconds", "Time spent handling one select wakeup",
+      1e-9, 31);
+}
+
+// [Task 10] 보내려던 바이트 vs 실제로 넘긴 바이트
+void recordWrite(ssize_t written, size_t wanted) {
+  if (written > 0) {
+    chatMetrics.bytesOut.add(written);
+  }
+  if (written < (ssize_t)wanted) {
+    chatMetrics.shortWrites.inc();
+  }
+}
+
+// [Task 5] 단조 증가 시계 (us) - 시스템 시간 변경에 영향받지 않음
+long long nowUs() {
+  return duration_cast<microseconds>(steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// [Task 8] 히스토그램 도우미
+int histogramIndex(long long value) {
+  const int SUB = LatencyHistogram::SUB_BUCKETS;
+  if (value < SUB)
+    return value < 0 ? 0 : (int)value;
+  int magnitude = 63 - __builtin_clzll(value); // 4 이상
+  int sub = (int)((value >> (magnitude - 4)) & (SUB - 1));
+  int index = (magnitude - 3) * SUB + sub;
+  int last = LatencyHistogram::MAGNITUDES * SUB - 1;
+  return index < last ? index : last;
+}
+
+// 버킷의 상한값
+long long histogramValue(int index) {
+  const int SUB = LatencyHistogram::SUB_BUCKETS;
+  if (index < SUB)
+    return index;
+  int shift = index / SUB + 3 - 4;
+  return ((long long)(SUB + index % SUB) << shift) + ((1LL << shift) - 1);
+}
+
+void histogramRecord(LatencyHistogram &h, long long value) {
+  h.buckets[histogramIndex(value)]++;
+  h.count++;
+  h.sum += value;
+  if (value > h.max)
+    h.max = value;
+}
+
+long long histogramPercentile(const LatencyHistogram &h, double p) {
+  if (h.count == 0)
+    return 0;
+  long long target = (long long)(h.count * p / 100.0);
+  if (target >= h.count)
+    target = h.count - 1;
+  long long seen = 0;
+  for (int k = 0; k < LatencyHistogram::MAGNITUDES *
+                          LatencyHistogram::SUB_BUCKETS;
+       ++k) {
+    seen += h.buckets[k];
+    if (seen > target)
+      return min(histogramValue(k), h.max);
+  }
+  return h.max;
+}
+
+// "n=.. p50=.. p99=.. max=.." 한 줄 요약
+string histogramSummary(const LatencyHistogram &h) {
+  char line[160];
+  sprintf(line, "n=%lld p50=%lld p90=%lld p99=%lld p99.9=%lld max=%lld us",
+          h.count, histogramPercentile(h, 50), histogramPercentile(h, 90),
+          histogramPercentile(h, 99), histogramPercentile(h, 99.9), h.max);
+  return line;
+}
+
+// 멤버가 있는 방 (입장한 유저의 roomId면 항상 있음)
+Room &getRoom(int roomId) {
+  map<int, Room>::iterator it = rooms.find(roomId);
+  if (it == rooms.end()) {
+    Room room;
+    room.members = 0;
+    room.flushBudgetMs = defaultFlushBudgetMs;
+    room.history.slots.resize(HISTORY_CAPACITY);
+    room.history.head = 0;
+    room.history.count = 0;
+    room.history.bytes = 0;
+    room.history.maxBytes = HISTORY_MAX_BYTES;
+    room.abandonedFanouts = 0;
+    it = rooms.insert(make_pair(roomId, std::move(room))).first;
+  }
+  return it->second;
+}
+
+// 이미 비어서 지워졌을 수 있는 방 (지난 메시지의 통계 등, 만들지 않음)
+Room *findRoom(int roomId) {
+  map<int, Room>::iterator it = rooms.find(roomId);
+  return it == rooms.end() ? nullptr : &it->second;
+}
+
+// [Task 6] 방 입장/퇴장 (인원이 0이 되면 방을 지움)
+void enterRoom(User &user, int roomId) {
+  getRoom(roomId).members++;
+  user.roomId = roomId;
+}
+
+void leaveRoom(int roomId) {
+  map<int, Room>::iterator it = rooms.find(roomId);
+  if (it != rooms.end() && --it->second.members == 0) {
+    rooms.erase(it);
+  }
+}
+
+// [Task 6] 가장 오래된 메시지 하나 버리기
+void historyPopOldest(HistoryRing &ring) {
+  Message &oldest = ring.slots[ring.head];
+  ring.bytes -= oldest->text.size();
+  oldest.reset(); // 마지막 참조였다면 여기서 버퍼 해제
+  ring.head = (ring.head + 1) % ring.slots.size();
+  ring.count--;
+}
+
+// [Task 6] 새 메시지 저장 (개수/메모리 한도를 넘으면 오래된 것부터 버림)
+void historyPush(HistoryRing &ring, const Message &msg) {
+  if (ring.slots.empty() || msg->text.size() > ring.maxBytes)
+    return;
+
+  while (ring.count > 0 && (ring.count == ring.slots.size() ||
+                            ring.bytes + msg->text.size() > ring.maxBytes)) {
+    historyPopOldest(ring);
+  }
+
+  size_t tail = (ring.head + ring.count) % ring.slots.size();
+  ring.slots[tail] = msg;
+  ring.bytes += msg->text.size();
+  ring.count++;
+}
+
+// [Task 6] 오래된 순서대로 꺼내기 (포인터만 복사)
+void historyCollect(const HistoryRing &ring, vector<Message> &out) {
+  for (size_t k = 0; k < ring.count; ++k) {
+    out.push_back(ring.slots[(ring.head + k) % ring.slots.size()]);
+  }
+}
+
+// [Task 6] 보관 개수/메모리 한도 변경 (최신 메시지부터 살림)
+void historyResize(HistoryRing &ring, size_t capacity, size_t maxBytes) {
+  vector<Message> kept;
+  historyCollect(ring, kept);
+
+  ring.slots.assign(capacity, Message());
+  ring.head = 0;
+  ring.count = 0;
+  ring.bytes = 0;
+  ring.maxBytes = maxBytes;
+
+  size_t start = kept.size() > capacity ? kept.size() - capacity : 0;
+  for (size_t k = start; k < kept.size(); ++k) {
+    historyPush(ring, kept[k]);
+  }
+}
+
+// [Task 6] 링이 차지하는 메모리 (슬롯 배열 + 보관 중인 payload)
+size_t historyMemory(const HistoryRing &ring) {
+  return ring.slots.size() * sizeof(Message) + ring.bytes;
+}
+
+// [Task 5] 커널이 이 소켓으로 실제 내보낸 TCP 세그먼트 수 (= wire 패킷 수)
+long long tcpSegsOut(int sock) {
+  struct tcp_info info;
+  socklen_t len = sizeof(info);
+  memset(&info, 0, sizeof(info));
+  if (getsockopt(sock, IPPROTO_TCP, TCP_INFO, &info, &len) == -1) {
+    return 0;
+  }
+  return info.tcpi_segs_out;
+}
+
 // 유저 찾기 헬퍼 함수
+// [Task 11] userIndex로 바로 찾음 (방 전체를 훑지 않고 격자 수신자에게 전달)
 User *findUser(int sock) {
+  if (sock < 0 || sock >= FD_SETSIZE)
+    return nullptr;
+  size_t k = (size_t)userIndex[sock];
+  if (k < users.size() && users[k].socket == sock)
+    return &users[k];
+  return nullptr;
+}
+
+// [Task 11] users[from..]의 위치 다시 기록 (추가/삭제 뒤)
+void reindexUsers(size_t from) {
+  for (size_t k = from; k < users.size(); ++k) {
+    userIndex[users[k].socket] = (int)k;
+  }
+}
+
+// [Task 5] 소켓을 닫기 전에 wire 통계를 챙겨둠
+void closeUserSocket(int sock) {
+  stats.segsClosed += tcpSegsOut(sock);
+  close(sock);
+}
+
+// [Task 8] 메시지 하나가 수신자 1명의 소켓에 넘어간 시점에 호출
+// 마지막 수신자였다면 팬아웃 완료 시간도 기록
+void recordHandoff(ChatMessage &m, long long now) {
+  if (!m.tracked)
+    return;
+  long long latency = now - m.ingressUs;
+  Room *room = findRoom(m.roomId); // 보낸 방이 그 사이 비었을 수 있음
+  RoomLatency *roomLatency = nullptr;
+  if (room) {
+    if (!room->latency)
+      room->latency = make_unique<RoomLatency>(); // 0으로 초기화
+    roomLatency = room->latency.get();
+    histogramRecord(roomLatency->delivery, latency);
+  }
+  histogramRecord(globalDeliveryLatency, latency);
+
+  if (--m.pendingRecipients == 0) {
+    if (roomLatency)
+      histogramRecord(roomLatency->fanout, latency);
+    histogramRecord(globalFanoutLatency, latency);
+  }
+}
+
+// [Task 8] 유저가 outbox를 다 못 받고 나갈 때: 그 몫만큼 남은 수신자 수를 줄임
+// (안 그러면 0이 안 돼서 팬아웃 표본이 영영 빠짐). 나간 유저가 마지막
+// 수신자였으면 팬아웃은 끝났지만 전달된 게 아니므로 지연 대신 abandoned로 셈
+void abandonOutbox(User &user) {
+  for (size_t k = 0; k < user.outbox.size(); ++k) {
+    ChatMessage &m = *user.outbox[k];
+    if (--m.pendingRecipients == 0 && m.tracked) {
+      Room *room = findRoom(m.roomId);
+      if (room)
+        room->abandonedFanouts++;
+      globalAbandonedFanouts++;
+    }
+  }
+  user.outbox.clear();
+}
+
+// [Task 5] 메시지 목록을 gathered write(sendmsg + iovec)로 한 번에 전송.
+// TCP_CORK를 켰다 끄는 setsockopt 2번 대신, 마지막 묶음 전까지는
+// MSG_MORE를 붙여서 커널이 작은 세그먼트를 바로 내보내지 않게 함.
+// [Task 8] trackFanout이면 묶음을 넘길 때마다 지연 기록 (히스토리 재생은 X)
+void sendGathered(int sock, const vector<Message> &msgs, bool trackFanout) {
+  size_t total = msgs.size();
+  size_t sent = 0;
+
+  while (sent < total) {
+    struct iovec iov[MAX_IOV];
+    int count = 0;
+    while (count < MAX_IOV && sent + count < total) {
+      const string &m = msgs[sent + count]->text;
+      iov[count].iov_base = (void *)m.data();
+      iov[count].iov_len = m.size();
+      ++count;
+    }
+
+    struct msghdr hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.msg_iov = iov;
+    hdr.msg_iovlen = count;
+
+    size_t wanted = 0;
+    for (int k = 0; k < count; ++k) {
+      wanted += iov[k].iov_len;
+    }
+    bool more = sent + count < total;
+    ssize_t written = sendmsg(sock, &hdr, MSG_NOSIGNAL | (more ? MSG_MORE : 0));
+    stats.writeCalls++;
+    recordWrite(written, wanted);
+
+    if (trackFanout) {
+      long long now = nowUs();
+      for (int k = 0; k < count; ++k) {
+        recordHandoff(*msgs[sent + k], now);
+      }
+    }
+    sent += count;
+  }
+
+  stats.delivered += total;
+}
+
+// [Task 5] 이번 틱에 쌓인 outbox 전송
+void flushOutbox(User &user) {
+  sendGathered(user.socket, user.outbox, true);
+  user.outbox.clear();
+}
+
+// [Task 6] 방에 들어온 유저에게 최근 대화를 한 번의 gathered write로 재생
+void replayHistory(User &user) {
+  vector<Message> backlog;
+  historyCollect(getRoom(user.roomId).history, backlog);
+  if (!backlog.empty()) {
+    sendGathered(user.socket, backlog, false);
+  }
+}
+
+// [Task 6] 모든 방의 히스토리 메모리 현황을 요청한 유저에게 전송
+void sendHistoryStats(int sock) {
+  string report = "[System] History rings:\n";
+  size_t totalMemory = 0;
+  size_t totalMessages = 0;
+  char line[160];
+
+  for (map<int, Room>::const_iterator it = rooms.begin(); it != rooms.end();
+       ++it) {
+    const HistoryRing &ring = it->second.history;
+    size_t memory = historyMemory(ring);
+    sprintf(line, "  Room %d: %zu/%zu msgs, %zu/%zu bytes, %zu bytes total\n",
+            it->first, ring.count, ring.slots.size(), ring.bytes,
+            ring.maxBytes, memory);
+    report += line;
+    totalMemory += memory;
+    totalMessages += ring.count;
+  }
+
+  sprintf(line, "  All rooms: %zu rooms, %zu msgs, %zu bytes\n", rooms.size(),
+          totalMessages, totalMemory);
+  report += line;
+  write(sock, report.data(), report.size());
+}
+
+// [Task 5] 지연 예산이 다 된 outbox만 비움 (force면 전부)
+void flushDueOutboxes(long long now, bool force) {
   for (auto &user : users) {
-    if (user.socket == sock)
-      return &user;
+    if (user.outbox.empty())
+      continue;
+    long long budgetUs = getRoom(user.roomId).flushBudgetMs * 1000LL;
+    if (force || now - user.outboxSince >= budgetUs) {
+      flushOutbox(user);
+    }
   }
-  return nullptr;
+}
+
+// [Task 5] 다음 flush 시각까지 남은 시간 (select 타임아웃 계산용, us)
+long long nextFlushDelayUs(long long now) {
+  long long delay = 1000000; // 최대 1초 (유령 검사 주기)
+  for (const auto &user : users) {
+    if (user.outbox.empty())
+      continue;
+    long long budgetUs = getRoom(user.roomId).flushBudgetMs * 1000LL;
+    long long remain = user.outboxSince + budgetUs - now;
+    if (remain < delay)
+      delay = remain < 0 ? 0 : remain;
+  }
+  return delay;
+}
+
+// [Task 5] syscalls/메시지, wire 세그먼트 수 리포트
+void printStats() {
+  long long segs = stats.segsClosed;
+  for (const auto &user : users) {
+    segs += tcpSegsOut(user.socket);
+  }
+  double perMsg =
+      stats.delivered ? (double)stats.writeCalls / stats.delivered : 0.0;
+  double segsPerMsg = stats.delivered ? (double)segs / stats.delivered : 0.0;
+
+  cout << "[Stats] mode=" << (useTickMode ? "tick" : "immediate")
+       << " delivered=" << stats.delivered << " writes=" << stats.writeCalls
+       << " writes/msg=" << perMsg << " segs_out=" << segs
+       << " segs/msg=" << segsPerMsg << endl;
+}
+
+// [Task 8] 지연 현황 보고서 (전체 + 방별)
+void sendLatencyStats(int sock) {
+  string report = "[System] Fan-out latency (ingress -> socket):\n";
+  report += "  All rooms delivery: " + histogramSummary(globalDeliveryLatency);
+  report += "\n  All rooms fan-out : " + histogramSummary(globalFanoutLatency);
+  report += " abandoned=" + to_string(globalAbandonedFanouts);
+  report += "\n";
+
+  static const RoomLatency none = {}; // 전달이 아직 없는 방
+  for (map<int, Room>::const_iterator it = rooms.begin(); it != rooms.end();
+       ++it) {
+    if (!it->second.latency && it->second.abandonedFanouts == 0)
+      continue;
+    const RoomLatency &h = it->second.latency ? *it->second.latency : none;
+    report += "  Room " + to_string(it->first) + " delivery: " +
+              histogramSummary(h.delivery);
+    report += "\n  Room " + to_string(it->first) + " fan-out : " +
+              histogramSummary(h.fanout);
+    report += " abandoned=" + to_string(it->second.abandonedFanouts);
+    report += "\n";
+  }
+  write(sock, report.data(), report.size());
+}
+
+// ============================================================
+// [Task 11] 공간 모드 (관심 영역 격자)
+// ============================================================
+
+// [Task 5] 수신자 1명에게: tick 모드면 outbox에 쌓고, 아니면 바로 write
+void deliverTo(User &user, const Message &shared, long long now) {
+  if (useTickMode) {
+    if (user.outbox.empty())
+      user.outboxSince = now;
+    user.outbox.push_back(shared);
+  } else {
+    const string &text = shared->text;
+    recordWrite(write(user.socket, text.data(), text.size()), text.size());
+    stats.writeCalls++;
+    stats.delivered++;
+    recordHandoff(*shared, nowUs());
+  }
+}
+
+// to에게 about이 시야에 들어왔다/나갔다고 알림
+// tick 모드면 outbox로 (아직 안 나간 채팅보다 먼저 도착하지 않게)
+void notifyAoi(int to, int about, bool entered) {
+  char line[64];
+  int len = snprintf(line, sizeof(line), "[AOI] User %d %s view\n", about,
+                     entered ? "entered" : "left");
+  chatMetrics.aoiEvents.inc();
+  User *user = useTickMode ? findUser(to) : nullptr;
+  if (!user) {
+    write(to, line, len);
+    return;
+  }
+  Message event = make_shared<ChatMessage>();
+  event->text.assign(line, len);
+  event->roomId = user->roomId;
+  event->ingressUs = 0;
+  event->pendingRecipients = 1;
+  event->tracked = false;
+  deliverTo(*user, event, nowUs());
+}
+
+// 방 격자 (공간 모드로 처음 들어올 때 만듦 - 칸 배열이 월드 크기만큼이라
+// 로비나 공간 모드를 안 쓰는 방까지 들고 있을 필요 없음)
+aoi::Grid &roomGrid(int roomId) {
+  Room &room = getRoom(roomId);
+  if (!room.grid)
+    room.grid = make_unique<aoi::Grid>(AOI_WORLD_SIZE, aoiRadius);
+  return *room.grid;
+}
+
+// 입장 위치: 월드 안 아무 데나 (모두 원점에 두면 한 칸에 몰려서 입장마다
+// 방 전체에 알림이 가고 격자가 팬아웃을 못 줄임)
+uint32_t aoiSpawnState = 2463534242u;
+float aoiSpawnCoord() {
+  aoiSpawnState ^= aoiSpawnState << 13;
+  aoiSpawnState ^= aoiSpawnState >> 17;
+  aoiSpawnState ^= aoiSpawnState << 5;
+  return (aoiSpawnState >> 8) * (AOI_WORLD_SIZE / 16777216.0f);
+}
+
+// 현재 방 격자에 넣음 - 서로 보이게 된 양쪽 모두에게 알림
+// 로비는 격자 없음 (접속할 때마다 로비 전체에 알림이 가지 않게)
+void aoiJoin(User &user) {
+  if (!useSpatialMode || user.roomId == 0)
+    return;
+  aoi::Grid &grid = roomGrid(user.roomId);
+  float x = aoiSpawnCoord();
+  float y = aoiSpawnCoord();
+  user.aoiId = grid.add(user.socket, x, y, [&](int other, bool entered) {
+    notifyAoi(user.socket, grid.tag(other), entered);
+    notifyAoi(grid.tag(other), user.socket, entered);
+  });
+}
+
+// 격자에서 뺌 - 나가는 쪽은 이미 닫혔을 수 있으므로 남는 쪽에게만 알림
+void aoiLeave(User &user) {
+  if (user.aoiId == -1)
+    return;
+  aoi::Grid &grid = roomGrid(user.roomId);
+  grid.remove(user.aoiId, [&](int other, bool entered) {
+    notifyAoi(grid.tag(other), user.socket, entered);
+  });
+  user.aoiId = -1;
 }
 
 // [Task 3] 같은 방에 있는 사람들에게만 전송
-void sendToRoom(int senderSock, char *msg, int len) {
+// [Task 11] 공간 모드면 같은 방 중에서도 주변 칸에 있는 사람에게만
+// [Task 8] ingressUs: 서버가 이 메시지를 read()로 받은 시각
+void sendToRoom(int senderSock, char *msg, int len, long long ingressUs) {
   User *sender = findUser(senderSock);
   if (!sender)
     return; // 유저를 못 찾으면 중단
 
+  // [Task 5] 메시지를 한 번만 만들고 수신자 outbox에 공유 포인터만 추가
+  // [Task 6] 같은 버퍼를 방 히스토리에도 그대로 보관
+  Message shared = make_shared<ChatMessage>();
+  shared->text.assign(msg, len);
+  shared->roomId = sender->roomId;
+  shared->ingressUs = ingressUs;
+  shared->pendingRecipients = 0;
+  shared->tracked = true;
+  historyPush(getRoom(sender->roomId).history, shared);
+
+  long long now = useTickMode ? nowUs() : 0;
+
+  // [Task 11] 공간 모드: 주변 칸을 돌면서 바로 전달 (방 전체를 훑지 않음)
+  if (sender->aoiId != -1) {
+    aoi::Grid &grid = roomGrid(sender->roomId);
+    shared->pendingRecipients = (int)grid.countNear(sender->aoiId);
+    grid.forEachNear(sender->aoiId, [&](int other) {
+      User *user = findUser(grid.tag(other));
+      if (user)
+        deliverTo(*user, shared, now);
+    });
+    return;
+  }
+
+  // 1. 나 자신에게는 보내지 않음
+  // 2. 나와 같은 방(roomId)에 있는 사람에게만 전송
+  auto isRecipient = [&](const User &user) {
+    return user.socket != senderSock && user.roomId == sender->roomId;
+  };
+
+  // [Task 8] 수신자 수를 먼저 세어 둬야 "마지막 수신자" 시점을 알 수 있음
   for (const auto &user : users) {
-    // 1. 나 자신에게는 보내지 않음
-    // 2. 나와 같은 방(roomId)에 있는 사람에게만 전송
-    if (user.socket != senderSock && user.roomId == sender->roomId) {
-      write(user.socket, msg, len);
-    }
+    if (isRecipient(user))
+      shared->pendingRecipients++;
   }
+  for (auto &user : users) {
+    if (isRecipient(user))
+      deliverTo(user, shared, now);
+  }
+}
+
+// ============================================================
+// [Task 7] 명령어 핸들러 (args: 명령어 이름 뒤의 나머지, 수신 버퍼를 가리킴)
+// ============================================================
+
+typedef void (*CommandHandler)(User &user, string_view args);
+
+void reply(User &user, const cmd::Reply &msg) {
+  write(user.socket, msg.data(), msg.size());
+}
+
+void replyText(User &user, string_view text) {
+  write(user.socket, text.data(), text.size());
+}
+
+// "/join <방번호>" : 해당 방으로 이동
+void onJoin(User &user, string_view args) {
+  int newRoomId = 0;
+  if (!cmd::nextNumber(args, newRoomId)) {
+    replyText(user, "[System] Usage: /join <number>\n");
+    return;
+  }
+
+  int oldRoom = user.roomId;
+  // [Task 6] 이전 방에서 쌓인 메시지가 새 방 히스토리보다
+  // 먼저 도착하도록 outbox부터 비움
+  if (!user.outbox.empty()) {
+    flushOutbox(user);
+  }
+  aoiLeave(user); // [Task 11] 예전 방 격자에서 빼고 새 방 격자에 넣음
+  // 새 방부터 들어간 뒤 예전 방에서 나감 (같은 방이면 안 지워지게)
+  enterRoom(user, newRoomId);
+  leaveRoom(oldRoom);
+
+  // 변경 알림
+  cmd::Reply msg;
+  msg << "[System] Moved from Room " << oldRoom << " to Room " << newRoomId
+      << "\n";
+  reply(user, msg);
+
+  // [Task 6] 최근 대화 재생
+  replayHistory(user);
+  aoiJoin(user);
+
+  alog::info("[Log] User {} moved to Room {}", user.socket, newRoomId);
 }
 
-int main() {
+// [Task 5] "/budget <ms>" : 현재 방의 지연 예산 변경
+void onBudget(User &user, string_view args) {
+  int budgetMs = 0;
+  if (!cmd::nextNumber(args, budgetMs) || budgetMs < 0) {
+    replyText(user, "[System] Usage: /budget <ms>\n");
+    return;
+  }
+  getRoom(user.roomId).flushBudgetMs = budgetMs;
+
+  cmd::Reply msg;
+  msg << "[System] Room " << user.roomId << " flush budget: " << budgetMs
+      << " ms\n";
+  reply(user, msg);
+}
+
+// [Task 6] "/history <count> <bytes>" : 현재 방의 히스토리 한도 변경
+void onHistory(User &user, string_view args) {
+  int capacity = 0;
+  size_t maxBytes = 0; // 부호 없는 파싱: 음수/넘침은 nextNumber가 거절
+  if (!cmd::nextNumber(args, capacity) || !cmd::nextNumber(args, maxBytes) ||
+      capacity < 0 || capacity > HISTORY_CAPACITY_LIMIT ||
+      maxBytes > HISTORY_MAX_BYTES_LIMIT) {
+    cmd::Reply usage;
+    usage << "[System] Usage: /history <count <= " << HISTORY_CAPACITY_LIMIT
+          << "> <bytes <= " << (long long)HISTORY_MAX_BYTES_LIMIT << ">\n";
+    reply(user, usage);
+    return;
+  }
+  historyResize(getRoom(user.roomId).history, capacity, maxBytes);
+
+  cmd::Reply msg;
+  msg << "[System] Room " << user.roomId << " history: " << capacity
+      << " msgs, " << (long long)maxBytes << " bytes\n";
+  reply(user, msg);
+}
+
+// [Task 6] "/rooms" : 모든 방의 히스토리 메모리 현황
+void onRooms(User &user, string_view) { sendHistoryStats(user.socket); }
+
+// [Task 8] "/latency" : 팬아웃 지연 히스토그램 (관리용)
+void onLatency(User &user, string_view) { sendLatencyStats(user.socket); }
+
+// [Task 11] "/move <x> <y>" : 방 격자 안 위치 변경 (칸이 바뀌면 입장/퇴장 알림)
+void onMove(User &user, string_view args) {
+  int x = 0, y = 0;
+  if (user.aoiId == -1) {
+    replyText(user, useSpatialMode ? "[System] Join a room first.\n"
+                                   : "[System] Spatial mode is off.\n");
+    return;
+  }
+  if (!cmd::nextNumber(args, x) || !cmd::nextNumber(args, y)) {
+    replyText(user, "[System] Usage: /move <x> <y>\n");
+    return;
+  }
+  aoi::Grid &grid = roomGrid(user.roomId);
+  grid.move(user.aoiId, (float)x, (float)y, [&](int other, bool entered) {
+    notifyAoi(user.socket, grid.tag(other), entered);
+    notifyAoi(grid.tag(other), user.socket, entered);
+  });
+}
+
+// [Task 7] 명령어 등록 - 새 명령어는 여기에 한 줄 추가
+constexpr cmd::Entry<CommandHandler> COMMANDS[] = {
+    {"join", onJoin},
+    {"budget", onBudget},
+    {"history", onHistory},
+    {"rooms", onRooms},
+    {"latency", onLatency},
+    {"move", onMove},
+};
+
+// 컴파일 타임에 충돌 없는 해시 테이블 생성 (실행 중 문자열 비교는 1번뿐)
+constexpr auto COMMAND_TABLE = cmd::makeTable(COMMANDS);
+
+void dispatchCommand(User &user, string_view line) {
+  string_view args;
+  string_view name = cmd::splitCommand(line, args);
+
+  CommandHandler handler = COMMAND_TABLE.find(name);
+  if (handler) {
+    handler(user, args);
+  } else {
+    replyText(user, "[System] Unknown command.\n");
+  }
+}
+
+int main(int argc, char *argv[]) {
+  // [Task 5] 실행 인자: ./ChatServer [tick <budget_ms>] [aoi <radius>]
+  //                               [--metrics-port N]
+  int metricsPort = 0;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "tick") == 0) {
+      useTickMode = true;
+      if (i + 1 < argc && isdigit((unsigned char)argv[i + 1][0])) {
+        defaultFlushBudgetMs = atoi(argv[++i]);
+      }
+    } else if (strcmp(argv[i], "aoi") == 0) {
+      useSpatialMode = true; // [Task 11]
+      if (i + 1 < argc && isdigit((unsigned char)argv[i + 1][0])) {
+        aoiRadius = (float)atof(argv[++i]);
+      }
+    } else if (strcmp(argv[i], "--metrics-port") == 0 && i + 1 < argc) {
+      metricsPort = atoi(argv[++i]); // [Task 10]
+    }
+  }
+
   // 1. [Task 1-1] 소켓 초기화 (대표 전화 개설)
   int serverSock = socket(PF_INET, SOCK_STREAM, 0);
   if (serverSock == -1) {
@@ -80,6 +874,22 @@ int main() {
 
   cout << "[System] 채팅 서버가 시작되었습니다 (Port: " << PORT << ")" << endl;
 
+  // [Task 9] 접속/입장/유령 로그는 레코드만 링에 쓰고 출력은 로거 스레드가
+  alog::start();
+  registerMetrics();
+
+  // [Task 10] 관리 포트 (127.0.0.1 전용, 같은 select 루프에서 응답)
+  int adminSock = -1;
+  if (metricsPort > 0) {
+    adminSock = metrics::createAdminListener(metricsPort);
+    if (adminSock == -1) {
+      perror("metrics admin port error");
+      return 1;
+    }
+    cout << "[System] 지표: http://127.0.0.1:" << metricsPort << "/metrics"
+         << endl;
+  }
+
   // 2. [Task 1-2] fd_set 초기화 (관제탑 세팅)
   fd_set reads;      // 감시 대상 목록 (원본)
   fd_set copy_reads; // 감시 대상 목록 (복사본 - select가 내용을 바꾸기 때문)
@@ -89,7 +899,26 @@ int main() {
 
   int maxFd = serverSock; // 감시 대상 중 가장 높은 번호 (select 함수에 필요)
 
+  // [Task 10] 관리 포트 연결은 채팅 유저와 구분해서 따로 표시
+  fd_set adminFds;
+  FD_ZERO(&adminFds);
+  if (adminSock != -1) {
+    FD_SET(adminSock, &reads);
+    maxFd = max(maxFd, adminSock);
+  }
+
   cout << "[System] 클라이언트 접속 대기 중 (Select Model)..." << endl;
+  if (useTickMode) {
+    cout << "[System] Tick 모드 (기본 지연 예산: " << defaultFlushBudgetMs
+         << "ms)" << endl;
+  }
+  if (useSpatialMode) {
+    cout << "[System] 공간 모드 (월드 " << AOI_WORLD_SIZE << ", 관심 반경 "
+         << aoiRadius << ")" << endl;
+  }
+
+  time_t lastStatsTime = time(NULL);
+  long long lastReportedDelivered = 0;
 
   while (true) {
     // [중요] 원본(reads)을 복사해서 사용해야 함!
@@ -102,6 +931,13 @@ int main() {
     timeout.tv_sec = 1;
     timeout.tv_usec = 0;
 
+    // [Task 5] Tick 모드면 가장 급한 outbox의 예산까지만 잠듦
+    if (useTickMode) {
+      long long delay = nextFlushDelayUs(nowUs());
+      timeout.tv_sec = delay / 1000000;
+      timeout.tv_usec = delay % 1000000;
+    }
+
     // 3. [Task 1-2] select 함수 호출 (감시 시작)
     // 첫 번째 인자: 감시할 소켓 번호의 최대값 + 1 (이유: 파일 디스크립터는
     // 0부터 시작하니까 개수는 +1) 두 번째 인자: 수신(Read) 이벤트를 감시할 목록
@@ -115,6 +951,7 @@ int main() {
     if (fdNum == 0) {
       // (타임아웃(0)이어도 아래 루프를 지나서 좀비 검사 로직으로 감)
     }
+    uint64_t iterationStart = metrics::nowNs(); // [Task 10]
 
     // 4. [Task 1-3] 변화가 생긴 소켓 찾기
     // 0번부터 maxFd번까지 모든 소켓을 전수 조사 (Loop)
@@ -123,6 +960,26 @@ int main() {
       // i번 소켓에 변화가 생겼는가? (체크박스가 켜져있는가?)
       if (FD_ISSET(i, &copy_reads)) {
 
+        // [Task 10] 관리 포트: 연결을 받아 감시 목록에 추가
+        if (i == adminSock) {
+          int adminClient =
+              accept4(adminSock, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+          if (adminClient != -1) {
+            FD_SET(adminClient, &reads);
+            FD_SET(adminClient, &adminFds);
+            maxFd = max(maxFd, adminClient);
+          }
+          continue;
+        }
+        // [Task 10] 관리 포트 요청 -> 지표 응답 후 닫음
+        if (FD_ISSET(i, &adminFds)) {
+          if (metrics::serveAdmin(i)) {
+            FD_CLR(i, &reads);
+            FD_CLR(i, &adminFds);
+          }
+          continue;
+        }
+
         // Case A: 대표 전화(serverSock)에 신호가 옴 -> "새 손님 입장!"
         if (i == serverSock) {
           struct sockaddr_in clientAddr;
@@ -147,9 +1004,13 @@ int main() {
           // [Task 4] 입장 시 현재 시간 기록
           User newUser;
           newUser.socket = clientSock;
-          newUser.roomId = 0;
+          enterRoom(newUser, 0); // 로비
           newUser.lastHeartbeat = time(NULL);
+          newUser.outboxSince = 0;
+          newUser.aoiId = -1;
           users.push_back(newUser);
+          reindexUsers(users.size() - 1); // [Task 11]
+          chatMetrics.accepts.inc();
 
           // 입장 메시지 알림 (옵션)
           const char *welcomeMsg =
@@ -160,18 +1021,29 @@ int main() {
         else {
           char buf[BUF_SIZE];
           int strLen = read(i, buf, BUF_SIZE); // i가 곧 소켓 번호
+          long long ingressUs = nowUs(); // [Task 8] 도착 시각 기록
 
           // 1) 연결 종료 (EOF)
-          if (strLen == 0) {
+          // [Task 11] 안 읽은 알림이 남은 채 닫으면 RST -> read()가 -1
+          if (strLen <= 0) {
+            // [Task 11] 주변 유저에게 퇴장 알림 (소켓 닫기 전에)
+            User *gone = findUser(i);
+            if (gone) {
+              aoiLeave(*gone);
+            }
+
             // 감시 목록에서 제거 (더 이상 이 소켓은 안 봄)
             FD_CLR(i, &reads);
-            close(i);
-            cout << "[System] 클라이언트 종료 (Socket: " << i << ")" << endl;
+            closeUserSocket(i);
+            chatMetrics.closesEof.inc();
+            alog::info("[System] 클라이언트 종료 (Socket: {})", i);
 
             // 벡터에서 삭제
             for (auto it = users.begin(); it != users.end(); ++it) {
               if (it->socket == i) {
-                users.erase(it);
+                abandonOutbox(*it); // [Task 8]
+                leaveRoom(it->roomId);
+                reindexUsers(users.erase(it) - users.begin()); // [Task 11]
                 break;
               }
             }
@@ -179,6 +1051,7 @@ int main() {
           // 2) 데이터 수신
           else {
             // [Task 4] 생존 신고! 시간 갱신
+            chatMetrics.bytesIn.add(strLen);
 
             User *u = findUser(i);
             if (u) {
@@ -188,41 +1061,30 @@ int main() {
             buf[strLen] = 0; // 문자열 끝 처리
             // [Task 3] 명령어 파싱
             // 메시지가 '/'로 시작하면 명령어로 처리
+            // [Task 7] 수신 버퍼 위의 string_view로 바로 테이블 조회
             if (buf[0] == '/') {
-              // "/join " 명령어 확인
-              if (strncmp(buf, "/join ", 6) == 0) {
-                int newRoomId = atoi(buf + 6); // 숫자 부분 파싱
-                User *u = findUser(i);
-                if (u) {
-                  int oldRoom = u->roomId;
-                  u->roomId = newRoomId;
-
-                  // 변경 알림
-                  char sysMsg[128];
-                  sprintf(sysMsg, "[System] Moved from Room %d to Room %d\n",
-                          oldRoom, newRoomId);
-                  write(i, sysMsg, strlen(sysMsg));
-
-                  cout << "[Log] User " << i << " moved to Room " << newRoomId
-                       << endl;
-                }
-              } else {
-                const char *errMsg = "[System] Unknown command.\n";
-                write(i, errMsg, strlen(errMsg));
+              if (u) {
+                dispatchCommand(*u, string_view(buf, strLen));
               }
             }
             // 일반 채팅
             else {
               // [Task 3] 같은 방 유저들에게만 전송
-              sendToRoom(i, buf, strLen);
+              sendToRoom(i, buf, strLen, ingressUs);
             }
           }
         }
       }
     }
 
+    // [Task 5] 이번 루프에서 예산이 다 된 outbox 전송 (예산 0이면 매 루프)
+    if (useTickMode) {
+      flushDueOutboxes(nowUs(), false);
+    }
+
     // 2. [Task 4] 유령 잡기 (좀비 프로세스 정리)
     time_t now = time(NULL);
+    long long outboxMessages = 0; // [Task 10] 큐 깊이 (순회하는 김에 합산)
     // 반복자(iterator)를 직접 제어하며 삭제
     for (auto it = users.begin(); it != users.end();) {
       double gap = difftime(now, it->lastHeartbeat);
@@ -231,22 +1093,49 @@ int main() {
         // 타임아웃 발생! 강제 퇴장
         int targetSock = it->socket;
 
-        cout << "[System] 유령 유저 감지! (Socket: " << targetSock << ", "
-             << (int)gap << "초간 무응답) -> 강제 종료" << endl;
+        alog::info("[System] 유령 유저 감지! (Socket: {}, {}초간 무응답) -> 강제 종료",
+                   targetSock, (int)gap);
 
         // 소켓 닫고 감시 목록에서 제외
-        close(targetSock);
+        aoiLeave(*it); // [Task 11]
+        closeUserSocket(targetSock);
         FD_CLR(targetSock, &reads);
+        chatMetrics.closesHeartbeat.inc();
 
         // 벡터에서 삭제하고, 반복자는 다음 요소를 가리키게 함
+        abandonOutbox(*it); // [Task 8]
+        leaveRoom(it->roomId);
         it = users.erase(it);
+        reindexUsers(it - users.begin()); // [Task 11]
       } else {
         // 생존자는 다음으로 넘어감
+        outboxMessages += it->outbox.size();
         ++it;
       }
     }
+
+    // [Task 10] 깨어난 한 번의 처리 시간 + 준비된 소켓 수 + 현재 상태
+    chatMetrics.loopIterationNs.record(metrics::nowNs() - iterationStart);
+    if (fdNum > 0) {
+      chatMetrics.readyPerSelect.record(fdNum);
+    }
+    chatMetrics.users.set(users.size());
+    chatMetrics.outboxMessages.set(outboxMessages);
+
+    // [Task 5] 주기적으로 전송 통계 출력 (새로 전달된 게 있을 때만)
+    if (difftime(now, lastStatsTime) >= STATS_INTERVAL) {
+      if (stats.delivered != lastReportedDelivered) {
+        printStats();
+        lastReportedDelivered = stats.delivered;
+      }
+      lastStatsTime = now;
+    }
   }
 
   close(serverSock);
+  if (adminSock != -1) {
+    close(adminSock);
+  }
+  alog::stop();
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,59 @@
+require 'socket'
+
+# 브로드캐스트 부하 테스트 (immediate vs tick 모드 비교용)
+# 사용법: ruby test_broadcast.rb [clients] [messages_per_client]
+#
+# 1) ./ChatServer            -> 실행 후 이 스크립트 -> 서버의 [Stats] 확인
+# 2) ./ChatServer tick 2     -> 다시 실행 -> writes/msg, segs/msg 비교
+
+HOST = '127.0.0.1'
+PORT = 9000
+CLIENT_COUNT = (ARGV[0] || 20).to_i
+MESSAGES_PER_CLIENT = (ARGV[1] || 200).to_i
+ROOM = 1
+
+sockets = CLIENT_COUNT.times.map do
+  socket = TCPSocket.new(HOST, PORT)
+  socket.recv(1024) # 환영 메시지
+  socket.write("/join #{ROOM}")
+  socket.recv(1024) # 방 이동 메시지
+  socket
+end
+
+puts "[*] #{CLIENT_COUNT} clients joined Room #{ROOM}"
+
+# 수신 스레드: 받은 바이트 수만 셈
+received = Array.new(CLIENT_COUNT, 0)
+readers = sockets.each_with_index.map do |socket, i|
+  Thread.new do
+    loop do
+      data = socket.recv(65536)
+      break if data.nil? || data.empty?
+      received[i] += data.bytesize
+    end
+  rescue IOError, Errno::ECONNRESET
+    # 종료
+  end
+end
+
+start_time = Time.now
+
+# 송신: 모든 클라이언트가 번갈아 가며 짧은 채팅을 보냄
+MESSAGES_PER_CLIENT.times do |j|
+  sockets.each_with_index do |socket, i|
+    socket.write("c#{i} m#{j}\n")
+  end
+  sleep(0.001)
+end
+
+sleep(1.0) # 남은 메시지 수신 대기
+elapsed = Time.now - start_time
+
+expected_msgs = CLIENT_COUNT * MESSAGES_PER_CLIENT * (CLIENT_COUNT - 1)
+puts "[*] Elapsed: #{elapsed.round(2)} sec"
+puts "[*] Expected deliveries: #{expected_msgs}"
+puts "[*] Bytes received: #{received.sum}"
+puts "[*] Check the server's [Stats] line for writes/msg and segs/msg."
+
+sockets.each(&:close)
+readers.each(&:join)
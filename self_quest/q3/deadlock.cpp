@@ -3,16 +3,20 @@
 #include <mutex>
 #include <chrono> // sleep_for 사용
 
+#include "profiled_mutex.h" // [Task 7] -DLOCKPROF 로 빌드하면 잠금 순서 검사
+
 using namespace std;
 
 // 두 개의 자원(자물쇠) 준비
-mutex mtxA;
-mutex mtxB;
+// (ProfiledMutex: 평소에는 std::mutex 그대로, -DLOCKPROF 면 프로파일링)
+using lockprof::ProfiledMutex;
+ProfiledMutex mtxA("A");
+ProfiledMutex mtxB("B");
 
 // [Worker 1] A를 먼저 잡고, B를 원함
 void worker1() {
     cout << "[Worker1] 자원 A 획득 시도..." << endl;
-    lock_guard<mutex> lockA(mtxA); // A 잠금
+    lock_guard<ProfiledMutex> lockA(mtxA); // A 잠금
     cout << "[Worker1] 자원 A 획득 성공! (작업 중...)" << endl;
 
     // [중요] 데드락을 유발하기 위한 강제 지연
@@ -21,7 +25,7 @@ void worker1() {
 
     cout << "[Worker1] 자원 B 획득 대기 중..." << endl;
     // 여기서 멈춤! (Worker2가 B를 놓아줄 때까지)
-    lock_guard<mutex> lockB(mtxB); 
+    lock_guard<ProfiledMutex> lockB(mtxB); 
     
     cout << "[Worker1] 자원 B 획득 성공! (이 메시지는 영원히 볼 수 없을 것입니다)" << endl;
 }
@@ -29,7 +33,7 @@ void worker1() {
 // [Worker 2] B를 먼저 잡고, A를 원함 (잠금 순서가 Worker1과 반대!)
 void worker2() {
     cout << "[Worker2] 자원 B 획득 시도..." << endl;
-    lock_guard<mutex> lockB(mtxB); // B 잠금
+    lock_guard<ProfiledMutex> lockB(mtxB); // B 잠금
     cout << "[Worker2] 자원 B 획득 성공! (작업 중...)" << endl;
 
     // Worker1이 A를 잡을 시간을 줌
@@ -37,7 +41,7 @@ void worker2() {
 
     cout << "[Worker2] 자원 A 획득 대기 중..." << endl;
     // 여기서 멈춤! (Worker1이 A를 놓아줄 때까지)
-    lock_guard<mutex> lockA(mtxA);
+    lock_guard<ProfiledMutex> lockA(mtxA);
 
     cout << "[Worker2] 자원 A 획득 성공! (이 메시지는 영원히 볼 수 없을 것입니다)" << endl;
 }
@@ -45,6 +49,8 @@ void worker2() {
 int main() {
     cout << "=== 데드락(Deadlock) 시뮬레이션 시작 ===" << endl;
     cout << "두 스레드가 서로를 기다리며 영원히 멈추는지 확인하세요.\n" << endl;
+    // [Task 7] -DLOCKPROF 빌드: Worker2가 A를 기다리기 직전에
+    // "[lockprof] potential deadlock: B -> A -> B" 경고가 먼저 찍힘
 
     thread t1(worker1);
     thread t2(worker2);
@@ -0,0 +1,286 @@
+/**
+ * [Task 10] 에포크 기반 메모리 회수 (헤더 전용, C++17)
+ *
+ *   ebr::Domain domain;                      // 보호할 자료구조마다 하나
+ *   ebr::Reader *me = domain.attach();       // 읽는 스레드마다 한 번
+ *
+ *   // 읽기 (락 X, 원자적 RMW X, 펜스 X)
+ *   {
+ *     ebr::ReadGuard guard(*me);
+ *     const Members *m = published.load(std::memory_order_acquire);
+ *     ... m을 마음껏 읽음 (guard가 살아 있는 동안 해제되지 않음) ...
+ *   }
+ *
+ *   // 쓰기 (쓰는 쪽끼리는 알아서 직렬화)
+ *   const Members *old = published.exchange(fresh, std::memory_order_acq_rel);
+ *   domain.retire(old);                      // 바로 delete 하지 않고 미룸
+ *
+ * 읽는 쪽은 들어갈 때 "지금 에포크"를 자기 칸에 적고, 나올 때 0을 적는다 (둘 다
+ * 자기 캐시 라인에 일반 store). 회수는 쓰는 쪽이 몰아서:
+ *   1) 전역 에포크를 E -> E+1
+ *   2) 무거운 배리어 (membarrier) - 모든 읽는 스레드에 펜스를 대신 쳐 줌
+ *   3) 읽는 중인 스레드의 에포크 최솟값 min을 구함 -> min보다 작은 에포크에
+ *      retire된 객체는 아무도 볼 수 없음 (그 뒤에 들어온 읽기는 새 포인터를 봄)
+ *
+ * - 읽기 쪽 순서 보장(에포크 기록 -> 포인터 읽기)에 원래는 seq_cst 펜스가
+ *   필요한데, 이를 쓰는 쪽의 membarrier(MEMBARRIER_CMD_PRIVATE_EXPEDITED)로
+ *   옮김 (비대칭 펜스, liburcu의 memb 방식). 커널이 지원하지 않으면 양쪽 다
+ *   seq_cst 펜스로 대체
+ * - 회수는 retire가 RECLAIM_BATCH개 쌓일 때마다 한 번 (membarrier ~0.3us +
+ *   읽는 스레드 칸 훑기) -> 쓰기 하나당 비용을 나눠 냄. 기다리지 않음
+ *   (아직 못 지운 건 다음 회수로). 끝까지 기다리려면 synchronize()
+ * - 읽기 구역 안에서 오래 잠들면 그동안 회수가 멈춤 (메모리만 늘고 안전성은
+ *   그대로). pending()으로 밀린 개수 확인
+ * - 중첩 ReadGuard 허용 (바깥 것만 에포크를 기록)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <linux/membarrier.h>
+#include <mutex>
+#include <stdexcept>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "per_cpu.h" // percpu::CACHE_LINE
+
+namespace ebr {
+
+using percpu::CACHE_LINE;
+
+const int MAX_READERS = 128;
+const size_t RECLAIM_BATCH = 64; // retire 몇 개마다 회수를 시도하나
+
+/**
+ * 읽는 스레드 하나의 칸 (attach로 받고 그 스레드만 씀)
+ */
+struct alignas(CACHE_LINE) Reader {
+  std::atomic<uint64_t> epoch{0}; // 0: 읽는 중 아님
+  int depth = 0;                  // 중첩 ReadGuard 수 (주인 스레드만)
+  std::atomic<bool> used{false};
+  class Domain *domain = nullptr;
+};
+
+class Domain {
+public:
+  Domain() {
+    // 등록에 실패하면 (오래된 커널, seccomp) 읽는 쪽도 펜스를 침
+    asymmetric_ =
+        syscall(__NR_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED,
+                0, 0) == 0;
+  }
+
+  // 읽는 스레드가 모두 detach 한 뒤에 파괴할 것
+  ~Domain() {
+    for (Retired &r : limbo_) {
+      r.deleter(r.ptr);
+    }
+  }
+
+  Domain(const Domain &) = delete;
+  Domain &operator=(const Domain &) = delete;
+
+  Reader *attach() {
+    for (int i = 0; i < MAX_READERS; i++) {
+      bool expected = false;
+      if (!readers_[i].used.load(std::memory_order_relaxed) &&
+          readers_[i].used.compare_exchange_strong(expected, true)) {
+        readers_[i].epoch.store(0, std::memory_order_relaxed);
+        readers_[i].depth = 0;
+        readers_[i].domain = this;
+        int top = readerCount_.load(std::memory_order_relaxed);
+        while (top < i + 1 && !readerCount_.compare_exchange_weak(top, i + 1)) {
+        }
+        return &readers_[i];
+      }
+    }
+    throw std::runtime_error("ebr: too many readers");
+  }
+
+  void detach(Reader *reader) {
+    reader->epoch.store(0, std::memory_order_release);
+    reader->used.store(false, std::memory_order_release);
+  }
+
+  // ==========================================
+  // 읽는 쪽 (ReadGuard가 부름)
+  // ==========================================
+  void enter(Reader &reader) {
+    if (reader.depth++ > 0) {
+      return;
+    }
+    reader.epoch.store(epoch_.load(std::memory_order_acquire),
+                       std::memory_order_relaxed);
+    lightBarrier(); // 에포크 기록 -> 이후의 포인터 읽기
+  }
+
+  void exit(Reader &reader) {
+    if (--reader.depth > 0) {
+      return;
+    }
+    // release: 구역 안의 읽기가 "다 읽었음" 기록보다 먼저
+    reader.epoch.store(0, std::memory_order_release);
+  }
+
+  // ==========================================
+  // 쓰는 쪽
+  // ==========================================
+  /**
+   * 이미 공개 포인터에서 떼어낸 객체를 나중에 delete
+   * (RECLAIM_BATCH개마다 회수 시도)
+   */
+  template <typename T> void retire(const T *ptr) {
+    if (ptr == nullptr) {
+      return;
+    }
+    std::lock_guard<std::mutex> guard(lock_);
+    limbo_.push_back({epoch_.load(std::memory_order_relaxed),
+                      const_cast<T *>(ptr), &deleteAs<T>});
+    retired_++;
+    if (limbo_.size() - lastPending_ >= RECLAIM_BATCH) {
+      reclaimLocked();
+    }
+  }
+
+  /**
+   * 지금 지울 수 있는 것만 지움 (기다리지 않음)
+   * @return 이번에 지운 개수
+   */
+  size_t reclaim() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return reclaimLocked();
+  }
+
+  /**
+   * 지금까지 retire된 것을 전부 지울 때까지 기다림 (그 전부터 읽는 중이던
+   * 스레드가 구역을 나올 때까지). 읽기 구역 안에서 부르면 영원히 기다림
+   */
+  void synchronize() {
+    std::lock_guard<std::mutex> guard(lock_);
+    // 회수할 때마다 에포크가 전진하므로, 새로 들어오는 읽기는 막지 않음
+    while (reclaimLocked(), !limbo_.empty()) {
+      std::this_thread::yield();
+    }
+  }
+
+  // 통계 (쓰는 쪽 락 안에서 읽음)
+  uint64_t retired() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return retired_;
+  }
+  uint64_t freed() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return freed_;
+  }
+  size_t pending() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return limbo_.size();
+  }
+  size_t maxPending() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return maxPending_;
+  }
+  bool asymmetric() const { return asymmetric_; }
+
+private:
+  struct Retired {
+    uint64_t epoch; // retire 당시의 전역 에포크
+    void *ptr;
+    void (*deleter)(void *);
+  };
+
+  template <typename T> static void deleteAs(void *ptr) {
+    delete static_cast<T *>(ptr);
+  }
+
+  void lightBarrier() {
+    if (asymmetric_) {
+      std::atomic_signal_fence(std::memory_order_seq_cst); // 컴파일러만
+    } else {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+  }
+
+  void heavyBarrier() {
+    if (asymmetric_) {
+      syscall(__NR_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+    } else {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+  }
+
+  // 읽는 중인 스레드의 가장 오래된 에포크 (아무도 없으면 UINT64_MAX)
+  uint64_t minActiveEpoch() {
+    uint64_t minEpoch = UINT64_MAX;
+    int count = readerCount_.load(std::memory_order_acquire);
+    for (int i = 0; i < count; i++) {
+      uint64_t e = readers_[i].epoch.load(std::memory_order_acquire);
+      if (e != 0) {
+        minEpoch = std::min(minEpoch, e);
+      }
+    }
+    return minEpoch;
+  }
+
+  size_t reclaimLocked() {
+    maxPending_ = std::max(maxPending_, limbo_.size());
+    // 1) 에포크 전진: 이후에 들어오는 읽기는 E+1 이상을 기록
+    epoch_.fetch_add(1, std::memory_order_acq_rel);
+    // 2) 에포크 기록이 아직 안 보이는 읽기는, 이 배리어 뒤에 포인터를 읽으므로
+    //    이미 떼어낸 객체를 볼 수 없음
+    heavyBarrier();
+    // 3) 남은 읽기 중 가장 오래된 것보다 앞서 retire된 것만 지움
+    uint64_t minEpoch = minActiveEpoch();
+    size_t kept = 0;
+    size_t before = limbo_.size();
+    for (size_t i = 0; i < limbo_.size(); i++) {
+      if (limbo_[i].epoch < minEpoch) {
+        limbo_[i].deleter(limbo_[i].ptr);
+      } else {
+        limbo_[kept++] = limbo_[i];
+      }
+    }
+    limbo_.resize(kept);
+    lastPending_ = kept;
+    freed_ += before - kept;
+    return before - kept;
+  }
+
+  // 읽는 쪽이 매번 읽는 값 -> 쓰는 쪽 필드와 다른 캐시 라인
+  alignas(CACHE_LINE) std::atomic<uint64_t> epoch_{1};
+  std::atomic<int> readerCount_{0}; // 쓴 적 있는 칸 수 (훑을 범위)
+  bool asymmetric_ = false;
+
+  alignas(CACHE_LINE) std::mutex lock_;
+  std::vector<Retired> limbo_;
+  size_t lastPending_ = 0; // 지난 회수 때 못 지운 개수
+  size_t maxPending_ = 0;
+  uint64_t retired_ = 0;
+  uint64_t freed_ = 0;
+
+  Reader readers_[MAX_READERS];
+};
+
+/**
+ * 읽기 구역 (스코프 동안 이 스레드가 읽은 포인터는 해제되지 않음)
+ */
+class ReadGuard {
+public:
+  explicit ReadGuard(Reader &reader) : reader_(reader) {
+    reader_.domain->enter(reader_);
+  }
+  ~ReadGuard() { reader_.domain->exit(reader_); }
+
+  ReadGuard(const ReadGuard &) = delete;
+  ReadGuard &operator=(const ReadGuard &) = delete;
+
+private:
+  Reader &reader_;
+};
+
+} // namespace ebr
@@ -0,0 +1,210 @@
+/**
+ * [Task 6] False Sharing 탐지 + 패딩 효과 벤치마크
+ *
+ * 스레드마다 "자기 것만" 증가시키는데도, 그 변수들이 같은 캐시 라인에 있으면
+ * 코어끼리 라인을 주고받느라(ping-pong) 느려진다. 코드에는 공유가 안 보여서
+ * 눈치채기 어렵다.
+ *
+ * 1) 간격(stride) 훑기: 스레드 t의 카운터를 버퍼[t * stride]에 두고
+ *    8, 16, 32, ... 256바이트 간격별로 연산당 시간을 잰다. 빨라지는 첫 간격
+ *    = 이 머신에서 false sharing을 피하는 데 필요한 간격 (보통 64, 인접 라인
+ *    프리페치가 있으면 128).
+ * 2) 레이아웃 비교: packed(8바이트 간격) vs padded(캐시 라인) vs
+ *    percpu::ShardedCounter vs 공유 atomic 하나.
+ *
+ * 스레드는 서로 다른 CPU에 고정한다 (코어가 1개면 같은 코어에서 번갈아
+ * 돌 뿐이라 차이가 안 보임 -> 결과에 코어 수를 같이 출력).
+ *
+ * 컴파일: g++ -o false_sharing_bench false_sharing_bench.cpp -std=c++17 -O2 -pthread
+ * 실행: ./false_sharing_bench [threads] [ops_per_thread]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <pthread.h>
+#include <thread>
+#include <vector>
+
+#include "per_cpu.h" // [Task 6] PerCpu / ShardedCounter
+
+using namespace std;
+using namespace std::chrono;
+
+const int MAX_STRIDE = 256;
+
+void pin_to_cpu(int cpu) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+// 스레드 수만큼 동시에 body(t)를 돌리고 스레드당 연산 1회 평균 시간(ns)
+template <class Body> double run_threads(int threads, long long ops, Body body) {
+  int cpus = (int)thread::hardware_concurrency();
+  atomic<int> ready(0);
+  atomic<bool> go(false);
+  vector<thread> workers;
+  vector<double> elapsed_ns(threads);
+
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t]() {
+      pin_to_cpu(t % max(cpus, 1));
+      ready.fetch_add(1);
+      while (!go.load(memory_order_acquire)) {
+      }
+      auto start = steady_clock::now();
+      body(t, ops);
+      duration<double, nano> d = steady_clock::now() - start;
+      elapsed_ns[t] = d.count();
+    });
+  }
+  while (ready.load() < threads) {
+    this_thread::yield();
+  }
+  go.store(true, memory_order_release);
+  for (auto &w : workers) {
+    w.join();
+  }
+  // 가장 늦게 끝난 스레드 기준
+  return *max_element(elapsed_ns.begin(), elapsed_ns.end()) / ops;
+}
+
+// 단일 작성자 증가 (컴파일러가 루프를 합치지 못하게 atomic relaxed load/store)
+inline void bump(atomic<long long> &cell) {
+  cell.store(cell.load(memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+// 스레드 t의 카운터 = buffer + t * stride
+double run_stride(int threads, long long ops, size_t stride) {
+  size_t bytes = stride * threads + MAX_STRIDE;
+  void *memory = nullptr;
+  if (posix_memalign(&memory, MAX_STRIDE, bytes) != 0) {
+    return 0;
+  }
+  memset(memory, 0, bytes);
+  char *base = static_cast<char *>(memory);
+
+  double ns = run_threads(threads, ops, [&](int t, long long n) {
+    atomic<long long> &cell =
+        *reinterpret_cast<atomic<long long> *>(base + t * stride);
+    for (long long i = 0; i < n; ++i) {
+      bump(cell);
+    }
+  });
+  free(memory);
+  return ns;
+}
+
+// ==========================================
+// 레이아웃별 카운터
+// ==========================================
+
+struct PackedSlot {
+  atomic<long long> value;
+};
+
+struct alignas(percpu::CACHE_LINE) PaddedSlot {
+  atomic<long long> value;
+};
+
+template <class Slot> double run_layout(int threads, long long ops) {
+  vector<Slot> slots(threads);
+  for (auto &s : slots) {
+    s.value.store(0);
+  }
+  return run_threads(threads, ops, [&](int t, long long n) {
+    for (long long i = 0; i < n; ++i) {
+      bump(slots[t].value);
+    }
+  });
+}
+
+double run_percpu(int threads, long long ops, long long &total) {
+  percpu::ShardedCounter counter;
+  double ns = run_threads(threads, ops, [&](int, long long n) {
+    for (long long i = 0; i < n; ++i) {
+      counter.add();
+    }
+  });
+  total = counter.read();
+  return ns;
+}
+
+double run_shared_atomic(int threads, long long ops, long long &total) {
+  alignas(percpu::CACHE_LINE) atomic<long long> counter(0);
+  double ns = run_threads(threads, ops, [&](int, long long n) {
+    for (long long i = 0; i < n; ++i) {
+      counter.fetch_add(1, memory_order_relaxed);
+    }
+  });
+  total = counter.load();
+  return ns;
+}
+
+int main(int argc, char *argv[]) {
+  int threads = (int)thread::hardware_concurrency();
+  long long ops = 20000000;
+  if (argc >= 2) {
+    threads = atoi(argv[1]);
+  }
+  if (argc >= 3) {
+    ops = atoll(argv[2]);
+  }
+  if (threads < 2) {
+    threads = 2; // 혼자서는 false sharing이 생길 수 없음
+  }
+
+  cout << "=== False Sharing (스레드 " << threads << "개 x " << ops
+       << "회, 코어 " << thread::hardware_concurrency()
+       << "개, CACHE_LINE=" << percpu::CACHE_LINE << ") ===" << endl;
+  if ((int)thread::hardware_concurrency() < threads) {
+    cout << "[!] 코어보다 스레드가 많음: 같은 코어에서 번갈아 돌아서 "
+            "라인 핑퐁이 거의 안 보임"
+         << endl;
+  }
+
+  // 1) 간격 훑기 -> 빨라지는 첫 간격 찾기
+  cout << "\n[1] stride sweep (ns/op)" << endl;
+  vector<pair<size_t, double>> sweep;
+  for (size_t stride = sizeof(long long); stride <= (size_t)MAX_STRIDE;
+       stride *= 2) {
+    double ns = run_stride(threads, ops, stride);
+    sweep.push_back(make_pair(stride, ns));
+    cout << "  stride " << stride << "B : " << ns << endl;
+  }
+  double best = sweep[0].second;
+  for (auto &s : sweep) {
+    best = min(best, s.second);
+  }
+  if ((int)thread::hardware_concurrency() < threads) {
+    cout << "  -> 판정 불가 (스레드가 동시에 돌지 않음)" << endl;
+  } else {
+    for (auto &s : sweep) {
+      if (s.second <= best * 1.1) {
+        cout << "  -> false sharing 없는 최소 간격: " << s.first
+             << "B (최고 대비 10% 이내)" << endl;
+        break;
+      }
+    }
+  }
+
+  // 2) 레이아웃 비교
+  long long percpu_total = 0;
+  long long shared_total = 0;
+  cout << "\n[2] layouts (ns/op)" << endl;
+  cout << "  packed (8B 간격)       : " << run_layout<PackedSlot>(threads, ops)
+       << endl;
+  cout << "  padded (캐시 라인)     : " << run_layout<PaddedSlot>(threads, ops)
+       << endl;
+  cout << "  percpu ShardedCounter  : " << run_percpu(threads, ops, percpu_total)
+       << " (total=" << percpu_total << ")" << endl;
+  cout << "  shared atomic fetch_add: "
+       << run_shared_atomic(threads, ops, shared_total)
+       << " (total=" << shared_total << ")" << endl;
+  return 0;
+}
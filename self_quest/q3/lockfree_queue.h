@@ -0,0 +1,477 @@
+/**
+ * [Task 8] 유한 크기 lock-free 큐 (헤더 전용, C++17)
+ *
+ *   lfq::SpscQueue<Job> toLogic(4096);   // I/O 스레드 1개 -> 로직 스레드
+ *   lfq::MpscQueue<Job> inbox(4096);     // I/O 스레드 여러 개 -> 로직 스레드
+ *   lfq::EventfdWait wakeup;             // 로직 스레드가 epoll에서 잠듦
+ *
+ *   // 생산자
+ *   if (!inbox.tryPush(job)) { ... 가득 참: 버리거나 재시도 ... }
+ *   wakeup.notify();                     // 소비자가 잠들어 있을 때만 write
+ *
+ *   // 소비자 (epoll 루프)
+ *   Job batch[64];
+ *   size_t n = inbox.tryPopBatch(batch, 64);
+ *
+ * - SpscQueue: Lamport 링 버퍼. head(소비자만 씀) / tail(생산자만 씀)을 다른
+ *   캐시 라인에 두고, 상대 인덱스를 자기 쪽에 캐시 -> 큐가 비거나 차 보일
+ *   때만 상대 라인을 읽음 (평소에는 코어 간 전송 없음)
+ * - MpscQueue: Vyukov 방식. 칸마다 sequence 번호가 있어서 생산자는 tail을 CAS로
+ *   한 칸 차지 -> 데이터 기록 -> sequence 공개. 소비자는 하나라서 head는 CAS
+ *   없이 일반 변수
+ * - 둘 다 용량은 2의 거듭제곱으로 올림 (인덱스 & mask), 생성 후 크기 고정
+ *   -> 핫 패스에 할당 없음. 가득 차면 tryPush가 false (배압은 호출자가 결정)
+ * - 배치: tryPushBatch / tryPopBatch 는 인덱스 공개(release store)를 한 번만
+ *   -> 원소당 원자적 연산 비용을 나눠 냄 (MPSC 소비자는 칸마다 sequence 갱신)
+ *
+ * 대기 전략 (큐가 비었을 때 소비자가 기다리는 방법):
+ *   SpinWait    : pause로 돌다가 1024번마다 yield (sync_bench.cpp와 같음)
+ *   YieldWait   : 확인 실패마다 yield
+ *   FutexWait   : 잠깐 돌다가 futex로 잠듦. 생산자는 잠든 소비자가 있을 때만
+ *                 FUTEX_WAKE (없으면 fence + load 한 번)
+ *   EventfdWait : FutexWait와 같은 약속을 eventfd로 -> fd()를 epoll에 등록하면
+ *                 소켓 이벤트와 큐 도착을 epoll_wait 하나로 기다림
+ *
+ * 잠들기 직전에 "나 잔다"를 알리고(seq_cst) 큐를 한 번 더 확인해야, 생산자가
+ * 그 사이에 넣은 원소를 놓치지 않는다 (생산자: push -> fence -> 잠든 사람 확인).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <linux/futex.h>
+#include <memory>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+#include "per_cpu.h" // percpu::CACHE_LINE
+
+namespace lfq {
+
+using percpu::CACHE_LINE;
+
+const int SPINS_BEFORE_YIELD = 1024;
+const int SPINS_BEFORE_SLEEP = 256; // 잠들기 전에 돌아 보는 횟수 (futex/eventfd)
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+inline size_t roundUpPow2(size_t n) {
+  size_t cap = 2;
+  while (cap < n) {
+    cap <<= 1;
+  }
+  return cap;
+}
+
+// ==========================================
+// SPSC: Lamport 링 + 인덱스 캐시
+// ==========================================
+
+/**
+ * 생산자 스레드 1개, 소비자 스레드 1개. 인덱스는 계속 증가만 하고 (랩어라운드는
+ * size_t 오버플로까지 없음) 칸 번호는 & mask_.
+ * T는 기본 생성 + 이동 대입 가능해야 함 (칸을 미리 만들어 둠)
+ */
+template <class T> class SpscQueue {
+public:
+  explicit SpscQueue(size_t capacity)
+      : mask_(roundUpPow2(capacity) - 1), slots_(new T[mask_ + 1]) {}
+
+  SpscQueue(const SpscQueue &) = delete;
+  SpscQueue &operator=(const SpscQueue &) = delete;
+
+  size_t capacity() const { return mask_ + 1; }
+
+  // ---- 생산자 스레드 전용 ----
+
+  bool tryPush(T item) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cachedHead_ > mask_) {
+      cachedHead_ = head_.load(std::memory_order_acquire);
+      if (tail - cachedHead_ > mask_) {
+        return false; // 가득 참
+      }
+    }
+    slots_[tail & mask_] = std::move(item);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // 넣은 개수를 돌려줌 (빈 칸이 모자라면 앞에서부터 들어가는 만큼만)
+  size_t tryPushBatch(T *items, size_t count) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    size_t room = capacity() - (tail - cachedHead_);
+    if (room < count) {
+      cachedHead_ = head_.load(std::memory_order_acquire);
+      room = capacity() - (tail - cachedHead_);
+    }
+    size_t n = count < room ? count : room;
+    for (size_t i = 0; i < n; i++) {
+      slots_[(tail + i) & mask_] = std::move(items[i]);
+    }
+    if (n > 0) {
+      tail_.store(tail + n, std::memory_order_release);
+    }
+    return n;
+  }
+
+  // ---- 소비자 스레드 전용 ----
+
+  bool tryPop(T &out) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == cachedTail_) {
+      cachedTail_ = tail_.load(std::memory_order_acquire);
+      if (head == cachedTail_) {
+        return false; // 비었음
+      }
+    }
+    out = std::move(slots_[head & mask_]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  size_t tryPopBatch(T *out, size_t max) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t ready = cachedTail_ - head;
+    if (ready < max) {
+      cachedTail_ = tail_.load(std::memory_order_acquire);
+      ready = cachedTail_ - head;
+    }
+    size_t n = max < ready ? max : ready;
+    for (size_t i = 0; i < n; i++) {
+      out[i] = std::move(slots_[(head + i) & mask_]);
+    }
+    if (n > 0) {
+      head_.store(head + n, std::memory_order_release);
+    }
+    return n;
+  }
+
+  bool empty() {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head != cachedTail_) {
+      return false;
+    }
+    cachedTail_ = tail_.load(std::memory_order_acquire);
+    return head == cachedTail_;
+  }
+
+private:
+  const size_t mask_;
+  const std::unique_ptr<T[]> slots_;
+
+  // 소비자 쪽 라인: head_ + 소비자가 본 tail
+  alignas(CACHE_LINE) std::atomic<size_t> head_{0};
+  size_t cachedTail_ = 0;
+
+  // 생산자 쪽 라인: tail_ + 생산자가 본 head
+  alignas(CACHE_LINE) std::atomic<size_t> tail_{0};
+  size_t cachedHead_ = 0;
+};
+
+// ==========================================
+// MPSC: Vyukov 유한 큐 (소비자 1개)
+// ==========================================
+
+/**
+ * 칸 i의 sequence:
+ *   == 위치 pos        -> 비어 있음, pos번째 push가 쓸 수 있음
+ *   == pos + 1         -> 채워짐, pos번째 pop이 읽을 수 있음
+ *   == pos + capacity  -> 소비자가 비움, 다음 바퀴의 push 차례
+ * 생산자끼리는 tail CAS로만 겨루고, 소비자와는 칸의 sequence로만 만남
+ */
+template <class T> class MpscQueue {
+public:
+  explicit MpscQueue(size_t capacity)
+      : mask_(roundUpPow2(capacity) - 1), cells_(new Cell[mask_ + 1]) {
+    for (size_t i = 0; i <= mask_; i++) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpscQueue(const MpscQueue &) = delete;
+  MpscQueue &operator=(const MpscQueue &) = delete;
+
+  size_t capacity() const { return mask_ + 1; }
+
+  // ---- 생산자 (여러 스레드) ----
+
+  bool tryPush(T item) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell &cell = cells_[pos & mask_];
+      size_t seq = cell.sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          cell.value = std::move(item);
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+        // 실패하면 pos가 최신 tail로 바뀌어 있음 -> 다시
+      } else if (diff < 0) {
+        return false; // 한 바퀴 전 원소를 소비자가 아직 안 꺼냄 = 가득 참
+      } else {
+        pos = tail_.load(std::memory_order_relaxed); // 다른 생산자가 앞섬
+      }
+    }
+  }
+
+  /**
+   * 연속된 n칸을 CAS 한 번으로 차지. 소비자는 순서대로 비우므로 마지막 칸이
+   * 비어 있으면 앞 칸들도 비어 있음 -> 첫 칸(다른 생산자가 앞섰나)과 마지막
+   * 칸(자리가 있나)만 확인. 자리가 모자라면 절반씩 줄여서 다시 (넣은 개수를
+   * 돌려줌)
+   */
+  size_t tryPushBatch(T *items, size_t count) {
+    size_t n = count < capacity() ? count : capacity();
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    while (n > 0) {
+      size_t last = pos + n - 1;
+      size_t firstSeq =
+          cells_[pos & mask_].sequence.load(std::memory_order_acquire);
+      size_t lastSeq =
+          cells_[last & mask_].sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)lastSeq - (intptr_t)last;
+      if ((intptr_t)firstSeq - (intptr_t)pos > 0) {
+        pos = tail_.load(std::memory_order_relaxed); // 다른 생산자가 앞섬
+        continue;
+      }
+      if (diff < 0) {
+        n /= 2; // 자리 부족
+        continue;
+      }
+      if (diff > 0) {
+        pos = tail_.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (tail_.compare_exchange_weak(pos, pos + n,
+                                      std::memory_order_relaxed)) {
+        for (size_t i = 0; i < n; i++) {
+          Cell &cell = cells_[(pos + i) & mask_];
+          cell.value = std::move(items[i]);
+          cell.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return n;
+      }
+    }
+    return 0;
+  }
+
+  // ---- 소비자 스레드 전용 ----
+
+  bool tryPop(T &out) {
+    Cell &cell = cells_[head_ & mask_];
+    if (cell.sequence.load(std::memory_order_acquire) != head_ + 1) {
+      return false; // 비었거나, 자리만 차지하고 아직 기록 중인 생산자
+    }
+    out = std::move(cell.value);
+    cell.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+    head_++;
+    return true;
+  }
+
+  size_t tryPopBatch(T *out, size_t max) {
+    size_t n = 0;
+    while (n < max) {
+      Cell &cell = cells_[head_ & mask_];
+      if (cell.sequence.load(std::memory_order_acquire) != head_ + 1) {
+        break;
+      }
+      out[n++] = std::move(cell.value);
+      cell.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+      head_++;
+    }
+    return n;
+  }
+
+  bool empty() const {
+    return cells_[head_ & mask_].sequence.load(std::memory_order_acquire) !=
+           head_ + 1;
+  }
+
+private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  const size_t mask_;
+  const std::unique_ptr<Cell[]> cells_;
+
+  alignas(CACHE_LINE) std::atomic<size_t> tail_{0}; // 생산자들이 CAS
+  alignas(CACHE_LINE) size_t head_ = 0;             // 소비자만
+};
+
+// ==========================================
+// 대기 전략
+// ==========================================
+// 공통 모양: 소비자는 wait(ready) - ready()가 true가 될 때까지 기다림,
+// 생산자는 push 성공 후 notify()
+
+struct SpinWait {
+  template <class Ready> void wait(Ready ready) {
+    int spins = 0;
+    while (!ready()) {
+      if (++spins < SPINS_BEFORE_YIELD) {
+        cpuRelax();
+      } else {
+        spins = 0;
+        std::this_thread::yield();
+      }
+    }
+  }
+  void notify() {}
+};
+
+struct YieldWait {
+  template <class Ready> void wait(Ready ready) {
+    while (!ready()) {
+      std::this_thread::yield();
+    }
+  }
+  void notify() {}
+};
+
+/**
+ * epoch_: 깨울 때마다 증가하는 futex 주소. 소비자는 epoch를 읽고 -> 잠든다고
+ * 표시 -> ready() 재확인 -> FUTEX_WAIT(epoch가 그대로면 잠듦). 사이에 생산자가
+ * epoch를 올렸으면 FUTEX_WAIT가 바로 돌아옴 (깨움 유실 X)
+ */
+class FutexWait {
+public:
+  template <class Ready> void wait(Ready ready) {
+    for (int i = 0; i < SPINS_BEFORE_SLEEP; i++) {
+      if (ready()) {
+        return;
+      }
+      cpuRelax();
+    }
+    while (!ready()) {
+      uint32_t epoch = epoch_.load(std::memory_order_acquire);
+      sleepers_.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst); // 표시와 재확인 사이
+      if (!ready()) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(&epoch_),
+                FUTEX_WAIT_PRIVATE, epoch, nullptr, nullptr, 0);
+      }
+      sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  void notify() {
+    std::atomic_thread_fence(std::memory_order_seq_cst); // push와 확인 사이
+    if (sleepers_.load(std::memory_order_relaxed) == 0) {
+      return; // 깨어 있음 -> 시스템 콜 없음
+    }
+    epoch_.fetch_add(1, std::memory_order_release);
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&epoch_),
+            FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+  }
+
+private:
+  static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+                "futex needs a plain 32-bit word");
+  alignas(CACHE_LINE) std::atomic<uint32_t> epoch_{0};
+  std::atomic<uint32_t> sleepers_{0};
+};
+
+/**
+ * eventfd 깨움. epoll 루프에 넣는 순서:
+ *
+ *   epoll_ctl(ADD, wakeup.fd(), EPOLLIN)
+ *   for (;;) {
+ *     if (queue.tryPopBatch(...) == 0 && wakeup.arm(ready)) {
+ *       epoll_wait(...);           // 소켓 또는 큐 도착
+ *       wakeup.disarm();           // fd가 깨웠으면 카운터도 비움
+ *     }
+ *     ... 소켓 이벤트 처리 ...
+ *   }
+ *
+ * arm()이 false면 그 사이 원소가 들어온 것 -> 잠들지 말고 바로 꺼냄.
+ * 생산자는 armed_일 때만 write (깨어 있는 소비자에게는 시스템 콜 0번)
+ */
+class EventfdWait {
+public:
+  EventfdWait() : fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+    if (fd_ < 0) {
+      throw std::runtime_error("eventfd failed");
+    }
+  }
+  ~EventfdWait() { close(fd_); }
+
+  EventfdWait(const EventfdWait &) = delete;
+  EventfdWait &operator=(const EventfdWait &) = delete;
+
+  int fd() const { return fd_; }
+
+  // 잠들어도 되면 true (armed 상태로 남음)
+  template <class Ready> bool arm(Ready ready) {
+    armed_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (ready()) {
+      armed_.store(false, std::memory_order_relaxed);
+      return false;
+    }
+    return true;
+  }
+
+  void disarm() {
+    armed_.store(false, std::memory_order_relaxed);
+    uint64_t value;
+    while (read(fd_, &value, sizeof(value)) > 0) {
+    }
+  }
+
+  // epoll 없이 혼자 기다릴 때 (poll로 fd 하나만)
+  template <class Ready> void wait(Ready ready) {
+    for (int i = 0; i < SPINS_BEFORE_SLEEP; i++) {
+      if (ready()) {
+        return;
+      }
+      cpuRelax();
+    }
+    while (!ready()) {
+      if (arm(ready)) {
+        struct pollfd pfd;
+        pfd.fd = fd_;
+        pfd.events = POLLIN;
+        poll(&pfd, 1, -1);
+        disarm();
+      }
+    }
+  }
+
+  void notify() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!armed_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    if (armed_.exchange(false, std::memory_order_relaxed)) {
+      uint64_t one = 1;
+      ssize_t written = write(fd_, &one, sizeof(one));
+      (void)written; // 카운터가 넘칠 일은 없음 (소비자가 곧 disarm에서 비움)
+    }
+  }
+
+private:
+  int fd_;
+  alignas(CACHE_LINE) std::atomic<bool> armed_{false};
+};
+
+} // namespace lfq
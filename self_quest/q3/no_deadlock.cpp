@@ -3,11 +3,15 @@
 #include <mutex>
 #include <chrono> // sleep_for 사용
 
+#include "profiled_mutex.h" // [Task 7] -DLOCKPROF 로 빌드하면 잠금 순서 검사
+
 using namespace std;
 
 // 두 개의 자원(자물쇠) 준비
-mutex mtxA;
-mutex mtxB;
+// (ProfiledMutex: 평소에는 std::mutex 그대로, -DLOCKPROF 면 프로파일링)
+using lockprof::ProfiledMutex;
+ProfiledMutex mtxA("A");
+ProfiledMutex mtxB("B");
 
 // [Worker 1] A와 B가 모두 필요함
 void worker1() {
@@ -19,8 +23,8 @@ void worker1() {
 
     // 이미 잠긴 뮤텍스의 소유권만 lock_guard에게 넘겨줌 (adopt_lock)
     // 이렇게 해야 함수가 끝날 때 자동으로 unlock 됨
-    lock_guard<mutex> lockA(mtxA, adopt_lock);
-    lock_guard<mutex> lockB(mtxB, adopt_lock);
+    lock_guard<ProfiledMutex> lockA(mtxA, adopt_lock);
+    lock_guard<ProfiledMutex> lockB(mtxB, adopt_lock);
 
     cout << "[Worker1] 자원 A, B 획득 성공! (작업 중...)" << endl;
 
@@ -38,8 +42,8 @@ void worker2() {
     // Worker1과 인자 순서를 다르게 넣어도(mtxB, mtxA) std::lock이 알아서 안전하게 처리해줌
     std::lock(mtxA, mtxB);
 
-    lock_guard<mutex> lockB(mtxB, adopt_lock);
-    lock_guard<mutex> lockA(mtxA, adopt_lock);
+    lock_guard<ProfiledMutex> lockB(mtxB, adopt_lock);
+    lock_guard<ProfiledMutex> lockA(mtxA, adopt_lock);
 
     cout << "[Worker2] 자원 A, B 획득 성공! (작업 중...)" << endl;
 
@@ -61,5 +65,6 @@ int main() {
     t2.join();
 
     cout << "=== 모든 작업 완료 (정상 종료) ===" << endl;
+    lockprof::report(cout); // [Task 7] -DLOCKPROF 빌드에서만 출력 (std::lock은 순서 간선 X)
     return 0;
 }
\ No newline at end of file
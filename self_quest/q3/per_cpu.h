@@ -0,0 +1,134 @@
+/**
+ * [Task 6] CPU별 슬롯 + 샤드 카운터 (헤더 전용, C++11 이상)
+ *
+ *   percpu::ShardedCounter requests;
+ *   requests.add();                  // 핫 패스: 지금 도는 CPU의 칸에만 씀
+ *   long long total = requests.read(); // 모든 칸 합산 (드물게)
+ *
+ *   percpu::PerCpu<RateBucket> buckets; // 임의 타입도 CPU별로
+ *   buckets.local().take(1);
+ *
+ * - 칸 하나 = 캐시 라인 하나 (hardware_destructive_interference_size)
+ *   -> 다른 CPU의 칸과 라인을 공유하지 않음 (false sharing X)
+ * - 현재 CPU 번호는 glibc가 등록한 rseq 영역의 cpu_id에서 읽음 (메모리
+ *   로드 1번, 시스템 콜 X). rseq가 없으면 sched_getcpu()
+ * - 번호를 읽은 직후 다른 CPU로 옮겨질 수 있어서 칸의 주인이 하나라는 보장은
+ *   없음 -> 카운터는 relaxed fetch_add. 라인이 이미 이 코어 캐시에 있으므로
+ *   lock add만 내고 코어 간 전송은 거의 없음 (공유 atomic 하나는 매번 전송)
+ * - 스레드별 샤드(q4/metrics.h)와 차이: 스레드가 CPU보다 많아도 칸 수 = CPU 수
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <sched.h>
+#include <unistd.h>
+
+#if defined(__has_include)
+#if __has_include(<sys/rseq.h>)
+#include <sys/rseq.h>
+#define PERCPU_HAVE_RSEQ 1
+#endif
+#endif
+
+namespace percpu {
+
+// = std::hardware_destructive_interference_size (GCC 12+). 헤더에서 std:: 상수를
+// 쓰면 -Winterference-size(ABI가 -mtune에 따라 바뀜) 경고 -> 같은 값의 매크로
+#if defined(__GCC_DESTRUCTIVE_SIZE)
+const size_t CACHE_LINE = __GCC_DESTRUCTIVE_SIZE;
+#else
+const size_t CACHE_LINE = 64;
+#endif
+
+/**
+ * 칸 수: 설정된 CPU 전체 (온라인이 아닌 번호도 나올 수 있어서 _CONF)
+ */
+inline int possibleCpus() {
+  long n = sysconf(_SC_NPROCESSORS_CONF);
+  return n > 0 ? (int)n : 1;
+}
+
+/**
+ * 지금 이 스레드가 도는 CPU 번호 (읽자마자 바뀔 수 있음 - 힌트로만 사용)
+ */
+inline int currentCpu() {
+#ifdef PERCPU_HAVE_RSEQ
+  if (__rseq_size > 0) {
+    const volatile struct rseq *area = (const volatile struct rseq *)(
+        (char *)__builtin_thread_pointer() + __rseq_offset);
+    return (int)area->cpu_id;
+  }
+#endif
+  int cpu = sched_getcpu();
+  return cpu >= 0 ? cpu : 0;
+}
+
+/**
+ * CPU마다 T 하나. 칸은 캐시 라인 정렬 (C++11의 new는 16바이트 넘는 정렬을
+ * 보장하지 않으므로 posix_memalign + placement new)
+ */
+template <class T> class PerCpu {
+public:
+  PerCpu() : count_(possibleCpus()), slots_(nullptr) {
+    void *memory = nullptr;
+    if (posix_memalign(&memory, CACHE_LINE, sizeof(Slot) * count_) != 0) {
+      throw std::bad_alloc();
+    }
+    slots_ = static_cast<Slot *>(memory);
+    for (int i = 0; i < count_; i++) {
+      new (&slots_[i]) Slot();
+    }
+  }
+
+  ~PerCpu() {
+    for (int i = 0; i < count_; i++) {
+      slots_[i].~Slot();
+    }
+    free(slots_);
+  }
+
+  PerCpu(const PerCpu &) = delete;
+  PerCpu &operator=(const PerCpu &) = delete;
+
+  T &local() { return slots_[currentCpu() % count_].value; }
+  T &at(int cpu) { return slots_[cpu].value; }
+  const T &at(int cpu) const { return slots_[cpu].value; }
+  int size() const { return count_; }
+
+private:
+  struct alignas(CACHE_LINE) Slot {
+    T value;
+    Slot() : value() {}
+  };
+
+  int count_;
+  Slot *slots_;
+};
+
+/**
+ * CPU별 카운터: 쓰기는 자기 칸에 relaxed fetch_add, 읽기는 전체 합
+ * (읽는 도중에도 증가가 들어오므로 합은 "그 무렵"의 값)
+ */
+class ShardedCounter {
+public:
+  void add(int64_t n = 1) {
+    cells_.local().fetch_add(n, std::memory_order_relaxed);
+  }
+
+  int64_t read() const {
+    int64_t total = 0;
+    for (int i = 0; i < cells_.size(); i++) {
+      total += cells_.at(i).load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+private:
+  PerCpu<std::atomic<int64_t> > cells_;
+};
+
+} // namespace percpu
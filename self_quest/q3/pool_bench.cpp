@@ -0,0 +1,355 @@
+/**
+ * [Task 9] 작업 훔치기 풀 vs 전역 mutex 큐 풀
+ *
+ * 지금까지 q3 데모는 일마다 std::thread를 새로 만들었다. 패킷마다 CPU를 쓰는
+ * 일(압축, 검증, 게임 규칙 계산)을 넘기려면 고정된 워커 풀이 필요하고, 풀의
+ * 큐 구조가 작업 크기 분포에 따라 어떻게 버티는지를 잰다.
+ *
+ *   steal  : wsp::ThreadPool (워커별 Chase-Lev 덱 + inbox, 한가하면 훔침)
+ *   global : 워커 N개가 std::mutex + std::deque 하나를 같이 씀 (가장 흔한 구현)
+ *
+ * 작업 부하 (do_some_work(k)의 k, 기본 단위 BASE_WORK):
+ *   uniform : 전부 같은 크기
+ *   skewed  : 63/64는 작고(BASE/4) 1/64는 큼(BASE*64) -> 꼬리가 긴 분포
+ *   front   : 큰 작업이 배치 앞쪽에 몰림 (정적 분배면 한 워커만 바쁨)
+ *   nested  : 작업 하나가 워커 안에서 자식 작업 8개를 다시 제출 (재귀 분할)
+ *   pfor    : parallelFor - 원소 비용이 앞쪽 1/8에 몰린 배열을 조각내서 처리
+ *
+ * 바깥 스레드(리액터 역할)가 64개씩 submitBatch로 넣고, 래치로 끝을 기다림.
+ *
+ * CSV 열: pool,workload,workers,tasks,ms,tasks_per_sec,steals,min_share,
+ *         max_share,verified
+ *   min/max_share: 워커별 실행 수 / 공평한 몫 (global은 워커별로 셈)
+ *   verified: 모든 작업이 정확히 한 번 실행됨 (작업 번호 합 비교)
+ *
+ * 컴파일: g++ -o pool_bench pool_bench.cpp -std=c++17 -O2 -pthread
+ * 실행: ./pool_bench [tasks] [workers] [workloads]
+ * 예시: ./pool_bench 200000 4 uniform,skewed,nested > pool.csv
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "work_steal_pool.h" // [Task 9]
+
+using namespace std;
+using namespace std::chrono;
+
+const int BASE_WORK = 2000;   // 작업 하나의 기본 크기 (약 1us)
+const int SUBMIT_BATCH = 64;  // 바깥 스레드가 한 번에 넣는 개수
+const int NESTED_CHILDREN = 8;
+
+void do_some_work(int iterations) {
+  volatile int dummy = 0;
+  for (int k = 0; k < iterations; ++k) {
+    dummy++;
+  }
+}
+
+// ==========================================
+// 기준선: 전역 큐 하나 (mutex + deque + condition_variable)
+// ==========================================
+
+class GlobalQueuePool {
+public:
+  explicit GlobalQueuePool(int workers) {
+    for (int i = 0; i < workers; i++) {
+      threads_.emplace_back(&GlobalQueuePool::worker_loop, this);
+    }
+  }
+
+  ~GlobalQueuePool() {
+    {
+      lock_guard<mutex> guard(lock_);
+      stopping_ = true;
+    }
+    not_empty_.notify_all();
+    for (auto &t : threads_) {
+      t.join();
+    }
+  }
+
+  int size() const { return (int)threads_.size(); }
+
+  void submit(wsp::Task task, int = -1) {
+    {
+      lock_guard<mutex> guard(lock_);
+      tasks_.push_back(std::move(task));
+    }
+    not_empty_.notify_one();
+  }
+
+  void submitBatch(vector<wsp::Task> &tasks, int = -1) {
+    {
+      lock_guard<mutex> guard(lock_);
+      for (auto &t : tasks) {
+        tasks_.push_back(std::move(t));
+      }
+    }
+    tasks.clear();
+    not_empty_.notify_all();
+  }
+
+  template <class Body>
+  void parallelFor(size_t begin, size_t end, size_t grain, Body body) {
+    wsp::Latch latch((end - begin + grain - 1) / grain);
+    vector<wsp::Task> tasks;
+    for (size_t lo = begin; lo < end; lo += grain) {
+      size_t hi = min(end, lo + grain);
+      tasks.push_back([&body, &latch, lo, hi]() {
+        body(lo, hi);
+        latch.countDown();
+      });
+    }
+    submitBatch(tasks);
+    latch.wait(); // 바깥 스레드에서만 부름 (벤치마크)
+  }
+
+  uint64_t stolen(int) const { return 0; }
+
+private:
+  void worker_loop() {
+    for (;;) {
+      wsp::Task task;
+      {
+        unique_lock<mutex> guard(lock_);
+        while (tasks_.empty() && !stopping_) {
+          not_empty_.wait(guard);
+        }
+        if (tasks_.empty()) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+
+  mutex lock_;
+  condition_variable not_empty_;
+  deque<wsp::Task> tasks_;
+  bool stopping_ = false;
+  vector<thread> threads_;
+};
+
+// ==========================================
+// 작업 부하
+// ==========================================
+
+int task_cost(const string &workload, long long i, long long tasks) {
+  if (workload == "skewed") {
+    return i % 64 == 0 ? BASE_WORK * 64 : BASE_WORK / 4;
+  }
+  if (workload == "front") {
+    // 전체 일의 절반가량이 앞쪽 1/16 작업에
+    return i < tasks / 16 ? BASE_WORK * 16 : BASE_WORK;
+  }
+  return BASE_WORK;
+}
+
+struct Result {
+  double ms = 0;
+  double tasks_per_sec = 0;
+  uint64_t steals = 0;
+  double min_share = 0;
+  double max_share = 0;
+  bool verified = false;
+};
+
+// 워커별 실행 수: 작업이 자기 스레드 칸에 셈 (두 풀을 같은 방법으로 세려고)
+const int MAX_WORKERS = 256;
+struct alignas(wsp::CACHE_LINE) WorkerSlot {
+  atomic<uint64_t> executed{0};
+};
+WorkerSlot g_slots[MAX_WORKERS];
+atomic<int> g_next_slot(0);
+thread_local int t_slot = -1;
+
+inline void count_executed() {
+  if (t_slot < 0) {
+    t_slot = g_next_slot.fetch_add(1) % MAX_WORKERS;
+  }
+  atomic<uint64_t> &cell = g_slots[t_slot].executed;
+  cell.store(cell.load(memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+inline void finish_task(long long id, wsp::Latch &latch,
+                        atomic<long long> &checksum) {
+  checksum.fetch_add(id, memory_order_relaxed);
+  count_executed();
+  latch.countDown();
+}
+
+template <class Pool>
+void submit_flat(Pool &pool, const string &workload, long long tasks,
+                 wsp::Latch &latch, atomic<long long> &checksum) {
+  vector<wsp::Task> batch;
+  batch.reserve(SUBMIT_BATCH);
+  for (long long i = 0; i < tasks; i++) {
+    int cost = task_cost(workload, i, tasks);
+    batch.push_back([cost, i, &latch, &checksum]() {
+      do_some_work(cost);
+      finish_task(i, latch, checksum);
+    });
+    if ((int)batch.size() == SUBMIT_BATCH) {
+      pool.submitBatch(batch);
+    }
+  }
+  pool.submitBatch(batch);
+}
+
+// 부모 하나 = 자식 NESTED_CHILDREN개를 (워커 안에서) 제출 + 자기 일
+template <class Pool>
+void submit_nested(Pool &pool, long long tasks, wsp::Latch &latch,
+                   atomic<long long> &checksum) {
+  long long parents = tasks / (NESTED_CHILDREN + 1);
+  vector<wsp::Task> batch;
+  for (long long p = 0; p < parents; p++) {
+    batch.push_back([p, &pool, &latch, &checksum]() {
+      for (int c = 0; c < NESTED_CHILDREN; c++) {
+        long long id = p * (NESTED_CHILDREN + 1) + 1 + c;
+        pool.submit([id, &latch, &checksum]() {
+          do_some_work(BASE_WORK);
+          finish_task(id, latch, checksum);
+        });
+      }
+      do_some_work(BASE_WORK);
+      finish_task(p * (NESTED_CHILDREN + 1), latch, checksum);
+    });
+    if ((int)batch.size() == SUBMIT_BATCH) {
+      pool.submitBatch(batch);
+    }
+  }
+  pool.submitBatch(batch);
+}
+
+// parallelFor: 원소 i의 비용이 앞쪽 1/8은 16배 -> 조각마다 일의 양이 다름
+template <class Pool>
+void run_pfor(Pool &pool, long long tasks, atomic<long long> &checksum) {
+  const size_t grain = 16;
+  size_t n = (size_t)tasks;
+  pool.parallelFor(0, n, grain, [&](size_t lo, size_t hi) {
+    long long sum = 0;
+    for (size_t i = lo; i < hi; i++) {
+      do_some_work(i < n / 8 ? BASE_WORK * 16 : BASE_WORK);
+      sum += (long long)i;
+      count_executed();
+    }
+    checksum.fetch_add(sum, memory_order_relaxed);
+  });
+}
+
+template <class Pool>
+Result run_case(const string &workload, int workers, long long tasks) {
+  if (workload == "nested") {
+    tasks = tasks / (NESTED_CHILDREN + 1) * (NESTED_CHILDREN + 1);
+  }
+  for (int i = 0; i < MAX_WORKERS; i++) {
+    g_slots[i].executed.store(0);
+  }
+  g_next_slot.store(0);
+
+  Result r;
+  atomic<long long> checksum(0);
+  {
+    Pool pool(workers); // 스레드 생성은 측정 밖
+    auto start = steady_clock::now();
+    if (workload == "pfor") {
+      run_pfor(pool, tasks, checksum);
+    } else {
+      wsp::Latch latch((size_t)tasks);
+      if (workload == "nested") {
+        submit_nested(pool, tasks, latch, checksum);
+      } else {
+        submit_flat(pool, workload, tasks, latch, checksum);
+      }
+      latch.wait();
+    }
+    duration<double, milli> elapsed = steady_clock::now() - start;
+    r.ms = elapsed.count();
+    for (int w = 0; w < workers; w++) {
+      r.steals += pool.stolen(w);
+    }
+  } // 워커 join -> 아래 칸 값이 확정
+
+  double fair = (double)tasks / workers;
+  uint64_t min_ops = UINT64_MAX;
+  uint64_t max_ops = 0;
+  for (int w = 0; w < workers && w < MAX_WORKERS; w++) {
+    uint64_t ops = g_slots[w].executed.load();
+    min_ops = min(min_ops, ops);
+    max_ops = max(max_ops, ops);
+  }
+  r.min_share = min_ops / fair;
+  r.max_share = max_ops / fair;
+  r.tasks_per_sec = tasks / (r.ms / 1000.0);
+  r.verified = checksum.load() == tasks * (tasks - 1) / 2;
+  return r;
+}
+
+void print_row(const string &pool, const string &workload, int workers,
+               long long tasks, const Result &r) {
+  cout << pool << "," << workload << "," << workers << "," << tasks << ","
+       << r.ms << "," << (long long)r.tasks_per_sec << "," << r.steals << ","
+       << r.min_share << "," << r.max_share << ","
+       << (r.verified ? "yes" : "NO") << endl;
+}
+
+vector<string> split(const string &text) {
+  vector<string> parts;
+  stringstream ss(text);
+  string part;
+  while (getline(ss, part, ',')) {
+    if (!part.empty()) {
+      parts.push_back(part);
+    }
+  }
+  return parts;
+}
+
+int main(int argc, char *argv[]) {
+  long long tasks = 200000;
+  int workers = (int)thread::hardware_concurrency();
+  string workloads = "uniform,skewed,front,nested,pfor";
+  if (argc >= 2) {
+    tasks = atoll(argv[1]);
+  }
+  if (argc >= 3) {
+    workers = atoi(argv[2]);
+  }
+  if (argc >= 4) {
+    workloads = argv[3];
+  }
+  if (workers <= 0) {
+    workers = 1;
+  }
+
+  cerr << "[*] cores=" << thread::hardware_concurrency()
+       << " workers=" << workers << " tasks=" << tasks
+       << " base_work=" << BASE_WORK << endl;
+  cout << "pool,workload,workers,tasks,ms,tasks_per_sec,steals,min_share,"
+          "max_share,verified"
+       << endl;
+  if (workers > MAX_WORKERS) {
+    workers = MAX_WORKERS;
+  }
+  for (const string &workload : split(workloads)) {
+    print_row("steal", workload, workers, tasks,
+              run_case<wsp::ThreadPool>(workload, workers, tasks));
+    print_row("global", workload, workers, tasks,
+              run_case<GlobalQueuePool>(workload, workers, tasks));
+  }
+  return 0;
+}
@@ -0,0 +1,411 @@
+/**
+ * [Task 7] 경합 프로파일링 뮤텍스 (헤더 전용, C++11 이상)
+ *
+ *   lockprof::ProfiledMutex sessionLock("session");
+ *
+ *   void touch() {
+ *     LOCKPROF_SITE();                              // 호출 지점 이름표 (선택)
+ *     std::lock_guard<lockprof::ProfiledMutex> g(sessionLock);
+ *     ...
+ *   }
+ *   lockprof::report(std::cout);                    // 락별 / 호출 지점별 통계
+ *
+ * - std::mutex 자리에 그대로: lock / unlock / try_lock -> lock_guard,
+ *   unique_lock, std::lock 모두 사용 가능
+ * - -DLOCKPROF 로 빌드할 때만 측정. 없으면 ProfiledMutex = std::mutex 를 상속한
+ *   빈 껍데기 (크기/코드 동일), LOCKPROF_SITE()와 report()는 아무것도 안 함
+ *   -> 같은 코드를 스테이징 부하 테스트에서만 켜서 돌림
+ * - 측정: 획득 횟수, 경합 횟수(try_lock 실패 후 대기), 대기 시간 / 보유 시간
+ *   히스토그램 (2의 거듭제곱 ns 버킷). 락별 + 호출 지점별
+ * - 잠금 순서 그래프: -DLOCKPROF 이고 NDEBUG가 아닐 때 (디버그 빌드).
+ *   스레드가 A를 쥔 채 B를 lock()하면 간선 A -> B. 새 간선이 사이클을 만들면
+ *   (다른 곳에서 B -> ... -> A 순서로 잡은 적이 있으면) 실제로 멈추기 전에
+ *   stderr로 경고. try_lock은 기다리지 않으므로 간선을 만들지 않음 (std::lock이
+ *   안전한 이유). -DLOCKPROF_NO_LOCK_ORDER 로 끌 수 있음
+ */
+
+#pragma once
+
+#include <mutex>
+#include <ostream>
+
+#ifdef LOCKPROF
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined(NDEBUG) && !defined(LOCKPROF_NO_LOCK_ORDER)
+#define LOCKPROF_LOCK_ORDER 1
+#endif
+#endif
+
+namespace lockprof {
+
+#ifdef LOCKPROF
+
+const int HISTOGRAM_BUCKETS = 40; // 2^0 .. 2^39 ns (약 9분)
+
+inline uint64_t nowNs() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// 락을 쥔 스레드만 쓰는 값: RMW(lock add) 없이 load + store
+inline void bumpOwned(std::atomic<uint64_t> &cell, uint64_t delta) {
+  cell.store(cell.load(std::memory_order_relaxed) + delta,
+             std::memory_order_relaxed);
+}
+
+/**
+ * owned = true: 락을 쥔 채 기록 (락별 통계, 작성자 한 명)
+ * owned = false: 여러 스레드가 동시에 기록 (호출 지점은 여러 락이 공유)
+ */
+struct Histogram {
+  std::atomic<uint64_t> buckets[HISTOGRAM_BUCKETS];
+  std::atomic<uint64_t> count;
+  std::atomic<uint64_t> total;
+  std::atomic<uint64_t> max;
+
+  Histogram() : count(0), total(0), max(0) {
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+      buckets[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  void record(uint64_t ns, bool owned) {
+    int k = ns <= 1 ? 0 : 64 - __builtin_clzll(ns - 1); // ns <= 2^k
+    if (k >= HISTOGRAM_BUCKETS) {
+      k = HISTOGRAM_BUCKETS - 1;
+    }
+    if (owned) {
+      bumpOwned(buckets[k], 1);
+      bumpOwned(count, 1);
+      bumpOwned(total, ns);
+      if (ns > max.load(std::memory_order_relaxed)) {
+        max.store(ns, std::memory_order_relaxed);
+      }
+      return;
+    }
+    buckets[k].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(ns, std::memory_order_relaxed);
+    uint64_t prev = max.load(std::memory_order_relaxed);
+    while (ns > prev &&
+           !max.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {
+    }
+  }
+
+  // 버킷 상한 (실제 값보다 최대 2배 큼)
+  uint64_t percentile(double p) const {
+    uint64_t n = count.load(std::memory_order_relaxed);
+    if (n == 0) {
+      return 0;
+    }
+    uint64_t target = (uint64_t)(n * p);
+    uint64_t seen = 0;
+    for (int k = 0; k < HISTOGRAM_BUCKETS; k++) {
+      seen += buckets[k].load(std::memory_order_relaxed);
+      if (seen > target) {
+        return 1ULL << k;
+      }
+    }
+    return 1ULL << (HISTOGRAM_BUCKETS - 1);
+  }
+};
+
+struct Stats {
+  std::atomic<uint64_t> acquisitions;
+  std::atomic<uint64_t> contended; // try_lock 실패 -> 기다린 횟수
+  Histogram wait;                  // 경합 때만 기록 (바로 잡으면 0이라 생략)
+  Histogram hold;
+
+  Stats() : acquisitions(0), contended(0) {}
+};
+
+class ProfiledMutex;
+
+/**
+ * 호출 지점 (LOCKPROF_SITE()가 static으로 하나 만듦)
+ */
+struct Site {
+  const char *file;
+  int line;
+  const char *func;
+  Stats stats;
+
+  Site(const char *f, int l, const char *fn);
+};
+
+/**
+ * 프로세스 전체 목록 + 잠금 순서 그래프 (등록/보고/새 간선 때만 잠금)
+ */
+struct Registry {
+  std::mutex m;
+  std::vector<ProfiledMutex *> locks; // id -> 뮤텍스 (소멸하면 nullptr)
+  std::vector<std::string> names;     // id -> 이름 (소멸 후에도 보고용으로 유지)
+  std::vector<Site *> sites;
+  std::vector<std::vector<int> > after; // 간선 id -> 그 다음에 잡은 id들
+  std::set<std::pair<int, int> > edges;
+  uint64_t cycles = 0;
+};
+
+inline Registry &registry() {
+  static Registry r;
+  return r;
+}
+
+inline Site::Site(const char *f, int l, const char *fn)
+    : file(f), line(l), func(fn) {
+  Registry &r = registry();
+  std::lock_guard<std::mutex> g(r.m);
+  r.sites.push_back(this);
+}
+
+// 이 스레드가 지금 통과 중인 호출 지점 (없으면 nullptr)
+inline Site *&currentSite() {
+  static thread_local Site *site = nullptr;
+  return site;
+}
+
+/**
+ * 범위 동안 currentSite를 바꿔 둠 (중첩되면 바깥 것을 복원)
+ */
+class SiteScope {
+public:
+  explicit SiteScope(Site &site) : prev_(currentSite()) {
+    currentSite() = &site;
+  }
+  ~SiteScope() { currentSite() = prev_; }
+
+private:
+  Site *prev_;
+};
+
+#ifdef LOCKPROF_LOCK_ORDER
+// 이 스레드가 쥐고 있는 락 id (잡은 순서)
+inline std::vector<int> &heldLocks() {
+  static thread_local std::vector<int> held;
+  return held;
+}
+
+// 이 스레드가 이미 등록한 간선 (전역 레지스트리 잠금을 매번 안 하려고)
+inline std::set<std::pair<int, int> > &knownEdges() {
+  static thread_local std::set<std::pair<int, int> > known;
+  return known;
+}
+
+// from에서 to로 가는 경로 (DFS, 레지스트리 잠금 상태에서 호출)
+inline bool findPath(const Registry &r, int from, int to,
+                     std::vector<int> &path) {
+  path.push_back(from);
+  if (from == to) {
+    return true;
+  }
+  for (size_t i = 0; i < r.after[from].size(); i++) {
+    int next = r.after[from][i];
+    bool visited = false;
+    for (size_t j = 0; j < path.size(); j++) {
+      visited = visited || path[j] == next;
+    }
+    if (!visited && findPath(r, next, to, path)) {
+      return true;
+    }
+  }
+  path.pop_back();
+  return false;
+}
+
+/**
+ * held -> id 간선 추가. 반대 방향 경로가 이미 있으면 사이클 경고.
+ */
+inline void addOrderEdge(int held, int id, const Site *site) {
+  std::pair<int, int> edge(held, id);
+  if (!knownEdges().insert(edge).second) {
+    return;
+  }
+  Registry &r = registry();
+  std::lock_guard<std::mutex> g(r.m);
+  if (!r.edges.insert(edge).second) {
+    return;
+  }
+  std::vector<int> path;
+  if (findPath(r, id, held, path)) {
+    r.cycles++;
+    std::cerr << "[lockprof] potential deadlock: " << r.names[held];
+    for (size_t i = 0; i < path.size(); i++) {
+      std::cerr << " -> " << r.names[path[i]];
+    }
+    std::cerr << " (new edge " << r.names[held] << " -> " << r.names[id];
+    if (site != nullptr) {
+      std::cerr << " at " << site->file << ":" << site->line;
+    }
+    std::cerr << ")" << std::endl;
+  }
+  r.after[held].push_back(id);
+}
+#endif
+
+class ProfiledMutex {
+public:
+  explicit ProfiledMutex(const char *name = "mutex")
+      : acquiredAt_(0), holder_(nullptr) {
+    Registry &r = registry();
+    std::lock_guard<std::mutex> g(r.m);
+    id_ = (int)r.locks.size();
+    r.locks.push_back(this);
+    r.names.push_back(name);
+    r.after.push_back(std::vector<int>());
+  }
+
+  ~ProfiledMutex() {
+    Registry &r = registry();
+    std::lock_guard<std::mutex> g(r.m);
+    r.locks[id_] = nullptr;
+  }
+
+  ProfiledMutex(const ProfiledMutex &) = delete;
+  ProfiledMutex &operator=(const ProfiledMutex &) = delete;
+
+  void lock() {
+    Site *site = currentSite();
+#ifdef LOCKPROF_LOCK_ORDER
+    // 잠들기 전에 검사 -> 진짜 데드락이어도 경고는 남김
+    std::vector<int> &held = heldLocks();
+    for (size_t i = 0; i < held.size(); i++) {
+      addOrderEdge(held[i], id_, site);
+    }
+#endif
+    if (m_.try_lock()) {
+      onAcquired(site, nowNs(), 0, false);
+      return;
+    }
+    uint64_t start = nowNs();
+    m_.lock();
+    uint64_t acquired = nowNs();
+    onAcquired(site, acquired, acquired - start, true);
+  }
+
+  bool try_lock() {
+    if (!m_.try_lock()) {
+      return false;
+    }
+    onAcquired(currentSite(), nowNs(), 0, false);
+    return true;
+  }
+
+  void unlock() {
+    uint64_t hold = nowNs() - acquiredAt_;
+    Site *site = holder_;
+    stats_.hold.record(hold, true); // 아직 쥐고 있음
+#ifdef LOCKPROF_LOCK_ORDER
+    std::vector<int> &held = heldLocks();
+    for (size_t i = held.size(); i-- > 0;) {
+      if (held[i] == id_) {
+        held.erase(held.begin() + i);
+        break;
+      }
+    }
+#endif
+    m_.unlock();
+    if (site != nullptr) {
+      site->stats.hold.record(hold, false);
+    }
+  }
+
+  const Stats &stats() const { return stats_; }
+
+private:
+  // 락을 쥔 상태에서 호출 (acquiredAt_/holder_는 주인만 씀)
+  void onAcquired(Site *site, uint64_t now, uint64_t waited, bool contended) {
+    acquiredAt_ = now;
+    holder_ = site;
+#ifdef LOCKPROF_LOCK_ORDER
+    heldLocks().push_back(id_);
+#endif
+    bumpOwned(stats_.acquisitions, 1);
+    if (site != nullptr) {
+      site->stats.acquisitions.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (contended) {
+      bumpOwned(stats_.contended, 1);
+      stats_.wait.record(waited, true);
+      if (site != nullptr) {
+        site->stats.contended.fetch_add(1, std::memory_order_relaxed);
+        site->stats.wait.record(waited, false);
+      }
+    }
+  }
+
+  std::mutex m_;
+  int id_;
+  uint64_t acquiredAt_;
+  Site *holder_;
+  Stats stats_;
+};
+
+inline void reportLine(std::ostream &out, const Stats &s) {
+  uint64_t acq = s.acquisitions.load(std::memory_order_relaxed);
+  uint64_t cont = s.contended.load(std::memory_order_relaxed);
+  out << " acquisitions=" << acq << " contended=" << cont << " ("
+      << (acq ? 100.0 * cont / acq : 0.0) << "%)"
+      << " wait_ns p50<=" << s.wait.percentile(0.5)
+      << " p99<=" << s.wait.percentile(0.99)
+      << " max=" << s.wait.max.load(std::memory_order_relaxed)
+      << " hold_ns p50<=" << s.hold.percentile(0.5)
+      << " p99<=" << s.hold.percentile(0.99)
+      << " max=" << s.hold.max.load(std::memory_order_relaxed) << "\n";
+}
+
+/**
+ * 살아 있는 락별 + 호출 지점별 통계, 잠금 순서 사이클 수
+ */
+inline void report(std::ostream &out) {
+  Registry &r = registry();
+  std::lock_guard<std::mutex> g(r.m);
+  out << "=== lockprof ===\n";
+  for (size_t i = 0; i < r.locks.size(); i++) {
+    if (r.locks[i] != nullptr) {
+      out << "[lock " << r.names[i] << "]";
+      reportLine(out, r.locks[i]->stats());
+    }
+  }
+  for (size_t i = 0; i < r.sites.size(); i++) {
+    const Site *s = r.sites[i];
+    out << "[site " << s->file << ":" << s->line << " " << s->func << "]";
+    reportLine(out, s->stats);
+  }
+#ifdef LOCKPROF_LOCK_ORDER
+  out << "lock-order edges=" << r.edges.size() << " cycles=" << r.cycles
+      << "\n";
+#endif
+  out.flush();
+}
+
+#define LOCKPROF_CONCAT_(a, b) a##b
+#define LOCKPROF_CONCAT(a, b) LOCKPROF_CONCAT_(a, b)
+#define LOCKPROF_SITE()                                                        \
+  static ::lockprof::Site LOCKPROF_CONCAT(lockprofSite_, __LINE__)(           \
+      __FILE__, __LINE__, __func__);                                           \
+  ::lockprof::SiteScope LOCKPROF_CONCAT(lockprofScope_, __LINE__)(            \
+      LOCKPROF_CONCAT(lockprofSite_, __LINE__))
+
+#else // !LOCKPROF: 측정 없음 = std::mutex 그대로
+
+class ProfiledMutex : public std::mutex {
+public:
+  constexpr explicit ProfiledMutex(const char * = nullptr) noexcept {}
+};
+
+inline void report(std::ostream &) {}
+
+#define LOCKPROF_SITE() ((void)0)
+
+#endif
+
+} // namespace lockprof
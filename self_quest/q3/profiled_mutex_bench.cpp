@@ -0,0 +1,142 @@
+/**
+ * [Task 7] ProfiledMutex 데모 + 비용 측정
+ *
+ * 1) 비용: 경합 없는 lock/unlock 1회 - std::mutex vs ProfiledMutex
+ *    (-DLOCKPROF 없이 빌드하면 둘이 같아야 함 = 측정 코드가 사라짐)
+ * 2) 경합 프로파일: 스레드 4개가 "session" 락을 두 호출 지점에서 잡음
+ *    (짧게 쥐는 조회 / 길게 쥐는 갱신) -> 호출 지점별 대기/보유 시간
+ * 3) 잠금 순서: 한 스레드는 A -> B, 다른 스레드는 (앞 스레드가 끝난 뒤) B -> A.
+ *    실제로는 겹치지 않아서 안 멈추지만 순서 그래프에 사이클이 생김 -> 경고
+ *
+ * 컴파일:
+ *   g++ -o lockprof_off profiled_mutex_bench.cpp -std=c++17 -O2 -pthread
+ *   g++ -o lockprof_on profiled_mutex_bench.cpp -std=c++17 -O2 -pthread -DLOCKPROF
+ *   (-DNDEBUG 를 붙이면 측정은 하되 잠금 순서 그래프는 끔)
+ */
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "profiled_mutex.h" // [Task 7]
+
+using namespace std;
+using namespace std::chrono;
+
+using lockprof::ProfiledMutex;
+
+const int UNCONTENDED_OPS = 10000000;
+const int CONTENDED_OPS = 200000;
+
+void do_some_work(int iterations) {
+  volatile int dummy = 0;
+  for (int k = 0; k < iterations; ++k) {
+    dummy++;
+  }
+}
+
+template <class Mutex> double lock_unlock_ns(Mutex &m) {
+  auto start = steady_clock::now();
+  for (int i = 0; i < UNCONTENDED_OPS; ++i) {
+    lock_guard<Mutex> guard(m);
+  }
+  duration<double, nano> elapsed = steady_clock::now() - start;
+  return elapsed.count() / UNCONTENDED_OPS;
+}
+
+// ==========================================
+// 2) 경합 프로파일
+// ==========================================
+ProfiledMutex session_lock("session");
+long long session_value = 0;
+
+// 짧게 쥐는 조회
+long long read_session() {
+  LOCKPROF_SITE();
+  lock_guard<ProfiledMutex> guard(session_lock);
+  return session_value;
+}
+
+// 길게 쥐는 갱신 (임계 영역 안에서 일을 많이 함)
+void update_session() {
+  LOCKPROF_SITE();
+  lock_guard<ProfiledMutex> guard(session_lock);
+  do_some_work(500);
+  session_value++;
+}
+
+void worker_session(int id) {
+  for (int i = 0; i < CONTENDED_OPS; ++i) {
+    if (i % 10 == id % 10) {
+      update_session();
+    } else {
+      read_session();
+    }
+  }
+}
+
+// ==========================================
+// 3) 잠금 순서
+// ==========================================
+ProfiledMutex account_a("account_a");
+ProfiledMutex account_b("account_b");
+
+void transfer_a_to_b() {
+  LOCKPROF_SITE();
+  lock_guard<ProfiledMutex> from(account_a);
+  lock_guard<ProfiledMutex> to(account_b);
+}
+
+void transfer_b_to_a() {
+  LOCKPROF_SITE();
+  lock_guard<ProfiledMutex> from(account_b);
+  lock_guard<ProfiledMutex> to(account_a); // A -> B 와 반대 순서
+}
+
+// std::lock은 try_lock으로 나머지를 잡으므로 순서 간선이 생기지 않음
+void transfer_both() {
+  LOCKPROF_SITE();
+  std::lock(account_b, account_a);
+  lock_guard<ProfiledMutex> b(account_b, adopt_lock);
+  lock_guard<ProfiledMutex> a(account_a, adopt_lock);
+}
+
+int main() {
+#ifdef LOCKPROF
+  cout << "=== ProfiledMutex (LOCKPROF on) ===" << endl;
+#else
+  cout << "=== ProfiledMutex (LOCKPROF off) ===" << endl;
+#endif
+  static_assert(sizeof(ProfiledMutex) >= sizeof(mutex), "wraps std::mutex");
+  cout << "sizeof(std::mutex)=" << sizeof(mutex)
+       << " sizeof(ProfiledMutex)=" << sizeof(ProfiledMutex) << endl;
+
+  // 1) 비용
+  mutex plain;
+  ProfiledMutex profiled("bench");
+  cout << "[1] uncontended lock+unlock: std::mutex " << lock_unlock_ns(plain)
+       << " ns, ProfiledMutex " << lock_unlock_ns(profiled) << " ns" << endl;
+
+  // 2) 경합
+  vector<thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back(worker_session, t);
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  cout << "[2] session updates=" << session_value << endl;
+
+  // 3) 잠금 순서 (겹치지 않게 차례로)
+  thread first(transfer_a_to_b);
+  first.join();
+  thread both(transfer_both);
+  both.join();
+  thread second(transfer_b_to_a);
+  second.join();
+  cout << "[3] transfers done (경고는 stderr)" << endl;
+
+  lockprof::report(cout);
+  return 0;
+}
@@ -0,0 +1,471 @@
+/**
+ * [Task 8] 스레드 간 전달 큐 벤치마크 (lockfree_queue.h vs mutex + deque)
+ *
+ * I/O 스레드 -> 게임 로직 스레드로 일감을 넘기는 상황.
+ *
+ *   spsc   : lfq::SpscQueue (생산자 1개만)
+ *   mpsc   : lfq::MpscQueue
+ *   mutex  : std::mutex + std::deque + condition_variable (같은 용량 제한)
+ *
+ * 대기 전략 (lock-free 큐만, mutex는 항상 condition_variable):
+ *   spin / yield / futex / eventfd (eventfd는 소비자가 epoll_wait 루프에서 잠듦)
+ *
+ * 두 가지를 잰다:
+ *   1) 처리량: 생산자가 쉬지 않고 넣고 소비자가 꺼냄 -> 초당 전달 수
+ *      (batch > 1 이면 tryPushBatch / tryPopBatch)
+ *   2) 전달 지연: 생산자가 간격(gap)을 두고 하나씩 넣음 (큐는 거의 비어 있음)
+ *      -> 넣기 직전 시각 ~ 소비자가 꺼낸 시각. p50 / p99 / p99.9
+ *
+ * 코어 배치: 소비자는 CPU 0, 생산자는 CPU 0(같은 코어) / 1(옆 코어) /
+ * 코어 수/2 / 마지막 코어 중 서로 다른 것 (여러 생산자는 그 CPU부터 차례로).
+ * 코어가 1개면 "같은 코어" 한 줄만 나옴.
+ *
+ * CSV 열: queue,wait,producers,batch,producer_cpu,consumer_cpu,ops_per_sec,
+ *         p50_ns,p99_ns,p999_ns,verified
+ *   verified: 받은 개수와 합이 맞고, 생산자별 순서가 보존됨
+ *
+ * 컴파일: g++ -o queue_bench queue_bench.cpp -std=c++17 -O2 -pthread
+ * 실행: ./queue_bench [items] [latency_samples] [queues] [waits] [batches]
+ * 예시: ./queue_bench 2000000 20000 spsc,mpsc,mutex futex,eventfd 1,32 > q.csv
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <pthread.h>
+#include <sstream>
+#include <string>
+#include <sys/epoll.h>
+#include <thread>
+#include <vector>
+
+#include "lockfree_queue.h" // [Task 8]
+
+using namespace std;
+using namespace std::chrono;
+
+const size_t QUEUE_CAPACITY = 4096;
+const int MAX_BATCH = 256;
+const long long LATENCY_GAP_NS = 5000; // 지연 측정 시 넣는 간격 (5us)
+
+struct Item {
+  uint64_t stamp_ns; // 지연 측정용 (처리량 측정에서는 0)
+  uint32_t producer;
+  uint32_t seq; // 생산자별 순번 -> 순서 검증
+};
+
+inline uint64_t now_ns() {
+  return (uint64_t)duration_cast<nanoseconds>(
+             steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void pin_to_cpu(int cpu) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+// 가득 찼을 때 생산자가 기다리는 방법 (모든 큐 공통)
+inline void backoff(int &spins) {
+  if (++spins < lfq::SPINS_BEFORE_YIELD) {
+    lfq::cpuRelax();
+  } else {
+    spins = 0;
+    this_thread::yield();
+  }
+}
+
+// ==========================================
+// 채널: 큐 + 대기 전략 = push(들) / pop_batch(블로킹)
+// ==========================================
+
+template <class Queue, class Wait> struct LockFreeChannel {
+  Queue queue{QUEUE_CAPACITY};
+  Wait wait;
+
+  void push(Item *items, size_t count) {
+    int spins = 0;
+    size_t done = 0;
+    while (done < count) {
+      size_t n = count == 1 ? (size_t)queue.tryPush(items[0])
+                            : queue.tryPushBatch(items + done, count - done);
+      if (n == 0) {
+        backoff(spins);
+      }
+      done += n;
+    }
+    wait.notify();
+  }
+
+  size_t pop_batch(Item *out, size_t max) {
+    for (;;) {
+      size_t n = queue.tryPopBatch(out, max);
+      if (n > 0) {
+        return n;
+      }
+      wait.wait([this]() { return !queue.empty(); });
+    }
+  }
+};
+
+// eventfd: 소비자가 epoll_wait에서 잠듦 (리액터에 fd를 같이 등록하는 모양)
+template <class Queue> struct EpollChannel {
+  Queue queue{QUEUE_CAPACITY};
+  lfq::EventfdWait wait;
+  int epfd;
+
+  EpollChannel() : epfd(epoll_create1(EPOLL_CLOEXEC)) {
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = wait.fd();
+    epoll_ctl(epfd, EPOLL_CTL_ADD, wait.fd(), &ev);
+  }
+  ~EpollChannel() { close(epfd); }
+
+  void push(Item *items, size_t count) {
+    int spins = 0;
+    size_t done = 0;
+    while (done < count) {
+      size_t n = count == 1 ? (size_t)queue.tryPush(items[0])
+                            : queue.tryPushBatch(items + done, count - done);
+      if (n == 0) {
+        backoff(spins);
+      }
+      done += n;
+    }
+    wait.notify();
+  }
+
+  size_t pop_batch(Item *out, size_t max) {
+    for (;;) {
+      size_t n = queue.tryPopBatch(out, max);
+      if (n > 0) {
+        return n;
+      }
+      if (wait.arm([this]() { return !queue.empty(); })) {
+        struct epoll_event events[4];
+        epoll_wait(epfd, events, 4, -1);
+        wait.disarm();
+      }
+    }
+  }
+};
+
+// 기준선: 락 하나로 deque를 감쌈. 가득 차면 생산자도 condition_variable로 대기
+struct MutexChannel {
+  mutex lock;
+  condition_variable not_empty;
+  condition_variable not_full;
+  deque<Item> items;
+  int consumer_waiting = 0;
+  int producers_waiting = 0;
+
+  void push(Item *batch, size_t count) {
+    size_t done = 0;
+    while (done < count) {
+      unique_lock<mutex> guard(lock);
+      while (items.size() >= QUEUE_CAPACITY) {
+        producers_waiting++;
+        not_full.wait(guard);
+        producers_waiting--;
+      }
+      while (done < count && items.size() < QUEUE_CAPACITY) {
+        items.push_back(batch[done++]);
+      }
+      bool wake = consumer_waiting > 0;
+      guard.unlock();
+      if (wake) {
+        not_empty.notify_one();
+      }
+    }
+  }
+
+  size_t pop_batch(Item *out, size_t max) {
+    unique_lock<mutex> guard(lock);
+    while (items.empty()) {
+      consumer_waiting++;
+      not_empty.wait(guard);
+      consumer_waiting--;
+    }
+    size_t n = 0;
+    while (n < max && !items.empty()) {
+      out[n++] = items.front();
+      items.pop_front();
+    }
+    bool wake = producers_waiting > 0;
+    guard.unlock();
+    if (wake) {
+      not_full.notify_all();
+    }
+    return n;
+  }
+};
+
+// ==========================================
+// 측정
+// ==========================================
+
+struct Result {
+  double ops_per_sec = 0;
+  uint64_t p50_ns = 0;
+  uint64_t p99_ns = 0;
+  uint64_t p999_ns = 0;
+  bool verified = true;
+};
+
+/**
+ * 생산자 producers개가 각자 per_producer개씩 넣고, 소비자(이 함수를 부른
+ * 스레드와 별개)가 전부 꺼낼 때까지. latency = true 면 하나씩 간격을 두고 넣고
+ * 소비자가 지연을 기록
+ */
+template <class Channel>
+void run_case(Channel &channel, int producers, long long per_producer,
+              int batch, const vector<int> &producer_cpus, int consumer_cpu,
+              bool latency, Result &r) {
+  long long total = per_producer * producers;
+  vector<uint32_t> next_seq(producers, 0);
+  vector<uint64_t> samples;
+  if (latency) {
+    samples.reserve(total);
+  }
+  atomic<int> ready(0);
+  atomic<bool> go(false);
+  long long received = 0;
+
+  thread consumer([&]() {
+    pin_to_cpu(consumer_cpu);
+    ready.fetch_add(1);
+    Item out[MAX_BATCH];
+    while (received < total) {
+      size_t n = channel.pop_batch(out, MAX_BATCH);
+      uint64_t now = latency ? now_ns() : 0;
+      for (size_t i = 0; i < n; i++) {
+        const Item &item = out[i];
+        if (item.producer >= (uint32_t)producers ||
+            item.seq != next_seq[item.producer]) {
+          r.verified = false; // 유실, 중복, 순서 뒤바뀜
+        } else {
+          next_seq[item.producer]++;
+        }
+        if (latency) {
+          samples.push_back(now - item.stamp_ns);
+        }
+      }
+      received += n;
+    }
+  });
+
+  vector<thread> workers;
+  for (int p = 0; p < producers; p++) {
+    workers.emplace_back([&, p]() {
+      pin_to_cpu(producer_cpus[p]);
+      ready.fetch_add(1);
+      while (!go.load(memory_order_acquire)) {
+        this_thread::yield();
+      }
+      Item items[MAX_BATCH];
+      uint32_t seq = 0;
+      if (latency) {
+        for (long long i = 0; i < per_producer; i++) {
+          items[0].producer = p;
+          items[0].seq = seq++;
+          items[0].stamp_ns = now_ns();
+          channel.push(items, 1);
+          // 간격 동안 yield (같은 코어의 소비자에게 CPU를 넘김)
+          uint64_t until = items[0].stamp_ns + LATENCY_GAP_NS;
+          while (now_ns() < until) {
+            this_thread::yield();
+          }
+        }
+        return;
+      }
+      for (long long i = 0; i < per_producer; i += batch) {
+        int n = (int)min<long long>(batch, per_producer - i);
+        for (int k = 0; k < n; k++) {
+          items[k].producer = p;
+          items[k].seq = seq++;
+          items[k].stamp_ns = 0;
+        }
+        channel.push(items, n);
+      }
+    });
+  }
+
+  while (ready.load() < producers + 1) {
+    this_thread::yield();
+  }
+  auto start = steady_clock::now();
+  go.store(true, memory_order_release);
+  for (auto &w : workers) {
+    w.join();
+  }
+  consumer.join();
+  duration<double> elapsed = steady_clock::now() - start;
+
+  for (int p = 0; p < producers; p++) {
+    if (next_seq[p] != per_producer) {
+      r.verified = false;
+    }
+  }
+  if (latency) {
+    sort(samples.begin(), samples.end());
+    r.p50_ns = samples[samples.size() / 2];
+    r.p99_ns = samples[samples.size() * 99 / 100];
+    r.p999_ns = samples[samples.size() * 999 / 1000];
+  } else {
+    r.ops_per_sec = total / elapsed.count();
+  }
+}
+
+// 처리량과 지연을 각각 새 채널로 (앞 측정의 큐 상태를 끌고 오지 않게)
+template <class Channel>
+Result measure(int producers, long long items, long long latency_samples,
+               int batch, const vector<int> &producer_cpus, int consumer_cpu) {
+  Result r;
+  {
+    Channel channel;
+    run_case(channel, producers, items / producers, batch, producer_cpus,
+             consumer_cpu, false, r);
+  }
+  if (latency_samples > 0) {
+    Channel channel;
+    run_case(channel, producers, max(1LL, latency_samples / producers), 1,
+             producer_cpus, consumer_cpu, true, r);
+  }
+  return r;
+}
+
+template <class Queue>
+bool measure_wait(const string &wait, int producers, long long items,
+                  long long latency_samples, int batch,
+                  const vector<int> &producer_cpus, int consumer_cpu,
+                  Result &r) {
+  if (wait == "spin") {
+    r = measure<LockFreeChannel<Queue, lfq::SpinWait> >(
+        producers, items, latency_samples, batch, producer_cpus, consumer_cpu);
+  } else if (wait == "yield") {
+    r = measure<LockFreeChannel<Queue, lfq::YieldWait> >(
+        producers, items, latency_samples, batch, producer_cpus, consumer_cpu);
+  } else if (wait == "futex") {
+    r = measure<LockFreeChannel<Queue, lfq::FutexWait> >(
+        producers, items, latency_samples, batch, producer_cpus, consumer_cpu);
+  } else if (wait == "eventfd") {
+    r = measure<EpollChannel<Queue> >(producers, items, latency_samples, batch,
+                                      producer_cpus, consumer_cpu);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+vector<string> split(const string &text) {
+  vector<string> parts;
+  stringstream ss(text);
+  string part;
+  while (getline(ss, part, ',')) {
+    if (!part.empty()) {
+      parts.push_back(part);
+    }
+  }
+  return parts;
+}
+
+void print_row(const string &queue, const string &wait, int producers,
+               int batch, int producer_cpu, int consumer_cpu, const Result &r) {
+  cout << queue << "," << wait << "," << producers << "," << batch << ","
+       << producer_cpu << "," << consumer_cpu << ","
+       << (long long)r.ops_per_sec << "," << r.p50_ns << "," << r.p99_ns << ","
+       << r.p999_ns << "," << (r.verified ? "yes" : "NO") << endl;
+}
+
+int main(int argc, char *argv[]) {
+  long long items = 2000000;
+  long long latency_samples = 20000;
+  string queues = "spsc,mpsc,mutex";
+  string waits = "spin,yield,futex,eventfd";
+  string batches = "1,32";
+
+  if (argc >= 2) {
+    items = atoll(argv[1]);
+  }
+  if (argc >= 3) {
+    latency_samples = atoll(argv[2]);
+  }
+  if (argc >= 4) {
+    queues = argv[3];
+  }
+  if (argc >= 5) {
+    waits = argv[4];
+  }
+  if (argc >= 6) {
+    batches = argv[5];
+  }
+
+  int cpus = max(1, (int)thread::hardware_concurrency());
+  // 생산자 CPU 후보: 같은 코어, 옆 코어, 중간, 마지막 (중복 제거)
+  vector<int> placements;
+  for (int cpu : {0, 1, cpus / 2, cpus - 1}) {
+    if (cpu < cpus && find(placements.begin(), placements.end(), cpu) ==
+                          placements.end()) {
+      placements.push_back(cpu);
+    }
+  }
+  // 여러 생산자: 1개, 그리고 코어 수 (최소 2 - MPSC 경합을 보기 위해)
+  vector<int> producer_counts = {1, max(2, cpus - 1)};
+
+  cerr << "[*] cores=" << cpus << " capacity=" << QUEUE_CAPACITY
+       << " items=" << items << " latency_samples=" << latency_samples
+       << " gap=" << LATENCY_GAP_NS << "ns" << endl;
+  cout << "queue,wait,producers,batch,producer_cpu,consumer_cpu,ops_per_sec,"
+          "p50_ns,p99_ns,p999_ns,verified"
+       << endl;
+
+  const int consumer_cpu = 0;
+  for (const string &queue : split(queues)) {
+    for (int producers : producer_counts) {
+      if (queue == "spsc" && producers > 1) {
+        continue;
+      }
+      for (int placement : placements) {
+        vector<int> producer_cpus;
+        for (int p = 0; p < producers; p++) {
+          producer_cpus.push_back((placement + p) % cpus);
+        }
+        for (const string &b : split(batches)) {
+          int batch = max(1, min(MAX_BATCH, atoi(b.c_str())));
+          Result r;
+          if (queue == "mutex") {
+            r = measure<MutexChannel>(producers, items, latency_samples, batch,
+                                      producer_cpus, consumer_cpu);
+            print_row(queue, "condvar", producers, batch, placement,
+                      consumer_cpu, r);
+            continue;
+          }
+          for (const string &wait : split(waits)) {
+            bool known =
+                queue == "spsc"
+                    ? measure_wait<lfq::SpscQueue<Item> >(
+                          wait, producers, items, latency_samples, batch,
+                          producer_cpus, consumer_cpu, r)
+                    : measure_wait<lfq::MpscQueue<Item> >(
+                          wait, producers, items, latency_samples, batch,
+                          producer_cpus, consumer_cpu, r);
+            if (known) {
+              print_row(queue, wait, producers, batch, placement, consumer_cpu,
+                        r);
+            }
+          }
+        }
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,290 @@
+/**
+ * [Task 10] 읽기 위주 방 디렉터리: 에포크 회수 vs shared_mutex vs mutex
+ *
+ * 브로드캐스트 스레드(읽기) N개가 임의의 방 멤버 목록을 계속 순회하고,
+ * 쓰는 스레드 1개가 입장/퇴장을 흉내 냄 (세션 하나를 자기 방에 넣거나 뺌).
+ *
+ *   ebr          : rooms::RoomDirectory (불변 목록 + 포인터 교체 + 미룬 delete)
+ *   shared_mutex : std::shared_mutex + map<방, vector<세션>> (읽기는 shared_lock)
+ *   mutex        : std::mutex + 같은 map (비교 기준)
+ *
+ * CSV 열: impl,readers,write_gap_us,reads_per_sec,members_per_sec,
+ *         writes_per_sec,max_pending,verified
+ *   reads: 방 하나 순회 = 1 (브로드캐스트 한 번)
+ *   max_pending: retire 했지만 아직 못 지운 목록의 최대 개수 (ebr만)
+ *   verified: 읽는 도중 본 목록이 항상 정렬 + 자기 방 세션만 (해제된 메모리를
+ *             읽으면 깨짐), 끝난 뒤 목록 == 쓰는 쪽의 기록
+ *
+ * 컴파일: g++ -o room_dir_bench room_dir_bench.cpp -std=c++17 -O2 -pthread
+ * 실행: ./room_dir_bench [ms] [readers] [write_gaps_us]
+ * 예시: ./room_dir_bench 500 1,2,4,8 0,100 > room_dir.csv
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "room_directory.h" // [Task 10]
+
+using namespace std;
+using namespace std::chrono;
+
+const int ROOMS = 64;
+const int SESSIONS = 4096; // 세션 s의 방은 항상 s % ROOMS (검증용)
+
+// ==========================================
+// 락으로 보호하는 디렉터리 (흔한 구현)
+// ==========================================
+template <class Mutex, class ReadLock> class LockedDirectory {
+public:
+  template <typename Fn> size_t forEachMember(int roomId, Fn &&fn) {
+    ReadLock guard(lock_);
+    map<int, vector<int>>::const_iterator it = rooms_.find(roomId);
+    if (it == rooms_.end()) {
+      return 0;
+    }
+    for (int session : it->second) {
+      fn(session);
+    }
+    return it->second.size();
+  }
+
+  bool join(int session, int roomId) {
+    lock_guard<Mutex> guard(lock_);
+    vector<int> &members = rooms_[roomId];
+    vector<int>::iterator it =
+        lower_bound(members.begin(), members.end(), session);
+    if (it != members.end() && *it == session) {
+      return false;
+    }
+    members.insert(it, session);
+    return true;
+  }
+
+  // 세션은 항상 자기 방(s % ROOMS)에만 들어감 (벤치 전용 단순화)
+  bool leave(int session) {
+    lock_guard<Mutex> guard(lock_);
+    vector<int> &members = rooms_[session % ROOMS];
+    vector<int>::iterator it =
+        lower_bound(members.begin(), members.end(), session);
+    if (it == members.end() || *it != session) {
+      return false;
+    }
+    members.erase(it);
+    return true;
+  }
+
+private:
+  Mutex lock_;
+  map<int, vector<int>> rooms_;
+};
+
+typedef LockedDirectory<shared_mutex, shared_lock<shared_mutex>> SharedDirectory;
+typedef LockedDirectory<mutex, lock_guard<mutex>> MutexDirectory;
+
+// rooms::RoomDirectory는 생성자 인자가 필요해서 감쌈
+struct EbrDirectory : rooms::RoomDirectory {
+  EbrDirectory() : rooms::RoomDirectory(SESSIONS) {}
+};
+
+template <class Dir> constexpr bool uses_ebr() {
+  return is_base_of<rooms::RoomDirectory, Dir>::value;
+}
+
+struct Result {
+  double reads_per_sec;
+  double members_per_sec;
+  double writes_per_sec;
+  size_t max_pending;
+  bool verified;
+};
+
+// 방 하나 순회 + 검증. 멤버 수를 돌려줌
+template <class Dir>
+size_t read_room(Dir &dir, ebr::Reader *reader, int roomId, bool &ok) {
+  int prev = -1;
+  auto visit = [&](int session) {
+    if (session <= prev || session % ROOMS != roomId) {
+      ok = false;
+    }
+    prev = session;
+  };
+  if constexpr (uses_ebr<Dir>()) {
+    return dir.forEachMember(*reader, roomId, visit);
+  } else {
+    (void)reader;
+    return dir.forEachMember(roomId, visit);
+  }
+}
+
+template <class Dir> Result measure(int readers, int write_gap_us, int ms) {
+  Dir dir;
+  vector<bool> present(SESSIONS, false);
+  // 시작: 세션 절반이 입장한 상태 (방마다 ~32명)
+  for (int s = 0; s < SESSIONS; s += 2) {
+    dir.join(s, s % ROOMS);
+    present[s] = true;
+  }
+
+  // 읽는 쪽도 스스로 마감을 확인: shared_mutex는 읽기가 끊이지 않으면 쓰는
+  // 쪽이 락을 영영 못 잡음 (glibc rwlock 기본값은 읽기 우선)
+  auto start = steady_clock::now();
+  auto deadline = start + milliseconds(ms);
+  atomic<bool> running{true};
+  atomic<bool> all_ok{true};
+  vector<long long> reads(readers, 0), members(readers, 0);
+  vector<thread> threads;
+  for (int r = 0; r < readers; r++) {
+    threads.emplace_back([&, r]() {
+      ebr::Reader *reader = nullptr;
+      if constexpr (uses_ebr<Dir>()) {
+        reader = dir.attachReader();
+      }
+      uint32_t rng = 12345u + r * 7919u;
+      long long n = 0, m = 0;
+      bool ok = true;
+      while (running.load(memory_order_relaxed)) {
+        rng = rng * 1664525u + 1013904223u;
+        m += read_room(dir, reader, (int)((rng >> 8) % ROOMS), ok);
+        n++;
+        if ((n & 255) == 0 && steady_clock::now() >= deadline) {
+          break;
+        }
+      }
+      if constexpr (uses_ebr<Dir>()) {
+        dir.detachReader(reader);
+      }
+      reads[r] = n;
+      members[r] = m;
+      if (!ok) {
+        all_ok.store(false);
+      }
+    });
+  }
+
+  long long writes = 0;
+  uint32_t rng = 424242u;
+  while (steady_clock::now() < deadline) {
+    rng = rng * 1664525u + 1013904223u;
+    int s = (int)((rng >> 8) % SESSIONS);
+    if (present[s]) {
+      dir.leave(s);
+    } else {
+      dir.join(s, s % ROOMS);
+    }
+    present[s] = !present[s];
+    writes++;
+    if (write_gap_us > 0) {
+      this_thread::sleep_for(microseconds(write_gap_us));
+    }
+  }
+  running.store(false);
+  for (thread &t : threads) {
+    t.join();
+  }
+  double secs = duration<double>(steady_clock::now() - start).count();
+
+  // 끝난 뒤 목록 == 쓰는 쪽 기록
+  bool ok = all_ok.load();
+  ebr::Reader *reader = nullptr;
+  if constexpr (uses_ebr<Dir>()) {
+    reader = dir.attachReader();
+  }
+  for (int room = 0; room < ROOMS; room++) {
+    vector<int> seen;
+    auto collect = [&](int session) { seen.push_back(session); };
+    if constexpr (uses_ebr<Dir>()) {
+      dir.forEachMember(*reader, room, collect);
+    } else {
+      dir.forEachMember(room, collect);
+    }
+    vector<int> expected;
+    for (int s = room; s < SESSIONS; s += ROOMS) {
+      if (present[s]) {
+        expected.push_back(s);
+      }
+    }
+    ok = ok && seen == expected;
+  }
+
+  Result result;
+  long long total_reads = 0, total_members = 0;
+  for (int r = 0; r < readers; r++) {
+    total_reads += reads[r];
+    total_members += members[r];
+  }
+  result.reads_per_sec = total_reads / secs;
+  result.members_per_sec = total_members / secs;
+  result.writes_per_sec = writes / secs;
+  result.max_pending = 0;
+  if constexpr (uses_ebr<Dir>()) {
+    dir.detachReader(reader);
+    result.max_pending = dir.domain().maxPending();
+  }
+  result.verified = ok;
+  return result;
+}
+
+vector<string> split(const string &text) {
+  vector<string> out;
+  stringstream ss(text);
+  string item;
+  while (getline(ss, item, ',')) {
+    if (!item.empty()) {
+      out.push_back(item);
+    }
+  }
+  return out;
+}
+
+void print_row(const string &impl, int readers, int gap, const Result &r) {
+  cout << impl << "," << readers << "," << gap << "," << (long long)r.reads_per_sec
+       << "," << (long long)r.members_per_sec << ","
+       << (long long)r.writes_per_sec << "," << r.max_pending << ","
+       << (r.verified ? "yes" : "no") << endl;
+}
+
+int main(int argc, char *argv[]) {
+  int ms = 500;
+  string readers_list = "1,2,4,8";
+  string gaps = "0,100";
+  if (argc >= 2) {
+    ms = atoi(argv[1]);
+  }
+  if (argc >= 3) {
+    readers_list = argv[2];
+  }
+  if (argc >= 4) {
+    gaps = argv[3];
+  }
+
+  {
+    ebr::Domain probe;
+    cerr << "[*] cores=" << thread::hardware_concurrency() << " rooms=" << ROOMS
+         << " sessions=" << SESSIONS << " ms=" << ms << " membarrier="
+         << (probe.asymmetric() ? "yes" : "no (fence)") << endl;
+  }
+  cout << "impl,readers,write_gap_us,reads_per_sec,members_per_sec,"
+          "writes_per_sec,max_pending,verified"
+       << endl;
+  for (const string &g : split(gaps)) {
+    int gap = atoi(g.c_str());
+    for (const string &n : split(readers_list)) {
+      int readers = max(1, atoi(n.c_str()));
+      print_row("ebr", readers, gap, measure<EbrDirectory>(readers, gap, ms));
+      print_row("shared_mutex", readers, gap,
+                measure<SharedDirectory>(readers, gap, ms));
+      print_row("mutex", readers, gap, measure<MutexDirectory>(readers, gap, ms));
+    }
+  }
+  return 0;
+}
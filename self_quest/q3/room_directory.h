@@ -0,0 +1,227 @@
+/**
+ * [Task 10] 읽기 위주 방 디렉터리 (헤더 전용, C++17)
+ *
+ *   rooms::RoomDirectory dir(4096);          // 세션 번호 0 ~ 4095
+ *   ebr::Reader *me = dir.attachReader();    // 브로드캐스트하는 스레드마다
+ *
+ *   dir.join(session, roomId);               // 쓰기: 드묾 (입장/퇴장)
+ *   dir.forEachMember(*me, roomId, [&](int s) { send(s, ...); });   // 읽기: 매 메시지
+ *
+ * 채팅 서버가 여러 스레드가 되면 브로드캐스트마다 방 멤버 목록을 읽어야 하는데,
+ * 멤버는 거의 안 바뀐다. 읽을 때마다 락(shared_mutex라도 카운터에 lock add)을
+ * 잡는 대신:
+ * - 방마다 멤버 목록(Members)은 공개한 뒤로 절대 고치지 않음. 바꿀 때는 복사본을
+ *   만들어 포인터를 교체하고 옛것은 ebr::Domain에 retire (읽는 중인 스레드가
+ *   다 나간 뒤 delete)
+ * - 방 id -> 방 칸(RoomSlot) 색인도 같은 방식. 방 칸 자체는 디렉터리가 죽을
+ *   때까지 유지 -> 멤버만 바뀔 때는 색인을 복사하지 않음
+ * - 읽는 쪽: ReadGuard -> 색인 load -> 이진 탐색 -> 멤버 load -> 순회.
+ *   원자적 RMW / 락 / 펜스 없음 (x86에서는 전부 일반 mov)
+ * - 세션 -> 방은 세션 번호로 찾는 고정 배열 (int 하나라서 회수할 것이 없음)
+ * - 쓰는 쪽끼리는 mutex 하나로 직렬화. 쓰기 하나 = 목록 복사 O(방 인원)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "epoch_reclaim.h" // [Task 10]
+
+namespace rooms {
+
+// 공개된 뒤로 불변 (정렬된 세션 번호)
+struct Members {
+  int roomId;
+  std::vector<int> sessions;
+};
+
+struct RoomSlot {
+  int roomId;
+  std::atomic<const Members *> members{nullptr};
+};
+
+// 공개된 뒤로 불변 (ids[i]의 칸이 slots[i], ids 정렬)
+struct RoomIndex {
+  std::vector<int> ids;
+  std::vector<RoomSlot *> slots;
+};
+
+class RoomDirectory {
+public:
+  explicit RoomDirectory(int maxSessions)
+      : sessionRoom_(new std::atomic<int>[maxSessions]),
+        maxSessions_(maxSessions) {
+    for (int i = 0; i < maxSessions; i++) {
+      sessionRoom_[i].store(-1, std::memory_order_relaxed);
+    }
+    index_.store(new RoomIndex(), std::memory_order_release);
+  }
+
+  // 읽는 스레드가 모두 detach 한 뒤에 파괴할 것
+  ~RoomDirectory() {
+    domain_.synchronize();
+    for (const std::unique_ptr<RoomSlot> &slot : slots_) {
+      delete slot->members.load(std::memory_order_relaxed);
+    }
+    delete index_.load(std::memory_order_relaxed);
+  }
+
+  RoomDirectory(const RoomDirectory &) = delete;
+  RoomDirectory &operator=(const RoomDirectory &) = delete;
+
+  ebr::Reader *attachReader() { return domain_.attach(); }
+  void detachReader(ebr::Reader *reader) { domain_.detach(reader); }
+
+  // ==========================================
+  // 읽기
+  // ==========================================
+  /**
+   * 방 멤버마다 fn(session). 도는 동안 목록이 바뀌어도 시작할 때의 목록을 끝까지
+   * 봄 (바뀐 내용은 다음 호출부터)
+   * @return 멤버 수 (방이 없으면 0)
+   */
+  template <typename Fn>
+  size_t forEachMember(ebr::Reader &reader, int roomId, Fn &&fn) const {
+    ebr::ReadGuard guard(reader);
+    const Members *members = find(roomId);
+    if (members == nullptr) {
+      return 0;
+    }
+    for (int session : members->sessions) {
+      fn(session);
+    }
+    return members->sessions.size();
+  }
+
+  bool contains(ebr::Reader &reader, int roomId, int session) const {
+    ebr::ReadGuard guard(reader);
+    const Members *members = find(roomId);
+    return members != nullptr &&
+           std::binary_search(members->sessions.begin(),
+                              members->sessions.end(), session);
+  }
+
+  // 세션이 있는 방 (-1: 없음). 락/가드 불필요
+  int roomOf(int session) const {
+    if (session < 0 || session >= maxSessions_) {
+      return -1;
+    }
+    return sessionRoom_[session].load(std::memory_order_acquire);
+  }
+
+  // ==========================================
+  // 쓰기
+  // ==========================================
+  /**
+   * 방 이동 (있던 방에서는 빠짐). 방은 처음 들어올 때 생김
+   * @return false: 세션 번호 범위 밖, 또는 이미 그 방
+   */
+  bool join(int session, int roomId) {
+    if (session < 0 || session >= maxSessions_) {
+      return false;
+    }
+    std::lock_guard<std::mutex> guard(writeLock_);
+    int oldRoom = sessionRoom_[session].load(std::memory_order_relaxed);
+    if (oldRoom == roomId) {
+      return false;
+    }
+    if (oldRoom >= 0) {
+      removeLocked(oldRoom, session);
+    }
+    RoomSlot *slot = slotLocked(roomId);
+    const Members *old = slot->members.load(std::memory_order_relaxed);
+    Members *fresh = new Members{roomId, old->sessions};
+    fresh->sessions.insert(std::upper_bound(fresh->sessions.begin(),
+                                            fresh->sessions.end(), session),
+                           session);
+    publishLocked(slot, fresh);
+    sessionRoom_[session].store(roomId, std::memory_order_release);
+    return true;
+  }
+
+  // @return false: 어느 방에도 없음
+  bool leave(int session) {
+    if (session < 0 || session >= maxSessions_) {
+      return false;
+    }
+    std::lock_guard<std::mutex> guard(writeLock_);
+    int oldRoom = sessionRoom_[session].load(std::memory_order_relaxed);
+    if (oldRoom < 0) {
+      return false;
+    }
+    removeLocked(oldRoom, session);
+    sessionRoom_[session].store(-1, std::memory_order_release);
+    return true;
+  }
+
+  ebr::Domain &domain() { return domain_; }
+
+private:
+  // 읽기 구역 안에서만 부름
+  const Members *find(int roomId) const {
+    const RoomIndex *index = index_.load(std::memory_order_acquire);
+    std::vector<int>::const_iterator it =
+        std::lower_bound(index->ids.begin(), index->ids.end(), roomId);
+    if (it == index->ids.end() || *it != roomId) {
+      return nullptr;
+    }
+    return index->slots[it - index->ids.begin()]->members.load(
+        std::memory_order_acquire);
+  }
+
+  // 방 칸 찾기, 없으면 색인을 복사해서 추가
+  RoomSlot *slotLocked(int roomId) {
+    const RoomIndex *index = index_.load(std::memory_order_relaxed);
+    std::vector<int>::const_iterator it =
+        std::lower_bound(index->ids.begin(), index->ids.end(), roomId);
+    size_t pos = it - index->ids.begin();
+    if (it != index->ids.end() && *it == roomId) {
+      return index->slots[pos];
+    }
+
+    slots_.emplace_back(new RoomSlot());
+    RoomSlot *slot = slots_.back().get();
+    slot->roomId = roomId;
+    slot->members.store(new Members{roomId, {}}, std::memory_order_relaxed);
+
+    RoomIndex *fresh = new RoomIndex(*index);
+    fresh->ids.insert(fresh->ids.begin() + pos, roomId);
+    fresh->slots.insert(fresh->slots.begin() + pos, slot);
+    index_.store(fresh, std::memory_order_release); // 칸 초기화 -> 공개
+    domain_.retire(index);
+    return slot;
+  }
+
+  void removeLocked(int roomId, int session) {
+    RoomSlot *slot = slotLocked(roomId);
+    const Members *old = slot->members.load(std::memory_order_relaxed);
+    Members *fresh = new Members{roomId, {}};
+    fresh->sessions.reserve(old->sessions.size());
+    for (int s : old->sessions) {
+      if (s != session) {
+        fresh->sessions.push_back(s);
+      }
+    }
+    publishLocked(slot, fresh);
+  }
+
+  void publishLocked(RoomSlot *slot, const Members *fresh) {
+    const Members *old = slot->members.load(std::memory_order_relaxed);
+    slot->members.store(fresh, std::memory_order_release);
+    domain_.retire(old);
+  }
+
+  ebr::Domain domain_;
+  std::atomic<const RoomIndex *> index_{nullptr};
+  std::unique_ptr<std::atomic<int>[]> sessionRoom_;
+  int maxSessions_;
+
+  std::mutex writeLock_;
+  std::vector<std::unique_ptr<RoomSlot>> slots_; // 방 칸 소유 (쓰는 쪽만)
+};
+
+} // namespace rooms
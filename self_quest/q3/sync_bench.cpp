@@ -0,0 +1,419 @@
+/**
+ * [Task 5] 경합 스케일링 벤치마크 (Contention Scaling)
+ *
+ * compare_mutex_atomic.cpp 는 스레드 10개, 임계 영역 길이 100으로 고정하고
+ * unsafe / mutex / atomic 세 가지만 비교한다. 여기서는
+ *   - 스레드 수: 1, 2, 4, ... 최대 (기본: 코어 수)
+ *   - 임계 영역 길이: do_some_work(k)의 k (기본 0, 10, 100, 1000)
+ * 를 훑으면서 동기화 방식별 초당 연산 수와 공정성(스레드별 몫)을 CSV로 출력한다.
+ *
+ *   mutex         : std::mutex (경합 시 futex로 잠듦)
+ *   ttas          : test-and-test-and-set 스핀락 + 지수 백오프
+ *   ticket        : 티켓 락 (FIFO, 대기 순서 = 번호표)
+ *   mcs           : MCS 큐 락 (대기자마다 자기 노드에서만 스핀)
+ *   faa_relaxed / faa_acq_rel / faa_seq_cst : atomic fetch_add (메모리 순서별)
+ *   sharded       : 스레드별 카운터 (캐시 라인 크기로 패딩), 읽을 때 합산
+ *
+ * 락 계열은 임계 영역 안에서 일하고(do_some_work + 카운터 증가), 락이 없는
+ * 계열(faa, sharded)은 같은 일을 한 뒤 카운터만 원자적으로 증가시킨다.
+ *
+ * CSV 열:
+ *   ops_per_sec : 전체 스레드 합계
+ *   min_share / max_share : 스레드 몫 / 공평한 몫 (1.0 = 공평, 0 = 굶음)
+ *   jain        : Jain 공정성 지수 (1.0 = 완전 공평, 1/N = 한 스레드 독점)
+ *   verified    : 카운터 최종값 == 스레드들이 센 연산 수
+ *
+ * 스핀락은 코어보다 스레드가 많으면 락 주인이 선점된 동안 나머지가 헛돈다.
+ * 그래서 일정 횟수 이상 돌면 yield 한다 (그래도 ticket/mcs는 순서가 고정이라
+ * 다음 차례가 잠들어 있으면 모두 기다림 -> 코어 수 이상에서 급락).
+ *
+ * 컴파일: g++ -o sync_bench sync_bench.cpp -std=c++17 -O2 -pthread
+ * 실행: ./sync_bench [duration_ms] [max_threads] [cs_list] [primitives]
+ * 예시: ./sync_bench 300 8 0,100 mutex,ttas,mcs > sync.csv
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <new> // hardware_destructive_interference_size
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+#ifdef __cpp_lib_hardware_interference_size
+const size_t CACHE_LINE = hardware_destructive_interference_size;
+#else
+const size_t CACHE_LINE = 64;
+#endif
+
+const int SPINS_BEFORE_YIELD = 1024; // 이만큼 돌아도 못 잡으면 코어를 양보
+const int MAX_BACKOFF = 1024;        // TTAS 백오프 상한 (pause 횟수)
+
+// 임계 영역 안에서 하는 일 (compare_mutex_atomic.cpp 의 do_some_work와 같음)
+void do_some_work(int iterations) {
+  volatile int dummy = 0;
+  for (int k = 0; k < iterations; ++k) {
+    dummy++;
+  }
+}
+
+// 스핀 대기 한 번 (하이퍼스레드 형제에게 자원 양보 + 전력 절약)
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+// 스핀 횟수를 세다가 한도를 넘으면 yield (코어보다 스레드가 많을 때 대비)
+inline void spin_wait(int &spins) {
+  if (++spins < SPINS_BEFORE_YIELD) {
+    cpu_relax();
+  } else {
+    spins = 0;
+    this_thread::yield();
+  }
+}
+
+// ==========================================
+// 락 구현
+// ==========================================
+
+// TTAS: 읽기(test)로 기다리다가 풀렸을 때만 exchange(test-and-set)
+// -> 기다리는 동안 캐시 라인을 Shared로 공유 (exchange 폭풍 X)
+struct TtasLock {
+  atomic<bool> locked{false};
+
+  void lock() {
+    int backoff = 1;
+    int spins = 0;
+    for (;;) {
+      while (locked.load(memory_order_relaxed)) {
+        spin_wait(spins);
+      }
+      if (!locked.exchange(true, memory_order_acquire)) {
+        return;
+      }
+      // 잡으려다 진 경우: 잠깐 물러나서 다음 시도가 몰리지 않게
+      for (int i = 0; i < backoff; ++i) {
+        cpu_relax();
+      }
+      backoff = min(backoff * 2, MAX_BACKOFF);
+    }
+  }
+
+  void unlock() { locked.store(false, memory_order_release); }
+};
+
+// 티켓 락: 번호표(next)를 뽑고 내 번호가 불릴(serving) 때까지 대기 -> FIFO
+// next와 serving을 다른 캐시 라인에 둬서 번호표 뽑기가 대기자를 흔들지 않게
+struct TicketLock {
+  alignas(CACHE_LINE) atomic<unsigned> next{0};
+  alignas(CACHE_LINE) atomic<unsigned> serving{0};
+
+  void lock() {
+    unsigned my = next.fetch_add(1, memory_order_relaxed);
+    int spins = 0;
+    while (serving.load(memory_order_acquire) != my) {
+      spin_wait(spins);
+    }
+  }
+
+  void unlock() {
+    serving.store(serving.load(memory_order_relaxed) + 1,
+                  memory_order_release);
+  }
+};
+
+// MCS 큐 락: 대기자가 각자 자기 노드(locked)에서만 스핀 -> 락이 풀릴 때
+// 다음 대기자 한 명의 캐시 라인만 무효화됨 (TTAS/티켓은 대기자 전원)
+struct alignas(CACHE_LINE) McsNode {
+  atomic<McsNode *> next{nullptr};
+  atomic<bool> locked{false};
+};
+
+struct McsLock {
+  atomic<McsNode *> tail{nullptr};
+
+  void lock(McsNode &node) {
+    node.next.store(nullptr, memory_order_relaxed);
+    node.locked.store(true, memory_order_relaxed);
+    McsNode *prev = tail.exchange(&node, memory_order_acq_rel);
+    if (prev == nullptr) {
+      return; // 대기자 없음
+    }
+    prev->next.store(&node, memory_order_release);
+    int spins = 0;
+    while (node.locked.load(memory_order_acquire)) {
+      spin_wait(spins);
+    }
+  }
+
+  void unlock(McsNode &node) {
+    McsNode *succ = node.next.load(memory_order_acquire);
+    if (succ == nullptr) {
+      McsNode *expected = &node;
+      if (tail.compare_exchange_strong(expected, nullptr,
+                                       memory_order_acq_rel)) {
+        return; // 내가 마지막
+      }
+      // 누군가 tail을 바꿨지만 아직 prev->next를 안 씀 -> 기다림
+      int spins = 0;
+      while ((succ = node.next.load(memory_order_acquire)) == nullptr) {
+        spin_wait(spins);
+      }
+    }
+    succ->locked.store(false, memory_order_release);
+  }
+};
+
+// ==========================================
+// 벤치마크 대상 (op: 연산 1회 = 일 + 카운터 증가)
+// ==========================================
+
+// 스레드별 상태 (다른 스레드와 캐시 라인을 공유하지 않게 패딩)
+struct alignas(CACHE_LINE) ThreadSlot {
+  int index; // 스레드 번호 (sharded의 칸 번호)
+  long long ops;
+  McsNode node; // mcs 전용
+};
+
+template <class Lock> struct LockedCounter {
+  Lock lock;
+  alignas(CACHE_LINE) long long counter = 0;
+
+  void op(ThreadSlot &, int work) {
+    lock_guard<Lock> guard(lock);
+    do_some_work(work);
+    counter++;
+  }
+  long long total() { return counter; }
+};
+
+struct McsCounter {
+  McsLock lock;
+  alignas(CACHE_LINE) long long counter = 0;
+
+  void op(ThreadSlot &slot, int work) {
+    lock.lock(slot.node);
+    do_some_work(work);
+    counter++;
+    lock.unlock(slot.node);
+  }
+  long long total() { return counter; }
+};
+
+template <memory_order Order> struct FetchAddCounter {
+  alignas(CACHE_LINE) atomic<long long> counter{0};
+
+  void op(ThreadSlot &, int work) {
+    do_some_work(work);
+    counter.fetch_add(1, Order);
+  }
+  long long total() { return counter.load(); }
+};
+
+// 스레드별 칸에 혼자 씀 -> 원자적 RMW(lock add) 없이 load + store
+// 칸마다 캐시 라인 하나 -> 다른 코어와 라인 핑퐁 X, 합계는 읽을 때 계산
+struct ShardedCounter {
+  struct alignas(CACHE_LINE) Shard {
+    atomic<long long> value{0};
+  };
+  vector<Shard> shards;
+
+  explicit ShardedCounter(int threads) : shards(threads) {}
+
+  void op(ThreadSlot &slot, int work) {
+    do_some_work(work);
+    atomic<long long> &v = shards[slot.index].value;
+    v.store(v.load(memory_order_relaxed) + 1, memory_order_relaxed);
+  }
+  long long total() {
+    long long sum = 0;
+    for (auto &s : shards) {
+      sum += s.value.load(memory_order_relaxed);
+    }
+    return sum;
+  }
+};
+
+// ==========================================
+// 실행 도우미
+// ==========================================
+
+struct Result {
+  double ops_per_sec;
+  double min_share;
+  double max_share;
+  double jain;
+  bool verified;
+};
+
+// 모든 스레드가 준비되면 동시에 출발, duration_ms 동안 돌고 멈춤
+template <class Bench>
+Result run_case(Bench &bench, vector<ThreadSlot> &slots, int threads,
+                int work, int duration_ms) {
+  atomic<int> ready(0);
+  atomic<bool> go(false);
+  atomic<bool> stop(false);
+
+  vector<thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t]() {
+      ThreadSlot &slot = slots[t];
+      slot.index = t;
+      slot.ops = 0;
+      ready.fetch_add(1);
+      while (!go.load(memory_order_acquire)) {
+        this_thread::yield();
+      }
+      while (!stop.load(memory_order_relaxed)) {
+        bench.op(slot, work);
+        slot.ops++;
+      }
+    });
+  }
+
+  while (ready.load() < threads) {
+    this_thread::yield();
+  }
+  auto start = steady_clock::now();
+  go.store(true, memory_order_release);
+  this_thread::sleep_for(milliseconds(duration_ms));
+  stop.store(true, memory_order_relaxed);
+  for (auto &w : workers) {
+    w.join();
+  }
+  duration<double> elapsed = steady_clock::now() - start;
+
+  long long total = 0;
+  double sum_sq = 0;
+  long long min_ops = slots[0].ops;
+  long long max_ops = slots[0].ops;
+  for (int t = 0; t < threads; ++t) {
+    total += slots[t].ops;
+    sum_sq += (double)slots[t].ops * slots[t].ops;
+    min_ops = min(min_ops, slots[t].ops);
+    max_ops = max(max_ops, slots[t].ops);
+  }
+
+  Result r;
+  r.ops_per_sec = total / elapsed.count();
+  double fair = (double)total / threads;
+  r.min_share = fair > 0 ? min_ops / fair : 0;
+  r.max_share = fair > 0 ? max_ops / fair : 0;
+  r.jain = sum_sq > 0 ? (double)total * total / (threads * sum_sq) : 0;
+  r.verified = bench.total() == total;
+  return r;
+}
+
+void print_row(const string &name, int threads, int work, const Result &r) {
+  cout << name << "," << threads << "," << work << "," << (long long)r.ops_per_sec
+       << "," << 1e9 / r.ops_per_sec * threads << "," << r.min_share << ","
+       << r.max_share << "," << r.jain << "," << (r.verified ? "yes" : "NO")
+       << endl;
+}
+
+// 대상마다 새 객체 (이전 측정의 캐시 상태/카운터를 끌고 오지 않게)
+void run_primitive(const string &name, int threads, int work, int duration_ms) {
+  vector<ThreadSlot> slots(threads);
+  Result r;
+  if (name == "mutex") {
+    LockedCounter<mutex> b;
+    r = run_case(b, slots, threads, work, duration_ms);
+  } else if (name == "ttas") {
+    LockedCounter<TtasLock> b;
+    r = run_case(b, slots, threads, work, duration_ms);
+  } else if (name == "ticket") {
+    LockedCounter<TicketLock> b;
+    r = run_case(b, slots, threads, work, duration_ms);
+  } else if (name == "mcs") {
+    McsCounter b;
+    r = run_case(b, slots, threads, work, duration_ms);
+  } else if (name == "faa_relaxed") {
+    FetchAddCounter<memory_order_relaxed> b;
+    r = run_case(b, slots, threads, work, duration_ms);
+  } else if (name == "faa_acq_rel") {
+    FetchAddCounter<memory_order_acq_rel> b;
+    r = run_case(b, slots, threads, work, duration_ms);
+  } else if (name == "faa_seq_cst") {
+    FetchAddCounter<memory_order_seq_cst> b;
+    r = run_case(b, slots, threads, work, duration_ms);
+  } else if (name == "sharded") {
+    ShardedCounter b(threads);
+    r = run_case(b, slots, threads, work, duration_ms);
+  } else {
+    cerr << "[!] unknown primitive: " << name << endl;
+    return;
+  }
+  print_row(name, threads, work, r);
+}
+
+vector<string> split(const string &text) {
+  vector<string> items;
+  stringstream ss(text);
+  string item;
+  while (getline(ss, item, ',')) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+int main(int argc, char *argv[]) {
+  int duration_ms = 500;
+  int max_threads = (int)thread::hardware_concurrency();
+  string cs_list = "0,10,100,1000";
+  string primitives =
+      "mutex,ttas,ticket,mcs,faa_relaxed,faa_acq_rel,faa_seq_cst,sharded";
+
+  if (argc >= 2) {
+    duration_ms = atoi(argv[1]);
+  }
+  if (argc >= 3) {
+    max_threads = atoi(argv[2]);
+  }
+  if (argc >= 4) {
+    cs_list = argv[3];
+  }
+  if (argc >= 5) {
+    primitives = argv[4];
+  }
+  if (max_threads <= 0) {
+    max_threads = 1;
+  }
+
+  // 스레드 수: 1, 2, 4, ... 그리고 최대값
+  vector<int> thread_counts;
+  for (int n = 1; n < max_threads; n *= 2) {
+    thread_counts.push_back(n);
+  }
+  thread_counts.push_back(max_threads);
+
+  cerr << "[*] cores=" << thread::hardware_concurrency()
+       << " cache_line=" << CACHE_LINE << " duration=" << duration_ms << "ms"
+       << endl;
+  cout << "primitive,threads,cs_work,ops_per_sec,ns_per_op_per_thread,"
+          "min_share,max_share,jain,verified"
+       << endl;
+
+  for (const string &cs : split(cs_list)) {
+    int work = atoi(cs.c_str());
+    for (int threads : thread_counts) {
+      for (const string &name : split(primitives)) {
+        run_primitive(name, threads, work, duration_ms);
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,612 @@
+/**
+ * [Task 9] 작업 훔치기(work-stealing) 스레드 풀 (헤더 전용, C++11 이상)
+ *
+ *   wsp::ThreadPool pool(4);                        // 워커 4개 (고정)
+ *   pool.submit([] { compress(...); });             // 아무 워커나
+ *   pool.submit([] { ... }, conn->fd);              // 친화 힌트: fd % 4 번 워커
+ *   pool.submitBatch(tasks);                        // 워커별로 나눠 락 한 번씩
+ *   pool.parallelFor(0, n, 256, [&](size_t lo, size_t hi) { ... });  // 끝까지 대기
+ *
+ *   wsp::CompletionQueue<Done> done(4096);          // 결과를 리액터로 돌려보냄
+ *   epoll_ctl(ADD, done.fd(), EPOLLIN)              // 워커: done.post(result)
+ *   while ((n = done.drain(out, 64)) > 0) { ... }   // 리액터: fd가 깨우면
+ *
+ * - 워커마다 Chase-Lev 덱: 주인은 아래(bottom)에서 넣고 빼고 (LIFO, 캐시에 남은
+ *   최근 작업부터), 한가한 워커는 위(top)에서 CAS로 훔침 (FIFO, 오래된 = 보통
+ *   큰 작업). 주인의 push/pop은 덱이 거의 빌 때만 CAS
+ * - 풀 밖의 스레드(리액터)는 덱에 못 넣음 (주인 전용) -> 워커별 inbox(mutex +
+ *   vector)에 넣고, 워커가 inbox를 통째로 자기 덱으로 옮김. 배치 제출은 워커당
+ *   락 한 번
+ * - 워커 안에서 submit하면 자기 덱에 바로 (락 X) -> 재귀 분할 작업에 유리
+ * - 일이 없으면 condition_variable로 잠듦. 제출하는 쪽은 잠든 워커가 있을 때만
+ *   락을 잡고 깨움 (lockfree_queue.h의 FutexWait와 같은 "표시 -> 재확인" 약속)
+ * - 작업은 예외를 던지면 안 됨 (워커 스레드가 종료됨)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <pthread.h>
+#include <sched.h>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "lockfree_queue.h" // CompletionQueue = MpscQueue + EventfdWait
+
+namespace wsp {
+
+using percpu::CACHE_LINE;
+
+typedef std::function<void()> Task;
+
+// ==========================================
+// Chase-Lev 덱 (Lê et al. 2013의 C11 메모리 순서)
+// ==========================================
+
+/**
+ * 원소는 Task* (포인터라서 칸을 atomic으로 읽고 씀 -> 도둑이 주인과 동시에
+ * 읽어도 데이터 경쟁 X). 가득 차면 주인이 두 배 배열로 옮기고, 옛 배열은
+ * 도둑이 아직 읽고 있을 수 있어서 덱이 없어질 때 해제
+ */
+class WorkDeque {
+public:
+  explicit WorkDeque(size_t capacity = 256)
+      : array_(new Array(lfq::roundUpPow2(capacity))) {}
+
+  ~WorkDeque() {
+    delete array_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < retired_.size(); i++) {
+      delete retired_[i];
+    }
+  }
+
+  WorkDeque(const WorkDeque &) = delete;
+  WorkDeque &operator=(const WorkDeque &) = delete;
+
+  // ---- 주인 워커 전용 ----
+
+  void push(Task *task) {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_acquire);
+    Array *a = array_.load(std::memory_order_relaxed);
+    if (b - t > (int64_t)a->mask) {
+      a = grow(a, t, b);
+    }
+    a->put(b, task);
+    // 원논문은 release fence + relaxed store. x86에서는 같은 코드이고
+    // ThreadSanitizer가 fence를 모르므로 store 자체를 release로
+    bottom_.store(b + 1, std::memory_order_release);
+  }
+
+  Task *pop() {
+    int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    Array *a = array_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    if (t > b) {
+      bottom_.store(b + 1, std::memory_order_relaxed); // 비었음
+      return nullptr;
+    }
+    Task *task = a->get(b);
+    if (t == b) {
+      // 마지막 하나: 도둑과 top CAS로 겨룸
+      if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        task = nullptr;
+      }
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return task;
+  }
+
+  // ---- 다른 워커 (도둑) ----
+
+  // nullptr: 비었거나 다른 도둑/주인에게 짐 (다시 시도할지는 호출자가)
+  Task *steal() {
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t >= b) {
+      return nullptr;
+    }
+    Array *a = array_.load(std::memory_order_acquire);
+    Task *task = a->get(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return task;
+  }
+
+  bool empty() const {
+    return bottom_.load(std::memory_order_seq_cst) <=
+           top_.load(std::memory_order_seq_cst);
+  }
+
+private:
+  struct Array {
+    size_t mask;
+    std::unique_ptr<std::atomic<Task *>[]> slots;
+
+    explicit Array(size_t capacity)
+        : mask(capacity - 1), slots(new std::atomic<Task *>[capacity]) {}
+    Task *get(int64_t i) const {
+      return slots[i & mask].load(std::memory_order_relaxed);
+    }
+    void put(int64_t i, Task *task) {
+      slots[i & mask].store(task, std::memory_order_relaxed);
+    }
+  };
+
+  Array *grow(Array *old, int64_t t, int64_t b) {
+    Array *bigger = new Array((old->mask + 1) * 2);
+    for (int64_t i = t; i < b; i++) {
+      bigger->put(i, old->get(i));
+    }
+    retired_.push_back(old);
+    array_.store(bigger, std::memory_order_release);
+    return bigger;
+  }
+
+  alignas(CACHE_LINE) std::atomic<int64_t> top_{0};    // 도둑들이 CAS
+  alignas(CACHE_LINE) std::atomic<int64_t> bottom_{0}; // 주인만 씀
+  std::atomic<Array *> array_;
+  std::vector<Array *> retired_; // 주인만 씀
+};
+
+// ==========================================
+// 카운트다운 래치 (parallelFor / 벤치마크의 "다 끝날 때까지")
+// ==========================================
+
+class Latch {
+public:
+  explicit Latch(size_t count) : remaining_(count) {}
+
+  void countDown() {
+    if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      std::lock_guard<std::mutex> guard(lock_);
+      done_.notify_all();
+    }
+  }
+
+  bool done() const { return remaining_.load(std::memory_order_acquire) == 0; }
+
+  void wait() {
+    std::unique_lock<std::mutex> guard(lock_);
+    while (!done()) {
+      done_.wait(guard);
+    }
+  }
+
+private:
+  std::atomic<size_t> remaining_;
+  std::mutex lock_;
+  std::condition_variable done_;
+};
+
+// ==========================================
+// 스레드 풀
+// ==========================================
+
+class ThreadPool;
+
+// 지금 스레드가 어느 풀의 몇 번 워커인지 (풀 밖이면 pool = nullptr)
+struct CurrentWorker {
+  ThreadPool *pool;
+  int index;
+};
+
+inline CurrentWorker &currentWorker() {
+  static thread_local CurrentWorker current = {nullptr, -1};
+  return current;
+}
+
+class ThreadPool {
+public:
+  /**
+   * @param workers: 0이면 코어 수
+   * @param pinWorkers: 워커 i를 CPU (i % 코어 수)에 고정 (친화 힌트가 같은
+   *        코어의 캐시로 이어지게)
+   */
+  explicit ThreadPool(int workers = 0, bool pinWorkers = false)
+      : count_(workers > 0 ? workers
+                           : (int)std::max(1u,
+                                           std::thread::hardware_concurrency())),
+        workers_(nullptr) {
+    // Worker는 캐시 라인 정렬 (C++11의 new는 정렬을 보장하지 않으므로
+    // per_cpu.h와 같이 posix_memalign + placement new)
+    void *memory = nullptr;
+    if (posix_memalign(&memory, CACHE_LINE, sizeof(Worker) * count_) != 0) {
+      throw std::bad_alloc();
+    }
+    workers_ = static_cast<Worker *>(memory);
+    for (int i = 0; i < count_; i++) {
+      new (&workers_[i]) Worker();
+    }
+    for (int i = 0; i < count_; i++) {
+      workers_[i].thread = std::thread(&ThreadPool::workerLoop, this, i,
+                                       pinWorkers);
+    }
+  }
+
+  // 이미 제출된 작업은 전부 실행한 뒤 종료
+  ~ThreadPool() {
+    stopping_.store(true, std::memory_order_seq_cst);
+    wakeAll();
+    for (int i = 0; i < count_; i++) {
+      workers_[i].thread.join();
+    }
+    for (int i = 0; i < count_; i++) {
+      workers_[i].~Worker();
+    }
+    free(workers_);
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  int size() const { return count_; }
+
+  /**
+   * @param affinity: -1이면 아무 워커 (워커 안에서 부르면 자기 덱, 밖이면
+   *        돌아가며), 0 이상이면 (affinity % size)번 워커의 inbox.
+   *        힌트일 뿐 - 그 워커가 바쁘면 다른 워커가 훔쳐 감
+   */
+  void submit(Task fn, int affinity = -1) {
+    Task *task = new Task(std::move(fn));
+    CurrentWorker &current = currentWorker();
+    if (affinity < 0 && current.pool == this) {
+      workers_[current.index].deque.push(task);
+    } else {
+      Worker &target = workers_[pickTarget(affinity)];
+      std::lock_guard<std::mutex> guard(target.inboxLock);
+      target.inbox.push_back(task);
+      target.inboxSize.store(target.inbox.size(), std::memory_order_relaxed);
+    }
+    wakeOne();
+  }
+
+  /**
+   * 여러 개를 한 번에: affinity가 있으면 그 워커 inbox에 락 한 번,
+   * 없으면 워커 수만큼 연속 구간으로 나눠 워커당 락 한 번 (워커 안에서
+   * 부르면 자기 덱). tasks는 비워짐
+   */
+  void submitBatch(std::vector<Task> &tasks, int affinity = -1) {
+    if (tasks.empty()) {
+      return;
+    }
+    CurrentWorker &current = currentWorker();
+    if (affinity < 0 && current.pool == this) {
+      WorkDeque &deque = workers_[current.index].deque;
+      for (size_t i = 0; i < tasks.size(); i++) {
+        deque.push(new Task(std::move(tasks[i])));
+      }
+    } else if (affinity >= 0) {
+      appendInbox(workers_[pickTarget(affinity)], tasks, 0, tasks.size());
+    } else {
+      size_t per = (tasks.size() + count_ - 1) / count_;
+      int first = pickTarget(-1);
+      for (int w = 0; w < count_ && (size_t)w * per < tasks.size(); w++) {
+        size_t lo = (size_t)w * per;
+        size_t hi = std::min(tasks.size(), lo + per);
+        appendInbox(workers_[(first + w) % count_], tasks, lo, hi);
+      }
+    }
+    tasks.clear();
+    wakeAll();
+  }
+
+  /**
+   * [begin, end)를 grain 크기 조각으로 나눠 body(lo, hi)를 병렬 실행하고
+   * 전부 끝날 때까지 기다림. 워커 안에서 부르면 기다리는 동안 다른 작업을
+   * 대신 실행 (워커가 전부 기다리기만 하다 멈추는 일 X)
+   */
+  template <class Body>
+  void parallelFor(size_t begin, size_t end, size_t grain, Body body) {
+    if (begin >= end) {
+      return;
+    }
+    if (grain == 0) {
+      grain = 1;
+    }
+    size_t chunks = (end - begin + grain - 1) / grain;
+    Latch latch(chunks);
+    std::vector<Task> tasks;
+    tasks.reserve(chunks);
+    for (size_t lo = begin; lo < end; lo += grain) {
+      size_t hi = std::min(end, lo + grain);
+      tasks.push_back([&body, &latch, lo, hi]() {
+        body(lo, hi);
+        latch.countDown();
+      });
+    }
+    submitBatch(tasks);
+    helpUntil(latch);
+  }
+
+  // 래치가 끝날 때까지: 워커면 다른 작업을 대신 실행, 아니면 잠듦
+  void helpUntil(Latch &latch) {
+    CurrentWorker &current = currentWorker();
+    if (current.pool != this) {
+      latch.wait();
+      return;
+    }
+    uint32_t seed = (uint32_t)current.index * 2654435761u + 1;
+    while (!latch.done()) {
+      Task *task = findTask(current.index, seed);
+      if (task != nullptr) {
+        run(current.index, task);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  // 통계 (실행 중에 읽으면 근삿값)
+  uint64_t executed(int worker) const {
+    return workers_[worker].executed.load(std::memory_order_relaxed);
+  }
+  uint64_t stolen(int worker) const {
+    return workers_[worker].stolen.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Worker {
+    WorkDeque deque;
+    alignas(CACHE_LINE) std::mutex inboxLock; // 풀 밖에서 넣는 작업
+    std::vector<Task *> inbox;
+    std::atomic<size_t> inboxSize{0}; // 락 없이 "비었나" 확인용
+    alignas(CACHE_LINE) std::atomic<uint64_t> executed{0}; // 주인만 씀
+    std::atomic<uint64_t> stolen{0};
+    std::thread thread;
+  };
+
+  int pickTarget(int affinity) {
+    if (affinity >= 0) {
+      return affinity % count_;
+    }
+    return (int)(nextTarget_.fetch_add(1, std::memory_order_relaxed) %
+                 (unsigned)count_);
+  }
+
+  void appendInbox(Worker &target, std::vector<Task> &tasks, size_t lo,
+                   size_t hi) {
+    std::lock_guard<std::mutex> guard(target.inboxLock);
+    for (size_t i = lo; i < hi; i++) {
+      target.inbox.push_back(new Task(std::move(tasks[i])));
+    }
+    target.inboxSize.store(target.inbox.size(), std::memory_order_relaxed);
+  }
+
+  static void bump(std::atomic<uint64_t> &cell) {
+    cell.store(cell.load(std::memory_order_relaxed) + 1,
+               std::memory_order_relaxed);
+  }
+
+  void run(int index, Task *task) {
+    (*task)();
+    delete task;
+    bump(workers_[index].executed);
+  }
+
+  // inbox를 통째로 가져와서 하나는 바로 실행, 나머지는 덱에 (훔쳐 갈 수 있게)
+  Task *takeInbox(Worker &worker) {
+    std::vector<Task *> taken;
+    {
+      std::lock_guard<std::mutex> guard(worker.inboxLock);
+      taken.swap(worker.inbox);
+      worker.inboxSize.store(0, std::memory_order_relaxed);
+    }
+    if (taken.empty()) {
+      return nullptr;
+    }
+    // 먼저 들어온 것부터 꺼내지도록 거꾸로 넣음 (주인은 bottom에서 꺼냄)
+    for (size_t i = taken.size() - 1; i > 0; i--) {
+      worker.deque.push(taken[i]);
+    }
+    return taken[0];
+  }
+
+  Task *findTask(int index, uint32_t &seed) {
+    Worker &self = workers_[index];
+    Task *task = self.deque.pop();
+    if (task != nullptr) {
+      return task;
+    }
+    if (self.inboxSize.load(std::memory_order_relaxed) > 0 &&
+        (task = takeInbox(self)) != nullptr) {
+      return task;
+    }
+    // 무작위 위치부터 한 바퀴: 다른 워커의 덱 -> 다른 워커의 inbox
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    int start = (int)(seed % (uint32_t)count_);
+    for (int k = 0; k < count_; k++) {
+      int victim = (start + k) % count_;
+      if (victim == index) {
+        continue;
+      }
+      if ((task = workers_[victim].deque.steal()) != nullptr) {
+        bump(self.stolen);
+        return task;
+      }
+    }
+    for (int k = 0; k < count_; k++) {
+      Worker &victim = workers_[(start + k) % count_];
+      if (&victim == &self ||
+          victim.inboxSize.load(std::memory_order_relaxed) == 0) {
+        continue;
+      }
+      std::unique_lock<std::mutex> guard(victim.inboxLock, std::try_to_lock);
+      if (guard.owns_lock() && !victim.inbox.empty()) {
+        task = victim.inbox.back();
+        victim.inbox.pop_back();
+        victim.inboxSize.store(victim.inbox.size(), std::memory_order_relaxed);
+        bump(self.stolen);
+        return task;
+      }
+    }
+    return nullptr;
+  }
+
+  bool hasWork() const {
+    for (int i = 0; i < count_; i++) {
+      if (!workers_[i].deque.empty() ||
+          workers_[i].inboxSize.load(std::memory_order_seq_cst) > 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void workerLoop(int index, bool pin) {
+    currentWorker().pool = this;
+    currentWorker().index = index;
+    if (pin) {
+      int cpus = (int)std::max(1u, std::thread::hardware_concurrency());
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(index % cpus, &set);
+      pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+    uint32_t seed = (uint32_t)index * 2654435761u + 1;
+
+    for (;;) {
+      Task *task = findTask(index, seed);
+      if (task != nullptr) {
+        run(index, task);
+        continue;
+      }
+      // 잠들기: 세대 읽기 -> 잠든다고 표시 -> 일이 정말 없는지 재확인
+      uint64_t epoch;
+      {
+        std::lock_guard<std::mutex> guard(sleepLock_);
+        epoch = wakeEpoch_;
+      }
+      sleepers_.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (hasWork()) {
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        continue; // 훔치다 CAS에서 졌거나 그 사이에 들어옴
+      }
+      if (stopping_.load(std::memory_order_seq_cst)) {
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        return;
+      }
+      {
+        std::unique_lock<std::mutex> guard(sleepLock_);
+        while (wakeEpoch_ == epoch) {
+          wake_.wait(guard);
+        }
+      }
+      sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  // 잠든 워커가 있을 때만 락 (없으면 fence + load 한 번)
+  void wakeOne() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> guard(sleepLock_);
+      wakeEpoch_++;
+    }
+    wake_.notify_one();
+  }
+
+  void wakeAll() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> guard(sleepLock_);
+      wakeEpoch_++;
+    }
+    wake_.notify_all();
+  }
+
+  const int count_;
+  Worker *workers_;
+  std::atomic<unsigned> nextTarget_{0};
+  std::atomic<bool> stopping_{false};
+
+  // 잠들기 상태는 제출 때마다 읽으므로 위 필드와 라인 분리. alignas 대신
+  // 패딩 -> ThreadPool 자체는 C++11의 new로 만들어도 됨
+  char pad_[CACHE_LINE];
+  std::atomic<int> sleepers_{0};
+  std::mutex sleepLock_;
+  std::condition_variable wake_;
+  uint64_t wakeEpoch_ = 0; // sleepLock_ 안에서만
+};
+
+// ==========================================
+// 완료 큐: 워커 -> 리액터 (eventfd로 epoll을 깨움)
+// ==========================================
+
+/**
+ * MpscQueue + EventfdWait. 리액터는 fd()를 epoll에 등록해 두고, 읽을 수
+ * 있다고 오면 drain()이 0을 돌려줄 때까지 부름. 0을 돌려줄 때 다시 잠들
+ * 준비(arm)까지 끝나 있음 -> 리액터가 깨어 있는 동안 워커의 post는 write 없음
+ */
+template <class T> class CompletionQueue {
+public:
+  explicit CompletionQueue(size_t capacity) : queue_(capacity) {
+    wakeup_.arm([this]() { return !queue_.empty(); });
+  }
+
+  int fd() const { return wakeup_.fd(); }
+
+  // 워커: 가득 차면 리액터가 비울 때까지 기다림 (리액터는 풀을 기다리지 않음)
+  void post(T item) {
+    int spins = 0;
+    while (!queue_.tryPush(item)) {
+      if (++spins < lfq::SPINS_BEFORE_YIELD) {
+        lfq::cpuRelax();
+      } else {
+        spins = 0;
+        std::this_thread::yield();
+      }
+    }
+    wakeup_.notify();
+  }
+
+  // 리액터 (소비자 하나)
+  size_t drain(T *out, size_t max) {
+    size_t n = queue_.tryPopBatch(out, max);
+    if (n > 0) {
+      return n;
+    }
+    wakeup_.disarm();
+    if (wakeup_.arm([this]() { return !queue_.empty(); })) {
+      return 0;
+    }
+    return queue_.tryPopBatch(out, max); // 그 사이 들어옴 -> 한 번 더 불릴 것
+  }
+
+  // 리액터가 끝날 때 남은 결과를 기다려서 받음
+  size_t waitDrain(T *out, size_t max) {
+    wakeup_.wait([this]() { return !queue_.empty(); });
+    return queue_.tryPopBatch(out, max);
+  }
+
+private:
+  lfq::MpscQueue<T> queue_;
+  lfq::EventfdWait wakeup_;
+};
+
+} // namespace wsp
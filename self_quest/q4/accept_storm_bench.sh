@@ -0,0 +1,76 @@
+#!/usr/bin/env bash
+# ⚔️ Quest 4: Connection Storm Benchmark (accept 경로)
+#
+# 노드 재시작 직후의 재접속 폭주를 흉내 낸다: 부하 생성기 storm 시나리오가
+# conns개의 자리에서 접속 -> 에코 1회 -> RST로 끊기 -> 바로 재접속을 반복.
+# 모드별로 초당 연결 수(CPS), 연결 지연, accept 큐 넘침, 서버 CPU를 CSV로 출력.
+#
+#   listen_overflows : accept 큐가 가득 차서 버린 연결 (TcpExt ListenOverflows)
+#   listen_drops     : 리스너에서 버린 SYN/ACK 전체 (TcpExt ListenDrops)
+#   cpu_us_per_conn  : 서버 CPU 시간(user+sys) / 완료된 연결 수
+#
+# 사용법: ./accept_storm_bench.sh [conns] [duration_sec] [backlog]
+# 예시:   ./accept_storm_bench.sh 2000 5
+#         MODES="lt et" ./accept_storm_bench.sh 4000 5 128
+#         LOG=/tmp/server.log ./accept_storm_bench.sh   (연결 로그를 파일로)
+#
+# 준비:
+#   g++ -o epoll_server epoll_echo_server.cpp -std=c++11 -O2 -pthread
+#   g++ -o load_generator load_generator.cpp -std=c++11 -O2
+
+CONNS=${1:-2000}
+DURATION=${2:-5}
+BACKLOG=${3:-4096}
+PORT=${PORT:-9200}
+THREADS=${THREADS:-4}
+MODES=${MODES:-"lt et reuseport exclusive"}
+LOG=${LOG:-/dev/null}
+
+cpu_ticks() {
+  awk '{ print $14 + $15 }' "/proc/$1/stat"
+}
+
+# /proc/net/netstat 의 TcpExt 카운터 (이름 줄 + 값 줄)
+tcp_ext() {
+  awk -v key="$1" '/^TcpExt:/ {
+      if (!names) { for (i = 2; i <= NF; i++) idx[$i] = i; names = 1 }
+      else { print $idx[key]; exit }
+    }' /proc/net/netstat
+}
+
+ticks_per_sec=$(getconf CLK_TCK)
+echo "mode,cps,connect_p50_us,connect_p99_us,listen_overflows,listen_drops,cpu_us_per_conn"
+
+for mode in $MODES; do
+  case "$mode" in
+    lt) args="" ;;
+    et) args="et" ;;
+    reuseport) args="et --threads $THREADS" ;;
+    exclusive) args="et --threads $THREADS --steer exclusive" ;;
+    *) echo "unknown mode: $mode" >&2; continue ;;
+  esac
+
+  ./epoll_server "$PORT" $args --backlog "$BACKLOG" > "$LOG" 2>&1 &
+  server_pid=$!
+  sleep 0.5
+
+  overflows_before=$(tcp_ext ListenOverflows)
+  drops_before=$(tcp_ext ListenDrops)
+  out=$(./load_generator --port "$PORT" --scenario storm --conns "$CONNS" \
+    --duration "$DURATION")
+  ticks=$(cpu_ticks "$server_pid")
+  overflows=$(($(tcp_ext ListenOverflows) - overflows_before))
+  drops=$(($(tcp_ext ListenDrops) - drops_before))
+
+  kill -INT "$server_pid"
+  wait "$server_pid" 2> /dev/null
+  PORT=$((PORT + 1))
+
+  cps=$(echo "$out" | awk '/CPS/ { print $NF }')
+  cycles=$(echo "$out" | awk '/Storm cycles/ { print $4 }')
+  p50=$(echo "$out" | grep "Connect latency" | sed -n 's/.*p50=\([0-9.]*\).*/\1/p')
+  p99=$(echo "$out" | grep "Connect latency" | sed -n 's/.*p99=\([0-9.]*\).*/\1/p')
+  cpu=$(awk -v t="$ticks" -v hz="$ticks_per_sec" -v n="$cycles" \
+    'BEGIN { if (n > 0) printf "%.2f", t * 1e6 / hz / n; else print 0 }')
+  echo "$mode,$cps,$p50,$p99,$overflows,$drops,$cpu"
+done
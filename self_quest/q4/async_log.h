@@ -0,0 +1,576 @@
+/**
+ * [Task 14] 비동기 로거 (헤더 전용, C++11)
+ *
+ * std::cout << ... << std::endl 은 이벤트 루프 스레드에서 포맷팅 + write()
+ * 시스템 콜까지 끝내야 돌아온다. 여기서는 로그 호출이 하는 일을
+ * "고정 크기 바이너리 레코드 하나를 스레드 전용 링에 쓰기"로 줄이고,
+ * 포맷팅과 write()는 백그라운드 스레드가 모아서 한 번에 한다.
+ *
+ *   alog::start();                                  // main에서 한 번
+ *   alog::info("[+] Client connected: {}:{} (fd={})",
+ *              alog::Ipv4(addr.sin_addr.s_addr), ntohs(addr.sin_port), fd);
+ *   alog::warn("send() failed: {}", alog::Errno(errno));
+ *   alog::stop();                                   // 남은 기록을 다 쓰고 종료
+ *
+ * - 스레드마다 SPSC 링 (생산자 = 로그 찍는 스레드, 소비자 = 백그라운드 스레드)
+ *   -> 락 X, 원자 연산은 head store 하나
+ * - 레코드 = 포맷 문자열 포인터 + 시각 + 인자 최대 5개 (64바이트, 캐시 라인 1개)
+ *   포맷 문자열과 const char* 인자는 포인터만 저장하므로 문자열 리터럴처럼
+ *   프로그램이 끝날 때까지 살아 있는 문자열만 넘길 것
+ * - 링이 가득 차면 DROP_NEWEST(기본): 버리고 링별 카운터 증가 -> 백그라운드
+ *   스레드가 "N개 버림" 줄을 대신 남김. BLOCK: 자리가 날 때까지 양보 (유실 X,
+ *   대신 로그 폭주가 이벤트 루프를 멈출 수 있음)
+ * - 링 메모리는 mmap (operator new를 거치지 않음, 안 쓴 페이지는 RSS 0)
+ * - 링은 프로세스가 끝날 때까지 유지 (리액터 스레드는 서버 수명과 같음)
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <sched.h>
+#include <sys/mman.h>
+#include <thread>
+#include <type_traits>
+#include <unistd.h>
+
+namespace alog {
+
+enum Level { LEVEL_DEBUG, LEVEL_INFO, LEVEL_WARN, LEVEL_ERROR };
+
+enum OverflowPolicy { DROP_NEWEST, BLOCK };
+
+const int MAX_ARGS = 5;
+const uint32_t RING_CAPACITY = 4096; // 레코드 수 (2의 거듭제곱), 스레드당 256KB
+const uint32_t MAX_THREADS = 256;
+
+// 인자 종류 (포맷팅은 백그라운드 스레드에서 종류에 맞게)
+enum ArgType { ARG_I64, ARG_U64, ARG_F64, ARG_STR, ARG_IPV4, ARG_ERRNO };
+
+// 네트워크 바이트 순서 IPv4 주소 -> "a.b.c.d"
+struct Ipv4 {
+  explicit Ipv4(uint32_t networkOrder) : addr(networkOrder) {}
+  uint32_t addr;
+};
+
+// errno 값 -> strerror 문구 (문자열 변환도 백그라운드에서)
+struct Errno {
+  explicit Errno(int err) : code(err) {}
+  int code;
+};
+
+struct Record {
+  const char *fmt;
+  uint64_t timeNs; // CLOCK_REALTIME_COARSE
+  uint8_t level;
+  uint8_t argCount;
+  uint8_t types[MAX_ARGS];
+  uint8_t reserved;
+  uint64_t args[MAX_ARGS];
+};
+static_assert(sizeof(Record) == 64, "alog::Record must fit one cache line");
+
+/**
+ * 스레드 하나 전용 링. head와 tail을 다른 캐시 라인에 둬서 생산자와 소비자가
+ * 서로의 라인을 무효화하지 않게 하고, 상대 인덱스는 캐시해 두고 필요할 때만 읽음.
+ */
+struct Ring {
+  alignas(64) std::atomic<uint64_t> head; // 생산자만 씀
+  uint64_t cachedTail;                    // 생산자 전용: 마지막으로 본 tail
+  std::atomic<uint64_t> dropped;          // 가득 차서 버린 레코드 수
+
+  alignas(64) std::atomic<uint64_t> tail; // 소비자만 씀
+  uint64_t reportedDropped;               // 소비자 전용: 이미 알린 유실 수
+
+  alignas(64) Record slots[RING_CAPACITY];
+};
+
+struct Stats {
+  uint64_t written; // 포맷해서 쓴 레코드
+  uint64_t dropped; // 링이 가득 차서 버린 레코드
+  uint32_t threads; // 링을 만든 스레드 수
+};
+
+// ============================================================
+// 공유 상태
+// ============================================================
+
+struct Shared {
+  std::atomic<Ring *> rings[MAX_THREADS];
+  std::atomic<uint32_t> ringCount;
+  std::atomic<uint64_t> unregisteredDrops; // MAX_THREADS를 넘은 스레드의 기록
+  std::atomic<uint64_t> written;
+  std::atomic<int> minLevel;
+  std::atomic<int> policy;
+  std::atomic<bool> running;
+  int fd;
+  std::thread worker;
+
+  Shared()
+      : ringCount(0), unregisteredDrops(0), written(0), minLevel(LEVEL_INFO),
+        policy(DROP_NEWEST), running(false), fd(STDOUT_FILENO) {
+    for (uint32_t i = 0; i < MAX_THREADS; i++) {
+      rings[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+};
+
+inline Shared &shared() {
+  static Shared s;
+  return s;
+}
+
+/**
+ * 로그 시각은 ms 단위면 충분하므로 COARSE 시계 (틱 단위로 갱신되는 값을
+ * 읽기만 함). 이 VM에서 CLOCK_REALTIME ~37ns, COARSE ~8ns -> 호출 비용의 대부분.
+ */
+inline uint64_t nowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME_COARSE, &ts); // vDSO (시스템 콜 X)
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * 이 스레드의 링 (첫 로그 때 mmap으로 만들고 등록, 이후에는 TLS 포인터 하나)
+ */
+inline Ring *createRing() {
+  Shared &s = shared();
+  uint32_t index = s.ringCount.fetch_add(1, std::memory_order_relaxed);
+  if (index >= MAX_THREADS) {
+    return nullptr;
+  }
+  void *p = mmap(nullptr, sizeof(Ring), PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) {
+    return nullptr;
+  }
+  // 0으로 채워진 페이지 = head/tail/dropped 0, 레코드는 쓸 때 채움
+  Ring *ring = static_cast<Ring *>(p);
+  s.rings[index].store(ring, std::memory_order_release);
+  return ring;
+}
+
+inline Ring *threadRing() {
+  static thread_local Ring *ring = nullptr;
+  static thread_local bool failed = false;
+  if (ring == nullptr && !failed) {
+    ring = createRing();
+    failed = ring == nullptr;
+  }
+  return ring;
+}
+
+// ============================================================
+// 생산자 (로그 호출)
+// ============================================================
+
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value &&
+                               std::is_signed<T>::value>::type
+encodeArg(Record &r, int i, T value) {
+  int64_t v = value;
+  r.types[i] = ARG_I64;
+  memcpy(&r.args[i], &v, sizeof(v));
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value &&
+                               !std::is_signed<T>::value>::type
+encodeArg(Record &r, int i, T value) {
+  r.types[i] = ARG_U64;
+  r.args[i] = (uint64_t)value;
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_floating_point<T>::value>::type
+encodeArg(Record &r, int i, T value) {
+  double v = value;
+  r.types[i] = ARG_F64;
+  memcpy(&r.args[i], &v, sizeof(v));
+}
+
+inline void encodeArg(Record &r, int i, const char *value) {
+  r.types[i] = ARG_STR;
+  r.args[i] = (uint64_t)(uintptr_t)value;
+}
+
+inline void encodeArg(Record &r, int i, Ipv4 value) {
+  r.types[i] = ARG_IPV4;
+  r.args[i] = value.addr;
+}
+
+inline void encodeArg(Record &r, int i, Errno value) {
+  r.types[i] = ARG_ERRNO;
+  r.args[i] = (uint64_t)(uint32_t)value.code;
+}
+
+inline void encodeAll(Record &, int) {}
+
+template <typename T, typename... Rest>
+inline void encodeAll(Record &r, int i, T first, Rest... rest) {
+  encodeArg(r, i, first);
+  encodeAll(r, i + 1, rest...);
+}
+
+/**
+ * 빈 자리 하나를 돌려줌 (가득 차면 정책대로: nullptr 또는 대기)
+ */
+inline Record *reserve(Ring &ring, uint64_t head) {
+  if (head - ring.cachedTail < RING_CAPACITY) {
+    return &ring.slots[head & (RING_CAPACITY - 1)];
+  }
+  while (true) {
+    ring.cachedTail = ring.tail.load(std::memory_order_acquire);
+    if (head - ring.cachedTail < RING_CAPACITY) {
+      return &ring.slots[head & (RING_CAPACITY - 1)];
+    }
+    Shared &s = shared();
+    if (s.policy.load(std::memory_order_relaxed) == DROP_NEWEST ||
+        !s.running.load(std::memory_order_relaxed)) {
+      ring.dropped.store(ring.dropped.load(std::memory_order_relaxed) + 1,
+                         std::memory_order_relaxed);
+      return nullptr;
+    }
+    sched_yield(); // BLOCK: 백그라운드 스레드가 비울 때까지
+  }
+}
+
+template <typename... Args>
+inline void write(Level level, const char *fmt, Args... args) {
+  static_assert(sizeof...(Args) <= MAX_ARGS, "alog: too many arguments");
+  Shared &s = shared();
+  if ((int)level < s.minLevel.load(std::memory_order_relaxed)) {
+    return;
+  }
+  Ring *ring = threadRing();
+  if (ring == nullptr) {
+    s.unregisteredDrops.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  uint64_t head = ring->head.load(std::memory_order_relaxed);
+  Record *r = reserve(*ring, head);
+  if (r == nullptr) {
+    return;
+  }
+  r->fmt = fmt;
+  r->timeNs = nowNs();
+  r->level = (uint8_t)level;
+  r->argCount = (uint8_t)sizeof...(Args);
+  encodeAll(*r, 0, args...);
+  ring->head.store(head + 1, std::memory_order_release);
+}
+
+template <typename... Args> inline void debug(const char *fmt, Args... args) {
+  write(LEVEL_DEBUG, fmt, args...);
+}
+template <typename... Args> inline void info(const char *fmt, Args... args) {
+  write(LEVEL_INFO, fmt, args...);
+}
+template <typename... Args> inline void warn(const char *fmt, Args... args) {
+  write(LEVEL_WARN, fmt, args...);
+}
+template <typename... Args> inline void error(const char *fmt, Args... args) {
+  write(LEVEL_ERROR, fmt, args...);
+}
+
+inline void setLevel(Level level) {
+  shared().minLevel.store(level, std::memory_order_relaxed);
+}
+
+// ============================================================
+// 소비자 (백그라운드 스레드: 포맷팅 + 일괄 write)
+// ============================================================
+
+class Formatter {
+public:
+  explicit Formatter(int fd) : fd_(fd), len_(0), cachedSec_(-1) {}
+
+  void record(const Record &r) {
+    timestamp(r.timeNs);
+    static const char LEVELS[] = {'D', 'I', 'W', 'E'};
+    put(LEVELS[r.level & 3]);
+    put(' ');
+
+    int argIndex = 0;
+    for (const char *p = r.fmt; *p != '\0'; p++) {
+      if (p[0] == '{' && p[1] == '}' && argIndex < r.argCount) {
+        arg(r.types[argIndex], r.args[argIndex]);
+        argIndex++;
+        p++;
+        continue;
+      }
+      put(*p);
+    }
+    put('\n');
+  }
+
+  void dropped(uint32_t thread, uint64_t count) {
+    timestamp(nowNs());
+    append("W [log] thread#");
+    number(thread);
+    append(" dropped ");
+    number(count);
+    append(" records (ring full)\n");
+  }
+
+  void flush() {
+    size_t off = 0;
+    while (off < len_) {
+      ssize_t n = ::write(fd_, buf_ + off, len_ - off);
+      if (n < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        break; // 출력이 막히면 버림 (로거가 서버를 죽이지 않도록)
+      }
+      off += (size_t)n;
+    }
+    len_ = 0;
+  }
+
+private:
+  static const size_t CAPACITY = 64 * 1024;
+
+  void put(char c) {
+    if (len_ == CAPACITY) {
+      flush();
+    }
+    buf_[len_++] = c;
+  }
+
+  void append(const char *s) {
+    while (*s != '\0') {
+      put(*s++);
+    }
+  }
+
+  void number(uint64_t v) {
+    char tmp[20];
+    int n = 0;
+    do {
+      tmp[n++] = (char)('0' + v % 10);
+      v /= 10;
+    } while (v != 0);
+    while (n > 0) {
+      put(tmp[--n]);
+    }
+  }
+
+  void padded(uint64_t v, int width) {
+    char tmp[20];
+    for (int k = width - 1; k >= 0; k--) {
+      tmp[k] = (char)('0' + v % 10);
+      v /= 10;
+    }
+    for (int k = 0; k < width; k++) {
+      put(tmp[k]);
+    }
+  }
+
+  void arg(uint8_t type, uint64_t raw) {
+    switch (type) {
+    case ARG_I64: {
+      int64_t v;
+      memcpy(&v, &raw, sizeof(v));
+      if (v < 0) {
+        put('-');
+        number(0 - (uint64_t)v);
+      } else {
+        number((uint64_t)v);
+      }
+      break;
+    }
+    case ARG_U64:
+      number(raw);
+      break;
+    case ARG_F64: {
+      double v;
+      memcpy(&v, &raw, sizeof(v));
+      char tmp[32];
+      snprintf(tmp, sizeof(tmp), "%.3f", v);
+      append(tmp);
+      break;
+    }
+    case ARG_STR: {
+      const char *s = (const char *)(uintptr_t)raw;
+      append(s != nullptr ? s : "(null)");
+      break;
+    }
+    case ARG_IPV4: {
+      const uint8_t *b = (const uint8_t *)&raw; // 네트워크 순서 그대로
+      for (int k = 0; k < 4; k++) {
+        if (k > 0) {
+          put('.');
+        }
+        number(b[k]);
+      }
+      break;
+    }
+    case ARG_ERRNO: {
+      char tmp[128];
+      append(strerrorText((int)(uint32_t)raw, tmp, sizeof(tmp)));
+      break;
+    }
+    }
+  }
+
+  // strerror_r은 glibc(GNU)와 POSIX 시그니처가 달라서 오버로드로 흡수
+  static const char *strerrorResult(int ret, const char *buf) {
+    return ret == 0 ? buf : "unknown error";
+  }
+  static const char *strerrorResult(const char *ret, const char *) {
+    return ret;
+  }
+  static const char *strerrorText(int err, char *buf, size_t size) {
+    buf[0] = '\0';
+    return strerrorResult(strerror_r(err, buf, size), buf);
+  }
+
+  // "HH:MM:SS.mmm " (localtime_r은 초가 바뀔 때만)
+  void timestamp(uint64_t ns) {
+    time_t sec = (time_t)(ns / 1000000000ULL);
+    if (sec != cachedSec_) {
+      struct tm tm;
+      localtime_r(&sec, &tm);
+      cachedHms_ = (uint32_t)(tm.tm_hour * 10000 + tm.tm_min * 100 + tm.tm_sec);
+      cachedSec_ = sec;
+    }
+    padded(cachedHms_ / 10000, 2);
+    put(':');
+    padded(cachedHms_ / 100 % 100, 2);
+    put(':');
+    padded(cachedHms_ % 100, 2);
+    put('.');
+    padded(ns / 1000000 % 1000, 3);
+    put(' ');
+  }
+
+  int fd_;
+  size_t len_;
+  time_t cachedSec_;
+  uint32_t cachedHms_;
+  char buf_[CAPACITY];
+};
+
+/**
+ * 모든 링을 한 바퀴 비움. 링마다 256개씩 tail을 넘겨서 BLOCK 정책의 생산자가
+ * 링 전체를 다 포맷할 때까지 기다리지 않게 함.
+ * @return 처리한 레코드 수
+ */
+inline uint64_t drainOnce(Formatter &out) {
+  Shared &s = shared();
+  uint64_t total = 0;
+  uint32_t count = s.ringCount.load(std::memory_order_acquire);
+  if (count > MAX_THREADS) {
+    count = MAX_THREADS;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    Ring *ring = s.rings[i].load(std::memory_order_acquire);
+    if (ring == nullptr) {
+      continue;
+    }
+    uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+    uint64_t head = ring->head.load(std::memory_order_acquire);
+    while (tail < head) {
+      out.record(ring->slots[tail & (RING_CAPACITY - 1)]);
+      tail++;
+      total++;
+      if ((tail & 255) == 0 || tail == head) {
+        ring->tail.store(tail, std::memory_order_release);
+      }
+    }
+    uint64_t dropped = ring->dropped.load(std::memory_order_relaxed);
+    if (dropped != ring->reportedDropped) {
+      out.dropped(i, dropped - ring->reportedDropped);
+      ring->reportedDropped = dropped;
+    }
+  }
+  if (total > 0) {
+    s.written.fetch_add(total, std::memory_order_relaxed);
+  }
+  return total;
+}
+
+inline void workerMain() {
+  Shared &s = shared();
+  Formatter *out = new Formatter(s.fd); // 64KB 출력 버퍼 (스택 X)
+  while (s.running.load(std::memory_order_acquire)) {
+    if (drainOnce(*out) == 0) {
+      struct timespec idle = {0, 1000000}; // 1ms: 로그가 화면에 보이는 최대 지연
+      nanosleep(&idle, nullptr);
+    }
+    out->flush();
+  }
+  // 종료: 생산자가 멈춘 뒤 남은 것까지
+  while (drainOnce(*out) > 0) {
+  }
+  out->flush();
+  delete out;
+}
+
+/**
+ * 백그라운드 스레드 시작. 시작 전에 찍은 로그는 링에 쌓여 있다가 함께 출력.
+ */
+inline void start(int fd = STDOUT_FILENO, OverflowPolicy policy = DROP_NEWEST) {
+  Shared &s = shared();
+  if (s.running.load()) {
+    return;
+  }
+  s.fd = fd;
+  s.policy.store(policy);
+  s.running.store(true);
+  s.worker = std::thread(workerMain);
+}
+
+/**
+ * 남은 기록을 모두 쓰고 백그라운드 스레드 종료
+ */
+inline void stop() {
+  Shared &s = shared();
+  if (!s.running.exchange(false)) {
+    return;
+  }
+  s.worker.join();
+}
+
+/**
+ * 지금까지 찍은 기록이 모두 출력될 때까지 대기 (다른 출력과 순서를 맞출 때)
+ */
+inline void flush() {
+  Shared &s = shared();
+  uint32_t count = s.ringCount.load(std::memory_order_acquire);
+  for (uint32_t i = 0; i < count && i < MAX_THREADS; i++) {
+    Ring *ring = s.rings[i].load(std::memory_order_acquire);
+    if (ring == nullptr) {
+      continue;
+    }
+    uint64_t head = ring->head.load(std::memory_order_acquire);
+    while (s.running.load(std::memory_order_acquire) &&
+           ring->tail.load(std::memory_order_acquire) < head) {
+      sched_yield();
+    }
+  }
+}
+
+inline Stats stats() {
+  Shared &s = shared();
+  Stats st;
+  st.written = s.written.load(std::memory_order_relaxed);
+  st.dropped = s.unregisteredDrops.load(std::memory_order_relaxed);
+  st.threads = s.ringCount.load(std::memory_order_relaxed);
+  for (uint32_t i = 0; i < st.threads && i < MAX_THREADS; i++) {
+    Ring *ring = s.rings[i].load(std::memory_order_acquire);
+    if (ring != nullptr) {
+      st.dropped += ring->dropped.load(std::memory_order_relaxed);
+    }
+  }
+  return st;
+}
+
+} // namespace alog
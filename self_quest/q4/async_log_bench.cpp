@@ -0,0 +1,122 @@
+/**
+ * [Task 14] 로그 호출 비용 벤치마크
+ *
+ * 접속/종료 로그 한 줄("[+] Client connected: ip:port (fd=N)")을 찍는 비용을
+ *   1) std::cout << ... << std::endl (매번 flush = write 시스템 콜)
+ *   2) std::cout << ... << '\n'      (stdio 버퍼, 가득 찰 때만 write)
+ *   3) alog::info                    (링에 레코드만 쓰고 포맷/write는 백그라운드)
+ * 로 비교하고, alog는 링이 넘칠 만큼 몰아서 찍었을 때의 유실 수도 보여준다.
+ *
+ * 호출 측 비용만 재기 위해 alog는 "버스트"(링 용량 절반)씩 찍고, 다음
+ * 버스트 전에 백그라운드 스레드가 비우도록 기다린다 (대기 시간은 측정 X).
+ *
+ * 컴파일: g++ -o async_log_bench async_log_bench.cpp -std=c++11 -O2 -pthread
+ * 실행: ./async_log_bench [iterations] [output_file]   (기본 /dev/null)
+ */
+
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iostream>
+#include <unistd.h>
+
+#include "async_log.h"
+
+using namespace std;
+using namespace std::chrono;
+
+const uint32_t ADDR = 0x0100007F; // 127.0.0.1 (네트워크 순서)
+
+double coutEndl(long long iterations) {
+  auto start = steady_clock::now();
+  for (long long n = 0; n < iterations; ++n) {
+    cout << "[+] Client connected: 127.0.0.1:" << (int)(n & 0xFFFF)
+         << " (fd=" << (int)(n & 0x3FFF) << ")" << endl;
+  }
+  duration<double, nano> elapsed = steady_clock::now() - start;
+  return elapsed.count() / iterations;
+}
+
+double coutNewline(long long iterations) {
+  auto start = steady_clock::now();
+  for (long long n = 0; n < iterations; ++n) {
+    cout << "[+] Client connected: 127.0.0.1:" << (int)(n & 0xFFFF)
+         << " (fd=" << (int)(n & 0x3FFF) << ")\n";
+  }
+  cout.flush();
+  duration<double, nano> elapsed = steady_clock::now() - start;
+  return elapsed.count() / iterations;
+}
+
+double alogBurst(long long iterations) {
+  const long long BURST = alog::RING_CAPACITY / 2;
+  duration<double, nano> measured(0);
+  for (long long done = 0; done < iterations; done += BURST) {
+    long long end = done + BURST < iterations ? done + BURST : iterations;
+    auto start = steady_clock::now();
+    for (long long n = done; n < end; ++n) {
+      alog::info("[+] Client connected: {}:{} (fd={})", alog::Ipv4(ADDR),
+                 (int)(n & 0xFFFF), (int)(n & 0x3FFF));
+    }
+    measured += steady_clock::now() - start;
+    alog::flush();
+  }
+  return measured.count() / iterations;
+}
+
+double alogFlood(long long iterations) {
+  auto start = steady_clock::now();
+  for (long long n = 0; n < iterations; ++n) {
+    alog::info("[+] Client connected: {}:{} (fd={})", alog::Ipv4(ADDR),
+               (int)(n & 0xFFFF), (int)(n & 0x3FFF));
+  }
+  duration<double, nano> elapsed = steady_clock::now() - start;
+  return elapsed.count() / iterations;
+}
+
+int main(int argc, char *argv[]) {
+  long long iterations = 1000000;
+  const char *path = "/dev/null";
+  if (argc >= 2) {
+    iterations = atoll(argv[1]);
+  }
+  if (argc >= 3) {
+    path = argv[2];
+  }
+
+  // cout과 alog 모두 같은 파일로 (stdout을 파일로 돌려놓고 측정)
+  int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    perror("open() failed");
+    return 1;
+  }
+  int console = dup(STDOUT_FILENO);
+  dup2(fd, STDOUT_FILENO);
+
+  double endlNs = coutEndl(iterations);
+  double newlineNs = coutNewline(iterations);
+
+  alog::start(STDOUT_FILENO);
+  double burstNs = alogBurst(iterations);
+  alog::Stats afterBurst = alog::stats();
+  double floodNs = alogFlood(iterations);
+  alog::stop();
+  alog::Stats afterFlood = alog::stats();
+
+  dup2(console, STDOUT_FILENO);
+  close(console);
+  close(fd);
+
+  cout << "=== 로그 호출 비용 (" << iterations << "회, 출력: " << path
+       << ") ===" << endl;
+  cout << "[cout + endl   ] " << endlNs << " ns/call" << endl;
+  cout << "[cout + '\\n'   ] " << newlineNs << " ns/call" << endl;
+  cout << "[alog (burst)  ] " << burstNs
+       << " ns/call (dropped=" << afterBurst.dropped << ")" << endl;
+  cout << "[alog (flood)  ] " << floodNs << " ns/call (dropped="
+       << afterFlood.dropped - afterBurst.dropped << "/" << iterations
+       << ", 링 " << alog::RING_CAPACITY << "개가 넘치면 버림)" << endl;
+  cout << "  written=" << afterFlood.written << endl;
+  return 0;
+}
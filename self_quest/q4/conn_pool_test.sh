@@ -0,0 +1,39 @@
+#!/usr/bin/env bash
+# ⚔️ Quest 4: Connection Pool Test
+#
+# 연결을 대량으로 열고 닫은 뒤 서버를 종료시켜서, 리액터 통계의
+# hot_path_allocs(accept/close 경로의 힙 할당 수)가 0인지 확인한다.
+#
+# 사용법: ./conn_pool_test.sh [conns] [duration_sec]
+# 예시:   ./conn_pool_test.sh 100000 20
+#
+# 준비:
+#   g++ -o epoll_server epoll_echo_server.cpp -std=c++11 -O2 -pthread
+#   g++ -o load_generator load_generator.cpp -std=c++11 -O2
+#   ulimit -n 250000   (서버와 부하 생성기 모두 연결 수보다 커야 함)
+
+CONNS=${1:-100000}
+DURATION=${2:-20}
+PORT=${PORT:-9100}
+MODE=${MODE:-et}
+# 출발지 IP 하나당 포트 약 28k개 -> 10만 연결이면 4개 이상
+SRC=${SRC:-127.0.0.1,127.0.0.2,127.0.0.3,127.0.0.4,127.0.0.5}
+
+log=$(mktemp)
+./epoll_server "$PORT" "$MODE" --max-conns "$CONNS" > "$log" 2>&1 &
+server_pid=$!
+sleep 0.5
+
+./load_generator --port "$PORT" --conns "$CONNS" --rate 10000 \
+  --ramp 5 --duration "$DURATION" --src "$SRC" | grep -E "Connected|Still|RPS|Echo"
+
+kill -INT "$server_pid"
+wait "$server_pid"
+
+grep "Reactor stats" "$log"
+if grep "Reactor stats" "$log" | grep -q "hot_path_allocs=0"; then
+  echo "[PASS] accept/close 경로에 힙 할당 없음"
+else
+  echo "[FAIL] accept/close 경로에서 힙 할당 발생"
+fi
+rm -f "$log"
@@ -0,0 +1,192 @@
+/**
+ * ⚔️ Quest 4: Coroutine Echo Server (Linux, C++20)
+ *
+ * epoll_echo_server.cpp의 ET 에코를 coro_reactor.h 위에서 코루틴으로 다시 쓴
+ * 참고 구현. 연결 하나 = 코루틴 하나, 읽기/쓰기 대기는 co_await.
+ *
+ * 컴파일: g++ -o coro_echo_server coro_echo_server.cpp -std=c++20 -O2
+ * 실행: ./coro_echo_server [port] [--max-conns N] [--stats sec]
+ *
+ * --stats : sec초마다 접속 수 / resume 수 / 프레임 malloc 수 출력 (sleep_for
+ *           예시, 0이면 끄기, 기본 0)
+ * 종료(Ctrl+C) 시 resume 횟수와 코루틴 프레임 malloc/재사용 횟수를 출력
+ */
+
+#include <arpa/inet.h>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <netinet/in.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "coro_reactor.h"
+
+#define BUFFER_SIZE 1024
+#define DEFAULT_PORT 9000
+#define DEFAULT_MAX_CONNECTIONS 131072
+
+volatile sig_atomic_t g_stop = 0;
+
+void onStopSignal(int) { g_stop = 1; }
+
+// 통계 (단일 스레드)
+uint64_t g_accepts = 0;
+uint64_t g_closes = 0;
+
+void errorExit(const char *msg) {
+  perror(msg);
+  exit(1);
+}
+
+int createServerSocket(int port) {
+  int serverSock = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+  if (serverSock < 0) {
+    errorExit("socket() failed");
+  }
+
+  int optval = 1;
+  setsockopt(serverSock, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval));
+
+  struct sockaddr_in serverAddr;
+  memset(&serverAddr, 0, sizeof(serverAddr));
+  serverAddr.sin_family = AF_INET;
+  serverAddr.sin_addr.s_addr = INADDR_ANY;
+  serverAddr.sin_port = htons(port);
+
+  if (bind(serverSock, (struct sockaddr *)&serverAddr, sizeof(serverAddr)) <
+      0) {
+    errorExit("bind() failed");
+  }
+  if (listen(serverSock, SOMAXCONN) < 0) {
+    errorExit("listen() failed");
+  }
+  return serverSock;
+}
+
+// ============================================================
+// 코루틴 핸들러
+// ============================================================
+
+/**
+ * 연결 하나의 전체 수명: 읽고 -> 그대로 보내고 -> 반복.
+ * write_all이 끝날 때까지 다음 read를 안 하므로 상대가 안 읽으면 우리도 안
+ * 읽음 (epoll 버전의 HIGH_WATER_MARK 역할을 코루틴 흐름이 대신함)
+ */
+coro::Task handleClient(coro::Reactor &reactor, int fd) {
+  coro::Socket sock(reactor, fd);
+  if (!sock.valid()) {
+    co_return;
+  }
+  char buffer[BUFFER_SIZE];
+
+  while (true) {
+    ssize_t bytesRead = co_await sock.read_some(std::span<char>(buffer));
+    if (bytesRead <= 0) {
+      break; // 연결 종료 또는 에러
+    }
+    if (!co_await sock.write_all(std::span<const char>(buffer, bytesRead))) {
+      break;
+    }
+  }
+  g_closes++;
+}
+
+/**
+ * 새 연결마다 핸들러 코루틴을 떼어 내서 실행 (accept 대기도 co_await)
+ */
+coro::Task acceptLoop(coro::Reactor &reactor, int serverSock) {
+  coro::Listener listener(reactor, serverSock);
+
+  while (true) {
+    int clientSock = co_await listener.accept();
+    if (clientSock < 0) {
+      if (errno == EMFILE || errno == ENFILE) {
+        // fd가 바닥남 -> 잠깐 쉬었다가 다시 (바로 돌면 헛돌기만 함)
+        co_await coro::sleep_for(reactor, 10);
+      }
+      continue;
+    }
+    g_accepts++;
+    spawn(handleClient(reactor, clientSock));
+  }
+}
+
+void printStats(const coro::Reactor &reactor) {
+  coro::FramePool &frames = coro::framePool();
+  std::cout << "[*] Stats: accepts=" << g_accepts << " closes=" << g_closes
+            << " resumes=" << reactor.resumes()
+            << " stale_events=" << reactor.staleEvents()
+            << " frame_mallocs=" << frames.mallocs()
+            << " frame_reuses=" << frames.reuses() << std::endl;
+}
+
+/**
+ * intervalSecs마다 통계 출력 (sleep_for 예시)
+ */
+coro::Task statsTicker(coro::Reactor &reactor, int intervalSecs) {
+  while (true) {
+    co_await coro::sleep_for(reactor, intervalSecs * 1000LL);
+    printStats(reactor);
+  }
+}
+
+// ============================================================
+// Main
+// ============================================================
+
+int main(int argc, char *argv[]) {
+  int port = DEFAULT_PORT;
+  int maxConnections = DEFAULT_MAX_CONNECTIONS;
+  int statsInterval = 0;
+
+  if (argc >= 2) {
+    port = atoi(argv[1]);
+  }
+  for (int i = 2; i < argc; i++) {
+    if (strcmp(argv[i], "--max-conns") == 0 && i + 1 < argc) {
+      maxConnections = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--stats") == 0 && i + 1 < argc) {
+      statsInterval = atoi(argv[++i]);
+    }
+  }
+
+  std::cout << "========================================" << std::endl;
+  std::cout << "  Quest 4: Coroutine Echo Server (Linux)" << std::endl;
+  std::cout << "========================================" << std::endl;
+  std::cout << "[*] Starting server on port " << port << std::endl;
+
+  // fd 제한을 hard limit까지
+  struct rlimit rl;
+  if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur < rl.rlim_max) {
+    rl.rlim_cur = rl.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &rl);
+  }
+
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = onStopSignal;
+  sigaction(SIGINT, &sa, nullptr);
+  sigaction(SIGTERM, &sa, nullptr);
+
+  int serverSock = createServerSocket(port);
+  coro::Reactor reactor(maxConnections + 1); // +1: 리스너
+  if (!reactor.valid()) {
+    errorExit("epoll_create1() failed");
+  }
+
+  spawn(acceptLoop(reactor, serverSock));
+  if (statsInterval > 0) {
+    spawn(statsTicker(reactor, statsInterval));
+  }
+
+  std::cout << "[*] Server running... (Mode: Coroutine, Edge Trigger)"
+            << std::endl;
+  reactor.run(g_stop);
+
+  printStats(reactor);
+  close(serverSock);
+  return 0;
+}
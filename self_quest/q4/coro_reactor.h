@@ -0,0 +1,565 @@
+/**
+ * [Task 11] epoll 리액터 위의 C++20 코루틴 계층 (헤더 전용)
+ *
+ * 콜백(handleClientET) 안에 프로토콜을 상태 기계로 짜는 대신, 한 연결의 흐름을
+ * 위에서 아래로 읽히는 코드로 쓸 수 있게 한다.
+ *
+ *   coro::Task handleClient(coro::Reactor &reactor, int fd) {
+ *     coro::Socket sock(reactor, fd);
+ *     char buf[1024];
+ *     while (true) {
+ *       ssize_t n = co_await sock.read_some(std::span<char>(buf));
+ *       if (n <= 0 || !co_await sock.write_all(std::span<const char>(buf, n)))
+ *         break;
+ *     }
+ *   }
+ *
+ * - co_await sock.read_some / write_all, listener.accept(), sleep_for(ms)
+ * - 시스템 콜을 먼저 시도하고 EAGAIN일 때만 대기 (ET, EPOLLOUT은 쓰기 대기
+ *   중일 때만 켬 -> ACK마다 헛된 쓰기 알림이 오지 않게)
+ * - 이벤트 루프가 epoll_wait 결과에서 바로 resume (스레드 이동 X)
+ * - 코루틴 프레임은 크기별 free list에서 재사용 (워밍업 후 malloc 0회)
+ * - fd 상태는 리액터 슬랩 + 세대 태그 -> 같은 묶음에서 닫힌 fd의 이벤트는 무시
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <chrono>
+#include <coroutine>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <new>
+#include <queue>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace coro {
+
+// ============================================================
+// 코루틴 프레임 풀
+// ============================================================
+
+/**
+ * 프레임 크기를 64바이트 단위 클래스로 묶어서 반납된 프레임을 재사용.
+ * 연결 핸들러처럼 같은 코루틴이 계속 생겼다 사라지면 첫 몇 개 이후로는
+ * malloc이 일어나지 않는다. (리액터 스레드마다 하나, 락 X)
+ */
+class FramePool {
+public:
+  static constexpr size_t GRANULE = 64;
+  static constexpr size_t MAX_POOLED = 8192; // 이보다 큰 프레임은 그냥 malloc
+
+  void *allocate(size_t size) {
+    size_t cls = classOf(size);
+    if (cls < NUM_CLASSES && freeLists_[cls] != nullptr) {
+      FreeFrame *frame = freeLists_[cls];
+      freeLists_[cls] = frame->next;
+      reuses_++;
+      return frame;
+    }
+    mallocs_++;
+    void *p = std::malloc(cls < NUM_CLASSES ? (cls + 1) * GRANULE : size);
+    if (p == nullptr) {
+      throw std::bad_alloc();
+    }
+    return p;
+  }
+
+  void deallocate(void *p, size_t size) {
+    size_t cls = classOf(size);
+    if (cls >= NUM_CLASSES) {
+      std::free(p);
+      return;
+    }
+    FreeFrame *frame = static_cast<FreeFrame *>(p);
+    frame->next = freeLists_[cls];
+    freeLists_[cls] = frame;
+  }
+
+  uint64_t mallocs() const { return mallocs_; }
+  uint64_t reuses() const { return reuses_; }
+
+private:
+  static constexpr size_t NUM_CLASSES = MAX_POOLED / GRANULE;
+
+  struct FreeFrame {
+    FreeFrame *next;
+  };
+
+  static size_t classOf(size_t size) { return (size + GRANULE - 1) / GRANULE - 1; }
+
+  FreeFrame *freeLists_[NUM_CLASSES] = {};
+  uint64_t mallocs_ = 0;
+  uint64_t reuses_ = 0;
+};
+
+inline FramePool &framePool() {
+  thread_local FramePool pool;
+  return pool;
+}
+
+// ============================================================
+// Task: co_await 하거나 spawn()으로 떼어 내서 돌리는 코루틴
+// ============================================================
+
+class Task {
+public:
+  struct promise_type {
+    std::coroutine_handle<> continuation;
+    bool detached = false;
+
+    Task get_return_object() {
+      return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    // 만들기만 하고 시작은 co_await / spawn 때
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    struct FinalAwaiter {
+      bool await_ready() noexcept { return false; }
+
+      // 끝나면 기다리던 쪽으로 바로 넘어감 (symmetric transfer, 스택 X)
+      std::coroutine_handle<>
+      await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+        promise_type &promise = h.promise();
+        if (promise.detached) {
+          h.destroy();
+          return std::noop_coroutine();
+        }
+        if (promise.continuation) {
+          return promise.continuation;
+        }
+        return std::noop_coroutine();
+      }
+
+      void await_resume() noexcept {}
+    };
+
+    FinalAwaiter final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+
+    static void *operator new(size_t size) {
+      return framePool().allocate(size);
+    }
+    static void operator delete(void *p, size_t size) {
+      framePool().deallocate(p, size);
+    }
+  };
+
+  Task(Task &&other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+  ~Task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  // co_await task: 자식 코루틴을 바로 시작하고, 끝나면 이어서 진행
+  bool await_ready() const noexcept { return false; }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) {
+    handle_.promise().continuation = caller;
+    return handle_;
+  }
+  void await_resume() noexcept {}
+
+  /**
+   * 기다리는 쪽 없이 실행 (끝나면 프레임이 스스로 반납됨)
+   */
+  friend void spawn(Task task) {
+    std::coroutine_handle<promise_type> h = std::exchange(task.handle_, {});
+    h.promise().detached = true;
+    h.resume();
+  }
+
+private:
+  explicit Task(std::coroutine_handle<promise_type> h) : handle_(h) {}
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+// ============================================================
+// Reactor: epoll + 타이머, 준비된 대기자를 바로 resume
+// ============================================================
+
+/**
+ * 대기 중인 I/O 하나. attempt()가 시스템 콜을 다시 시도해서 끝났으면(또는 에러)
+ * true -> 리액터가 코루틴을 resume, EAGAIN이면 false -> 계속 대기.
+ */
+struct Waiter {
+  std::coroutine_handle<> handle;
+  bool (*attempt)(Waiter *self);
+};
+
+class Reactor {
+public:
+  explicit Reactor(uint32_t maxFds) : epollFd_(epoll_create1(0)) {
+    slots_.resize(maxFds);
+    for (uint32_t i = 0; i < maxFds; i++) {
+      slots_[i].nextFree = i + 1;
+    }
+    freeHead_ = 0;
+    std::vector<Timer> storage;
+    storage.reserve(maxFds);
+    timers_ = TimerQueue(std::greater<Timer>(), std::move(storage));
+  }
+
+  ~Reactor() { close(epollFd_); }
+
+  bool valid() const { return epollFd_ >= 0; }
+
+  /**
+   * fd를 ET로 등록 (읽기만), 슬롯 ID 반환 (-1: 슬롯 없음)
+   */
+  int64_t add(int fd) {
+    if (freeHead_ >= slots_.size()) {
+      return -1;
+    }
+    uint32_t index = freeHead_;
+    Slot &slot = slots_[index];
+    freeHead_ = slot.nextFree;
+    slot.fd = fd;
+    slot.reader = nullptr;
+    slot.writer = nullptr;
+    slot.inUse = true;
+
+    int64_t id = makeId(index, slot.generation);
+    if (control(EPOLL_CTL_ADD, fd, id, false) < 0) {
+      release(index);
+      return -1;
+    }
+    return id;
+  }
+
+  void remove(int64_t id) {
+    Slot *slot = find(id);
+    if (slot == nullptr) {
+      return;
+    }
+    epoll_ctl(epollFd_, EPOLL_CTL_DEL, slot->fd, nullptr);
+    release((uint32_t)(id & 0xFFFFFFFF));
+  }
+
+  void waitRead(int64_t id, Waiter *waiter) { find(id)->reader = waiter; }
+
+  // EPOLLOUT을 켜면 MOD 시점에 이미 쓸 수 있는 상태도 알려줌 (놓치는 알림 X)
+  void waitWrite(int64_t id, Waiter *waiter) {
+    Slot *slot = find(id);
+    slot->writer = waiter;
+    control(EPOLL_CTL_MOD, slot->fd, id, true);
+  }
+
+  void addTimer(int64_t deadlineMs, std::coroutine_handle<> handle) {
+    timers_.push(Timer(deadlineMs, handle));
+  }
+
+  static int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  /**
+   * stop이 켜질 때까지 이벤트 루프 (최대 1초마다 깨어나서 확인)
+   */
+  void run(const volatile sig_atomic_t &stop) {
+    struct epoll_event events[MAX_EVENTS];
+    while (!stop) {
+      int numEvents = epoll_wait(epollFd_, events, MAX_EVENTS, nextTimeoutMs());
+      if (numEvents < 0 && errno != EINTR) {
+        break;
+      }
+      for (int i = 0; i < numEvents; i++) {
+        dispatch((int64_t)events[i].data.u64, events[i].events);
+      }
+      fireTimers();
+    }
+  }
+
+  uint64_t resumes() const { return resumes_; }
+  uint64_t staleEvents() const { return staleEvents_; }
+
+private:
+  static constexpr int MAX_EVENTS = 1024;
+
+  struct Slot {
+    int fd = -1;
+    uint32_t generation = 0; // 반납할 때마다 +1
+    uint32_t nextFree = 0;
+    bool inUse = false;
+    Waiter *reader = nullptr;
+    Waiter *writer = nullptr;
+  };
+
+  typedef std::pair<int64_t, std::coroutine_handle<>> Timer;
+  typedef std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>>
+      TimerQueue;
+
+  int control(int op, int fd, int64_t id, bool wantWrite) {
+    struct epoll_event ev;
+    ev.events = EPOLLIN | EPOLLRDHUP | EPOLLET | (wantWrite ? (uint32_t)EPOLLOUT : 0u);
+    ev.data.u64 = (uint64_t)id;
+    return epoll_ctl(epollFd_, op, fd, &ev);
+  }
+
+  static int64_t makeId(uint32_t index, uint32_t generation) {
+    return ((int64_t)generation << 32) | index;
+  }
+
+  Slot *find(int64_t id) {
+    uint32_t index = (uint32_t)(id & 0xFFFFFFFF);
+    if (id < 0 || index >= slots_.size()) {
+      return nullptr;
+    }
+    Slot &slot = slots_[index];
+    if (!slot.inUse || slot.generation != (uint32_t)((uint64_t)id >> 32)) {
+      return nullptr;
+    }
+    return &slot;
+  }
+
+  void release(uint32_t index) {
+    Slot &slot = slots_[index];
+    slot.inUse = false;
+    slot.generation = (slot.generation + 1) & 0x7FFFFFFF; // id는 항상 양수
+    slot.nextFree = freeHead_;
+    freeHead_ = index;
+  }
+
+  /**
+   * 대기자를 다시 시도시키고, 끝났으면 그 자리에서 resume
+   * (resume 안에서 연결이 닫힐 수 있으므로 매번 슬롯을 다시 찾음)
+   */
+  void dispatch(int64_t id, uint32_t events) {
+    Slot *slot = find(id);
+    if (slot == nullptr) {
+      staleEvents_++;
+      return;
+    }
+    if ((events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) &&
+        slot->reader != nullptr && slot->reader->attempt(slot->reader)) {
+      Waiter *waiter = std::exchange(slot->reader, nullptr);
+      resumes_++;
+      waiter->handle.resume();
+      slot = find(id);
+    }
+    if (slot != nullptr && (events & (EPOLLOUT | EPOLLHUP | EPOLLERR)) &&
+        slot->writer != nullptr && slot->writer->attempt(slot->writer)) {
+      Waiter *waiter = std::exchange(slot->writer, nullptr);
+      control(EPOLL_CTL_MOD, slot->fd, id, false);
+      resumes_++;
+      waiter->handle.resume();
+    }
+  }
+
+  int nextTimeoutMs() const {
+    if (timers_.empty()) {
+      return 1000;
+    }
+    int64_t wait = timers_.top().first - nowMs();
+    if (wait < 0) {
+      return 0;
+    }
+    return wait > 1000 ? 1000 : (int)wait;
+  }
+
+  void fireTimers() {
+    int64_t now = nowMs();
+    while (!timers_.empty() && timers_.top().first <= now) {
+      std::coroutine_handle<> handle = timers_.top().second;
+      timers_.pop();
+      resumes_++;
+      handle.resume();
+    }
+  }
+
+  int epollFd_;
+  std::vector<Slot> slots_;
+  uint32_t freeHead_;
+  TimerQueue timers_;
+  uint64_t resumes_ = 0;
+  uint64_t staleEvents_ = 0;
+};
+
+// ============================================================
+// Awaitable: 소켓 I/O / accept / sleep_for
+// ============================================================
+
+/**
+ * 연결된 소켓 (RAII: 소멸 시 epoll 해제 + close)
+ */
+class Socket {
+public:
+  Socket(Reactor &reactor, int fd)
+      : reactor_(reactor), fd_(fd), id_(reactor.add(fd)) {}
+  Socket(const Socket &) = delete;
+  Socket &operator=(const Socket &) = delete;
+  ~Socket() {
+    reactor_.remove(id_);
+    close(fd_);
+  }
+
+  bool valid() const { return id_ >= 0; }
+  int fd() const { return fd_; }
+
+  /**
+   * 받은 만큼 반환 (0: 상대가 끊음, -1: 에러)
+   */
+  struct ReadAwaiter : Waiter {
+    Socket *sock;
+    std::span<char> buf;
+    ssize_t result;
+
+    static bool tryRead(Waiter *self) {
+      ReadAwaiter *a = static_cast<ReadAwaiter *>(self);
+      a->result = recv(a->sock->fd_, a->buf.data(), a->buf.size(), 0);
+      return a->result >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+    }
+
+    bool await_ready() { return tryRead(this); }
+    void await_suspend(std::coroutine_handle<> h) {
+      handle = h;
+      sock->reactor_.waitRead(sock->id_, this);
+    }
+    ssize_t await_resume() const { return result; }
+  };
+
+  /**
+   * 전부 보낼 때까지 (중간에 EAGAIN이면 EPOLLOUT 대기) -> false: 에러
+   */
+  struct WriteAwaiter : Waiter {
+    Socket *sock;
+    std::span<const char> buf;
+    size_t sent;
+    bool failed;
+
+    static bool tryWrite(Waiter *self) {
+      WriteAwaiter *a = static_cast<WriteAwaiter *>(self);
+      while (a->sent < a->buf.size()) {
+        ssize_t n = send(a->sock->fd_, a->buf.data() + a->sent,
+                         a->buf.size() - a->sent, MSG_NOSIGNAL);
+        if (n < 0) {
+          if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return false;
+          }
+          if (errno == EINTR) {
+            continue;
+          }
+          a->failed = true;
+          return true;
+        }
+        a->sent += n;
+      }
+      return true;
+    }
+
+    bool await_ready() { return tryWrite(this); }
+    void await_suspend(std::coroutine_handle<> h) {
+      handle = h;
+      sock->reactor_.waitWrite(sock->id_, this);
+    }
+    bool await_resume() const { return !failed; }
+  };
+
+  ReadAwaiter read_some(std::span<char> buf) {
+    ReadAwaiter a;
+    a.attempt = &ReadAwaiter::tryRead;
+    a.sock = this;
+    a.buf = buf;
+    a.result = -1;
+    return a;
+  }
+
+  WriteAwaiter write_all(std::span<const char> buf) {
+    WriteAwaiter a;
+    a.attempt = &WriteAwaiter::tryWrite;
+    a.sock = this;
+    a.buf = buf;
+    a.sent = 0;
+    a.failed = false;
+    return a;
+  }
+
+private:
+  Reactor &reactor_;
+  int fd_;
+  int64_t id_;
+};
+
+/**
+ * 리스닝 소켓 (non-blocking으로 만들어서 넘길 것)
+ */
+class Listener {
+public:
+  Listener(Reactor &reactor, int fd)
+      : reactor_(reactor), fd_(fd), id_(reactor.add(fd)) {}
+  Listener(const Listener &) = delete;
+  Listener &operator=(const Listener &) = delete;
+  ~Listener() { reactor_.remove(id_); }
+
+  /**
+   * 새 연결 fd (non-blocking), -1: 에러
+   */
+  struct AcceptAwaiter : Waiter {
+    Listener *listener;
+    int result;
+
+    static bool tryAccept(Waiter *self) {
+      AcceptAwaiter *a = static_cast<AcceptAwaiter *>(self);
+      a->result = accept4(a->listener->fd_, nullptr, nullptr, SOCK_NONBLOCK);
+      return a->result >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+    }
+
+    bool await_ready() { return tryAccept(this); }
+    void await_suspend(std::coroutine_handle<> h) {
+      handle = h;
+      listener->reactor_.waitRead(listener->id_, this);
+    }
+    int await_resume() const { return result; }
+  };
+
+  AcceptAwaiter accept() {
+    AcceptAwaiter a;
+    a.attempt = &AcceptAwaiter::tryAccept;
+    a.listener = this;
+    a.result = -1;
+    return a;
+  }
+
+private:
+  Reactor &reactor_;
+  int fd_;
+  int64_t id_;
+};
+
+/**
+ * co_await sleep_for(reactor, ms): 타이머 힙에 넣고 기한이 되면 resume
+ */
+struct SleepAwaiter {
+  Reactor &reactor;
+  int64_t deadlineMs;
+
+  bool await_ready() const { return deadlineMs <= Reactor::nowMs(); }
+  void await_suspend(std::coroutine_handle<> h) {
+    reactor.addTimer(deadlineMs, h);
+  }
+  void await_resume() const {}
+};
+
+inline SleepAwaiter sleep_for(Reactor &reactor, int64_t ms) {
+  return SleepAwaiter{reactor, Reactor::nowMs() + ms};
+}
+
+} // namespace coro
@@ -0,0 +1,69 @@
+#!/usr/bin/env bash
+# ⚔️ Quest 4: Event Engine Benchmark (epoll LT / ET vs io_uring vs coroutine
+#                                    vs splice)
+#
+# 같은 부하 생성기 설정으로 엔진별 처리량(RPS), 응답 지연, 서버 CPU를 재서
+# CSV로 출력한다. cpu_us_per_resp = 서버 CPU 시간(user+sys) / 받은 응답 수,
+# cpu_ms_per_gb = 서버 CPU 시간 / 에코한 GB (부하 생성기가 돌려받은 바이트).
+#
+# 사용법: ./engine_bench.sh [conns] [duration_sec] [msg_size] [pipeline]
+# 예시:   ./engine_bench.sh 1000 10 64 1
+#         ENGINES="et coro" ./engine_bench.sh 200 10 16384 8
+#         ENGINES="lt et splice-lt splice-et" ./engine_bench.sh 50 10 65536 4
+#
+# 준비:
+#   g++ -o epoll_server epoll_echo_server.cpp -std=c++11 -O2 -pthread
+#   g++ -o coro_echo_server coro_echo_server.cpp -std=c++20 -O2
+#   g++ -o load_generator load_generator.cpp -std=c++11 -O2
+
+CONNS=${1:-1000}
+DURATION=${2:-10}
+MSG_SIZE=${3:-64}
+PIPELINE=${4:-1}
+PORT=${PORT:-9100}
+ENGINES=${ENGINES:-"lt et uring uring-sqpoll coro splice-lt splice-et"}
+
+cpu_ticks() {
+  # /proc/<pid>/stat 의 14번째(utime) + 15번째(stime), 단위: clock tick
+  awk '{ print $14 + $15 }' "/proc/$1/stat"
+}
+
+ticks_per_sec=$(getconf CLK_TCK)
+echo "engine,rps,p50_us,p99_us,cpu_us_per_resp,cpu_ms_per_gb"
+
+for engine in $ENGINES; do
+  server=./epoll_server
+  case "$engine" in
+    lt) args="" ;;
+    et) args="et" ;;
+    uring) args="uring" ;;
+    uring-sqpoll) args="uring --sqpoll" ;;
+    coro) server=./coro_echo_server; args="" ;;
+    splice-lt) args="--splice" ;;
+    splice-et) args="et --splice" ;;
+    *) echo "unknown engine: $engine" >&2; continue ;;
+  esac
+
+  $server "$PORT" $args > /dev/null 2>&1 &
+  server_pid=$!
+  sleep 0.5
+
+  out=$(./load_generator --port "$PORT" --conns "$CONNS" --rate 5000 \
+    --duration "$DURATION" --msg-size "$MSG_SIZE" --pipeline "$PIPELINE")
+  ticks=$(cpu_ticks "$server_pid")
+
+  kill -INT "$server_pid"
+  wait "$server_pid" 2> /dev/null
+  PORT=$((PORT + 1)) # TIME_WAIT 충돌 방지
+
+  rps=$(echo "$out" | awk '/RPS \(responses\)/ { print $4 }')
+  responses=$(echo "$out" | awk '/Responses received/ { print $4 }')
+  bytes_in=$(echo "$out" | awk '/Bytes out\/in/ { print $6 }')
+  p50=$(echo "$out" | grep "Response latency" | sed -n 's/.*p50=\([0-9.]*\).*/\1/p')
+  p99=$(echo "$out" | grep "Response latency" | sed -n 's/.*p99=\([0-9.]*\).*/\1/p')
+  cpu=$(awk -v t="$ticks" -v hz="$ticks_per_sec" -v n="$responses" \
+    'BEGIN { if (n > 0) printf "%.2f", t * 1e6 / hz / n; else print 0 }')
+  cpu_gb=$(awk -v t="$ticks" -v hz="$ticks_per_sec" -v b="$bytes_in" \
+    'BEGIN { if (b > 0) printf "%.1f", t * 1e3 / hz / (b / 1e9); else print 0 }')
+  echo "$engine,$rps,$p50,$p99,$cpu,$cpu_gb"
+done
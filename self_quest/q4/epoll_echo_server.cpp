@@ -4,23 +4,135 @@
  * 고성능 I/O 멀티플렉싱 서버 - Epoll 기반
  * Select의 한계를 넘어, 수천 개의 동시 접속을 처리하는 서버
  *
- * 컴파일: g++ -o epoll_server epoll_echo_server.cpp -std=c++11
- * 실행: ./epoll_server [port]
+ * 컴파일: g++ -o epoll_server epoll_echo_server.cpp -std=c++11 -pthread
+ * 실행: ./epoll_server [port] [et|uring] [--sqpoll] [--threads N]
+ *                      [--steer none|cpu|bpf|exclusive] [--max-conns N]
+ *                      [--buffer-mem MB] [--hugepages]
+ *                      [--splice] [--splice-after BYTES] [--backlog N]
+ *                      [--metrics-port N] [--offload ROUNDS]
+ *                      [--offload-threads N] [--tick HZ] [--tick-work ROUNDS]
+ *                      [--tick-fixed]
+ *
+ * uring       : epoll 대신 io_uring 엔진 (multishot accept/recv +
+ *               provided buffer ring, send 일괄 제출)
+ * --sqpoll    : uring 모드에서 커널 SQ 폴링 스레드 사용 (제출 시스템 콜 X)
+ * --max-conns : 연결 풀(슬랩) 크기 (리액터 전체 합계, 기본 131072)
+ *               종료(Ctrl+C) 시 리액터별 accept/close 수와
+ *               accept/close 경로에서 일어난 힙 할당 수를 출력
+ * --buffer-mem: 송신 대기 버퍼 풀 크기 (리액터 전체 합계, 기본 1024MB 예약,
+ *               실제 메모리는 쓴 만큼만)
+ * --hugepages : 버퍼 풀을 MAP_HUGETLB로 할당 (실패하면 일반 페이지)
+ * --splice    : epoll 모드에서 recv/send 대신 splice()로 소켓 -> 파이프 -> 소켓
+ *               에코 (파이프는 리액터별 풀에서 빌림, 유저 공간 복사 X)
+ * --splice-after: 연결마다 처음 BYTES는 recv/send 복사 경로 (내용 검사 구간,
+ *               예: 프록시의 핸드셰이크/헤더), 그 뒤부터 splice
+ * --backlog N : listen() accept 큐 길이 (기본 SOMAXCONN, 넘치면 SYN/ACK 버림
+ *               -> 클라이언트는 재전송 타임아웃(1초~)만큼 늦게 붙음)
+ * --metrics-port N: 127.0.0.1:N 에서 Prometheus 텍스트 지표 응답 (curl로 확인,
+ *               리액터(0번)가 같은 epoll에서 처리 -> 별도 스레드 X)
+ * --offload ROUNDS: 받은 데이터의 "검증"(페이로드 해시 ROUNDS번)을 작업 훔치기
+ *               풀에서 하고, 결과는 eventfd 완료 큐로 리액터에 돌아와서 에코
+ *               (epoll 모드만, 비싼 핸들러를 리액터 밖으로 빼는 모양)
+ * --offload-threads N: 위 풀의 워커 수 (기본: 코어 수)
+ * --tick HZ   : 받은 즉시 에코하지 않고 HZ 주기 틱(timerfd, 같은 epoll)마다
+ *               쌓인 입력을 처리해서 연결마다 한 번에 송신. 다음 틱 예상 비용이
+ *               주기의 절반을 넘을 만큼 쌓이면 읽기를 멈추고 틱 직전에는 남은
+ *               이벤트를 미룸 (epoll 모드만, --splice / --offload 와 같이 못 씀)
+ * --tick-work ROUNDS: 틱 핸들러가 프레임마다 검증 해시 ROUNDS번 (시뮬레이션 비용)
+ * --tick-fixed: 위 입력 예산/미루기를 끄고 틱마다 받은 걸 전부 처리 (비교용)
+ * --threads N : 리액터 N개 (스레드마다 epoll + SO_REUSEPORT 리스너, 코어 고정)
+ * --steer     : 연결을 어느 리액터로 보낼지
+ *               none - 커널 해시 (기본)
+ *               cpu  - SO_INCOMING_CPU (SYN을 처리한 코어의 리스너 우선)
+ *               bpf  - reuseport CBPF 프로그램 (처리 코어 번호 % N 번째 리스너)
+ *               exclusive - 리스너 하나를 공유, EPOLLEXCLUSIVE로 한 리액터만 깨움
+ *                      (한가한 리액터가 먼저 받아감, reuseport처럼 해시 고정 X)
  */
 
+#include <algorithm>
 #include <arpa/inet.h>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <errno.h>
 #include <fcntl.h>
 #include <iostream>
+#include <linux/filter.h>
+#include <linux/io_uring.h>
+#include <new>
 #include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
 #include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
+#include <thread>
 #include <unistd.h>
+#include <vector>
+
+#include "async_log.h" // [Task 14] 접속/종료/에러 로그는 비동기 로거로
+#include "metrics.h"   // [Task 15] 실시간 지표 (스레드별 샤드, 읽을 때 합산)
+#include "../q3/work_steal_pool.h" // [Task 16] CPU 작업은 워커 풀로
+
+#ifndef SO_INCOMING_CPU
+#define SO_INCOMING_CPU 49
+#endif
+#ifndef SO_ATTACH_REUSEPORT_CBPF
+#define SO_ATTACH_REUSEPORT_CBPF 51
+#endif
 
 #define MAX_EVENTS 1024
 #define BUFFER_SIZE 1024
 #define DEFAULT_PORT 9000
+#define HIGH_WATER_MARK (256 * 1024) // 이만큼 못 보내고 쌓이면 읽기 중단
+#define LOW_WATER_MARK (64 * 1024)   // 이 아래로 비워지면 읽기 재개
+#define DEFAULT_MAX_CONNECTIONS 131072
+#define LISTENER_TAG 0 // epoll data가 0이면 리스닝 소켓
+#define ADMIN_LISTENER_TAG 1 // 지표 관리 포트 리스너
+#define ADMIN_CLIENT_BIT 2   // (fd << 2) | 2: 관리 포트 연결 (연결 태그는 8바이트
+                             // 정렬 포인터라 하위 2비트가 항상 0)
+#define OFFLOAD_DONE_TAG 3   // 워커 풀 완료 큐의 eventfd (관리 태그보다 먼저 확인)
+#define OFFLOAD_QUEUE_SIZE 4096 // 리액터별 완료 큐 크기 (가득 차면 워커가 기다림)
+#define OFFLOAD_DRAIN_BATCH 64
+#define TICK_TIMER_TAG 4 // 틱 timerfd (하위 2비트 0 -> 관리 태그와 안 겹침,
+                         // 연결 포인터는 8바이트 정렬이라 4가 될 수 없음)
+#define TICK_INPUT_BYTES (4 * 1024 * 1024) // 리액터별 틱 입력 아레나
+#define TICK_FRAME_UNITS 64 // 프레임 하나의 고정 비용 (입력 바이트로 환산)
+#define TICK_SIM_SHARE 0.5  // 틱 처리에 쓸 주기 비율 (나머지는 I/O)
+#define TICK_IO_MARGIN_NS 500000ULL // 다음 틱 0.5ms 전부터는 이벤트를 미룸
+#define DEFAULT_BUFFER_MEM_MB 1024
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#define ACCEPT_BATCH 64 // LT: 한 번 깨어날 때 accept할 최대 연결 수
+#define LOOP_SAMPLE_MASK 15 // 루프 처리 시간은 16묶음에 한 번만 잼 (시계 2번)
+
+// ============================================================
+// 힙 할당 계수 (accept/close 경로에 malloc이 없는지 확인용)
+// ============================================================
+
+// operator new를 가로채서 스레드별로 횟수만 셈 (실제 할당은 malloc 그대로)
+thread_local uint64_t t_allocCount = 0;
+
+void *operator new(size_t size) {
+  t_allocCount++;
+  void *p = malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+// Ctrl+C / kill 시 이벤트 루프를 빠져나와 통계 출력
+volatile sig_atomic_t g_stop = 0;
+
+void onStopSignal(int) { g_stop = 1; }
 
 // ============================================================
 // TODO: 유틸리티 함수 구현
@@ -43,14 +155,28 @@ void errorExit(const char *msg) {
   exit(1);
 }
 
+/**
+ * fd 제한(ulimit -n)을 hard limit까지 올림 (10만 연결용)
+ */
+void raiseFdLimit() {
+  struct rlimit rl;
+  if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur < rl.rlim_max) {
+    rl.rlim_cur = rl.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &rl);
+  }
+}
+
 // ============================================================
 // TODO: 서버 초기화
 // ============================================================
 
+int g_listenBacklog = SOMAXCONN; // accept 큐 길이 (커널이 somaxconn으로 자름)
+
 /**
  * Task 1-1: 서버 소켓 생성 및 바인딩
+ * @param reusePort: true면 SO_REUSEPORT (같은 포트에 리스너 여러 개)
  */
-int createServerSocket(int port) {
+int createServerSocket(int port, bool reusePort) {
   int serverSock = socket(AF_INET, SOCK_STREAM, 0);
   if (serverSock < 0) {
     errorExit("socket() failed");
@@ -60,6 +186,13 @@ int createServerSocket(int port) {
   int optval = 1;
   setsockopt(serverSock, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval));
 
+  // 멀티 리액터: 커널이 리스너들 사이에 연결을 나눠줌 (accept 락 경쟁 X)
+  if (reusePort &&
+      setsockopt(serverSock, SOL_SOCKET, SO_REUSEPORT, &optval,
+                 sizeof(optval)) < 0) {
+    errorExit("setsockopt(SO_REUSEPORT) failed");
+  }
+
   struct sockaddr_in serverAddr;
   memset(&serverAddr, 0, sizeof(serverAddr));
   serverAddr.sin_family = AF_INET;
@@ -71,7 +204,7 @@ int createServerSocket(int port) {
     errorExit("bind() failed");
   }
 
-  if (listen(serverSock, SOMAXCONN) < 0) {
+  if (listen(serverSock, g_listenBacklog) < 0) {
     errorExit("listen() failed");
   }
 
@@ -99,16 +232,29 @@ int createEpoll() {
  * @param epollFd: epoll 인스턴스
  * @param fd: 등록할 소켓
  * @param events: 감시할 이벤트 (EPOLLIN, EPOLLOUT, EPOLLET 등)
+ * @param data: 이벤트와 함께 돌려받을 값 (연결 태그 또는 LISTENER_TAG)
  */
-void epollAdd(int epollFd, int fd, uint32_t events) {
+void epollAdd(int epollFd, int fd, uint32_t events, uint64_t data) {
   struct epoll_event ev;
   ev.events = events;
-  ev.data.fd = fd;
+  ev.data.u64 = data;
   if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) < 0) {
     errorExit("epoll_ctl(ADD) failed");
   }
 }
 
+/**
+ * Epoll 감시 이벤트 변경 (EPOLLOUT 켜고 끄기, 읽기 일시 중단 등)
+ */
+void epollModify(int epollFd, int fd, uint32_t events, uint64_t data) {
+  struct epoll_event ev;
+  ev.events = events;
+  ev.data.u64 = data;
+  if (epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev) < 0) {
+    perror("epoll_ctl(MOD) failed");
+  }
+}
+
 /**
  * Epoll에서 소켓 제거
  */
@@ -117,192 +263,2659 @@ void epollRemove(int epollFd, int fd) {
 }
 
 // ============================================================
-// TODO: 이벤트 핸들러
+// 버퍼 풀 (크기별 클래스, 데이터가 밀려 있는 동안만 빌려줌)
 // ============================================================
 
 /**
- * Task 1-3, 2-1: 새 클라이언트 연결 처리
+ * 연결마다 전용 버퍼를 두면 10만 개의 잠수 연결만으로도 수 GB가 필요하다.
+ * 대부분의 에코는 recv -> send가 바로 끝나므로 (스택 버퍼 하나로 충분),
+ * send()가 못 보낸 나머지가 생겼을 때만 풀에서 버퍼를 빌리고 다 보내면 반납한다.
+ *
+ * - 클래스마다 같은 크기 버퍼를 하나의 mmap 영역에 나란히 배치 (인덱스로 식별)
+ *   -> io_uring provided buffer ring에 그대로 등록할 수 있는 배치
+ * - 빈 버퍼는 버퍼 앞 4바이트에 다음 인덱스를 적는 free list (메타데이터 X)
+ * - 한 번도 안 쓴 버퍼는 nextUnused로만 관리 -> 손대지 않은 페이지는 RSS 0
+ * - 리액터 스레드마다 하나씩 (락 X)
  */
-void handleAccept(int serverSock, int epollFd, bool useEdgeTrigger) {
-  while (true) {
-    struct sockaddr_in clientAddr;
-    socklen_t clientLen = sizeof(clientAddr);
+const uint32_t BUFFER_CLASS_SIZES[] = {4 * 1024, 16 * 1024, 64 * 1024,
+                                       256 * 1024, 2 * HIGH_WATER_MARK};
+const int NUM_BUFFER_CLASSES =
+    sizeof(BUFFER_CLASS_SIZES) / sizeof(BUFFER_CLASS_SIZES[0]);
+const uint32_t NO_FREE_BUFFER = 0xFFFFFFFF;
 
-    int clientSock =
-        accept(serverSock, (struct sockaddr *)&clientAddr, &clientLen);
-    if (clientSock < 0) {
-      if (errno == EAGAIN || errno == EWOULDBLOCK) {
-        break; // 더 이상 대기 중인 연결 없음 (ET 모드 정상)
-      }
-      perror("accept() failed");
-      return;
+struct BufferClass {
+  char *arena;
+  uint32_t bufferSize;
+  uint32_t capacity;   // 버퍼 개수
+  uint32_t nextUnused; // 아직 한 번도 안 빌려준 첫 인덱스
+  uint32_t freeHead;   // 반납된 버퍼 목록
+  uint32_t used;
+  uint32_t peak;
+};
+
+struct BufferPool {
+  BufferClass classes[NUM_BUFFER_CLASSES];
+  bool hugePages; // 실제로 MAP_HUGETLB가 적용됐는지
+  uint64_t exhausted; // 모든 클래스가 바닥나서 빌려주지 못한 횟수
+};
+
+size_t g_bufferMemPerReactor = (size_t)DEFAULT_BUFFER_MEM_MB * 1024 * 1024;
+bool g_useHugePages = false;
+
+/**
+ * 버퍼 영역 예약: MAP_NORESERVE라 실제 메모리는 쓴 페이지만큼만 잡힘.
+ * hugePages가 true면 MAP_HUGETLB부터 시도 (vm.nr_hugepages 설정 필요).
+ * hugetlb는 NORESERVE 없이 예약 -> 페이지가 모자라면 나중에 SIGBUS 대신
+ * 여기서 실패하고 일반 페이지로 돌아감.
+ */
+char *mapArena(size_t bytes, bool &hugePages) {
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+  if (hugePages) {
+    size_t rounded =
+        (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    void *p = mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                   flags | MAP_HUGETLB, -1, 0);
+    if (p != MAP_FAILED) {
+      return (char *)p;
     }
+    perror("mmap(MAP_HUGETLB) failed, falling back to normal pages");
+    hugePages = false;
+  }
+  void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags | MAP_NORESERVE,
+                 -1, 0);
+  if (p == MAP_FAILED) {
+    errorExit("mmap() failed");
+  }
+  return (char *)p;
+}
 
-    std::cout << "[+] Client connected: " << inet_ntoa(clientAddr.sin_addr)
-              << ":" << ntohs(clientAddr.sin_port) << " (fd=" << clientSock
-              << ")" << std::endl;
+/**
+ * 전체 예약량을 클래스 수로 나눠서 클래스마다 영역 하나씩
+ */
+void bufferPoolInit(BufferPool &pool, size_t totalBytes, bool hugePages) {
+  pool.hugePages = hugePages;
+  pool.exhausted = 0;
+  for (int c = 0; c < NUM_BUFFER_CLASSES; c++) {
+    BufferClass &bc = pool.classes[c];
+    bc.bufferSize = BUFFER_CLASS_SIZES[c];
+    bc.capacity = (uint32_t)(totalBytes / NUM_BUFFER_CLASSES / bc.bufferSize);
+    if (bc.capacity == 0) {
+      bc.capacity = 1;
+    }
+    bc.arena = mapArena((size_t)bc.capacity * bc.bufferSize, pool.hugePages);
+    bc.nextUnused = 0;
+    bc.freeHead = NO_FREE_BUFFER;
+    bc.used = 0;
+    bc.peak = 0;
+  }
+}
 
-    if (useEdgeTrigger) {
-      setNonBlocking(clientSock);
-      epollAdd(epollFd, clientSock, EPOLLIN | EPOLLET);
+/**
+ * size 바이트 이상 들어가는 가장 작은 클래스에서 빌림 (바닥나면 한 단계 위)
+ * @return nullptr: 모든 클래스가 바닥남
+ */
+char *bufferAcquire(BufferPool &pool, size_t size, uint8_t &classIndex) {
+  for (int c = 0; c < NUM_BUFFER_CLASSES; c++) {
+    BufferClass &bc = pool.classes[c];
+    if (bc.bufferSize < size) {
+      continue;
+    }
+    uint32_t index;
+    if (bc.freeHead != NO_FREE_BUFFER) {
+      index = bc.freeHead;
+      memcpy(&bc.freeHead, bc.arena + (size_t)index * bc.bufferSize,
+             sizeof(uint32_t));
+    } else if (bc.nextUnused < bc.capacity) {
+      index = bc.nextUnused++;
     } else {
-      epollAdd(epollFd, clientSock, EPOLLIN);
+      continue;
     }
+    bc.used++;
+    if (bc.used > bc.peak) {
+      bc.peak = bc.used;
+    }
+    classIndex = (uint8_t)c;
+    return bc.arena + (size_t)index * bc.bufferSize;
+  }
+  pool.exhausted++;
+  return nullptr;
+}
 
-    // LT 모드면 한 번만 accept
-    if (!useEdgeTrigger) {
-      break;
+void bufferRelease(BufferPool &pool, char *buffer, uint8_t classIndex) {
+  BufferClass &bc = pool.classes[classIndex];
+  uint32_t index = (uint32_t)((buffer - bc.arena) / bc.bufferSize);
+  memcpy(buffer, &bc.freeHead, sizeof(uint32_t));
+  bc.freeHead = index;
+  bc.used--;
+}
+
+// ============================================================
+// 파이프 풀 (splice 모드: 소켓 -> 파이프 -> 소켓, 유저 공간 복사 X)
+// ============================================================
+
+/**
+ * recv/send 에코는 커널 -> 유저 -> 커널로 같은 바이트를 두 번 복사한다.
+ * splice()는 소켓 수신 페이지를 파이프에 참조로 옮기고, 다시 그 페이지를
+ * 송신 소켓에 붙이므로 데이터가 유저 공간을 거치지 않는다.
+ *
+ * 연결마다 파이프(fd 2개)를 두면 fd 한도가 1/3로 줄어드므로 버퍼 풀과 같은
+ * 방식으로 빌려줌: 이벤트 처리 중이거나 파이프에 못 보낸 데이터가 남아 있을
+ * 때만 연결이 파이프를 잡고, 비면 바로 반납.
+ * - 파이프는 처음 빌려줄 때 만들고 재사용 (pipe2() 시스템 콜은 한 번만)
+ * - 데이터가 남은 채로 반납되면 (연결 종료) 그 파이프는 닫고 다음에 새로 만듦
+ */
+#define SPLICE_PIPE_SIZE (64 * 1024) // 파이프 용량 = 연결당 밀린 데이터 한도
+#define DEFAULT_SPLICE_PIPES 1024    // 리액터당 파이프 수
+
+struct SplicePipe {
+  int readFd; // -1이면 아직 안 만들었거나 닫힘
+  int writeFd;
+  uint32_t nextFree;
+};
+
+struct PipePool {
+  SplicePipe *pipes;
+  uint32_t capacity;
+  uint32_t nextUnused;
+  uint32_t freeHead;
+  uint32_t used;
+  uint32_t peak;
+  uint64_t created;   // pipe2() 호출 수
+  uint64_t exhausted; // 파이프를 못 빌려줘서 복사 경로로 보낸 횟수
+};
+
+bool g_useSplice = false;
+uint64_t g_spliceAfter = 0; // 연결마다 처음 이만큼은 복사 경로 (내용 검사용)
+
+void pipePoolInit(PipePool &pool, uint32_t capacity) {
+  bool hugePages = false;
+  pool.pipes = capacity == 0 ? nullptr
+                             : (SplicePipe *)mapArena(
+                                   (size_t)capacity * sizeof(SplicePipe),
+                                   hugePages);
+  pool.capacity = capacity;
+  pool.nextUnused = 0;
+  pool.freeHead = NO_FREE_BUFFER;
+  pool.used = 0;
+  pool.peak = 0;
+  pool.created = 0;
+  pool.exhausted = 0;
+}
+
+/**
+ * @return -1: 풀이 바닥났거나 pipe2() 실패 (fd 한도) -> 복사 경로
+ */
+int32_t pipeAcquire(PipePool &pool) {
+  uint32_t index;
+  if (pool.freeHead != NO_FREE_BUFFER) {
+    index = pool.freeHead;
+    pool.freeHead = pool.pipes[index].nextFree;
+  } else if (pool.nextUnused < pool.capacity) {
+    index = pool.nextUnused++;
+    pool.pipes[index].readFd = -1;
+  } else {
+    pool.exhausted++;
+    return -1;
+  }
+
+  SplicePipe &p = pool.pipes[index];
+  if (p.readFd < 0) {
+    int fds[2];
+    if (pipe2(fds, O_NONBLOCK | O_CLOEXEC) < 0) {
+      p.nextFree = pool.freeHead;
+      pool.freeHead = index;
+      pool.exhausted++;
+      return -1;
     }
+    fcntl(fds[1], F_SETPIPE_SZ, SPLICE_PIPE_SIZE);
+    p.readFd = fds[0];
+    p.writeFd = fds[1];
+    pool.created++;
+  }
+
+  pool.used++;
+  if (pool.used > pool.peak) {
+    pool.peak = pool.used;
   }
+  return (int32_t)index;
 }
 
 /**
- * Task 2-2, 2-3: 클라이언트 메시지 처리 (Level Triggered)
+ * @param leftover: 파이프에 남은 바이트 (0이 아니면 파이프를 닫아서 버림)
  */
-void handleClientLT(int clientSock, int epollFd) {
-  char buffer[BUFFER_SIZE];
+void pipeRelease(PipePool &pool, int32_t index, uint32_t leftover) {
+  SplicePipe &p = pool.pipes[index];
+  if (leftover > 0) {
+    close(p.readFd);
+    close(p.writeFd);
+    p.readFd = -1;
+    p.writeFd = -1;
+  }
+  p.nextFree = pool.freeHead;
+  pool.freeHead = (uint32_t)index;
+  pool.used--;
+}
 
-  int bytesRead = recv(clientSock, buffer, sizeof(buffer), 0);
+// ============================================================
+// 연결 객체 (보내지 못한 데이터 보관)
+// ============================================================
 
-  if (bytesRead <= 0) {
-    // 연결 종료 또는 에러
-    std::cout << "[-] Client disconnected (fd=" << clientSock << ")"
-              << std::endl;
-    epollRemove(epollFd, clientSock);
-    close(clientSock);
-    return;
+/**
+ * send()가 일부만 보내거나 EAGAIN을 돌려주면 남은 바이트를 outBuf(버퍼 풀에서
+ * 빌린 버퍼)에 보관하고 EPOLLOUT으로 "보낼 수 있게 되면" 알림을 받아 이어서
+ * 보낸다. 다 보내면 버퍼는 풀에 반납 -> 잠수 연결은 이 구조체 크기만 차지.
+ * 밀린 양이 HIGH_WATER_MARK를 넘으면 이 연결의 읽기를 멈춰서 (상대가 안 읽는
+ * 만큼 우리도 안 읽음 -> TCP 흐름 제어가 상대 송신을 늦춤) 메모리 폭주를 막음.
+ */
+struct Connection {
+  int fd;
+  bool edgeTrigger;
+  bool readPaused;  // HIGH_WATER_MARK 초과로 읽기 중단 중
+  bool offloadBusy; // [Task 16] 워커 풀에서 처리 중 (끝날 때까지 읽기 중단)
+  bool tickDirty;   // [Task 17] 이번 틱 송신 목록에 들어 있음
+  int32_t tickDeferIndex; // [Task 17] 미룬 이벤트 목록 안 위치 (-1이면 없음)
+  uint32_t tickQueued;    // [Task 17] 이번 틱에 쌓은 입력 바이트 (아직 에코 전)
+  uint8_t outClass; // outBuf의 버퍼 풀 클래스
+  uint32_t events;  // 현재 epoll에 등록된 이벤트
+  char *outBuf;     // 아직 못 보낸 데이터 (없으면 nullptr)
+  uint32_t outLen;  // outBuf에 쌓인 바이트
+  uint32_t outOffset; // outBuf에서 이미 보낸 위치
+
+  // uring 모드 전용: 받았지만 아직 못 보낸 provided buffer 목록 (복사 X)
+  int32_t heldHead;    // -1이면 없음
+  int32_t heldTail;
+  uint32_t heldBytes;
+  uint32_t sendOffset; // heldHead 버퍼에서 이미 보낸 위치
+  bool sending;        // send 요청이 걸려 있음 (연결당 하나 -> 순서 보장)
+  bool recvArmed;      // multishot recv가 걸려 있음
+  bool recvStarved;    // provided buffer가 바닥나서 반납을 기다리는 중
+  bool closing;        // 걸려 있는 요청이 다 끝나면 닫음
+
+  // splice 모드 전용
+  int32_t pipeIndex;  // 빌린 파이프 (-1이면 없음)
+  uint32_t pipeBytes; // 파이프에 들어 있지만 아직 못 보낸 바이트
+  bool spliceOff;     // 이 연결은 splice 불가 (EINVAL) -> 계속 복사 경로
+
+  // 타이머 / 통계
+  int64_t acceptedAtMs;
+  int64_t lastActiveMs;
+  uint64_t bytesIn;
+  uint64_t bytesOut;
+
+  // 풀 관리
+  bool inUse;
+  uint16_t generation; // 반납할 때마다 +1 (이전 연결의 늦은 이벤트 구분)
+  uint32_t nextFree;   // 빈 슬롯 목록의 다음 인덱스
+
+  size_t pending() const { return outLen - outOffset; }
+};
+
+/**
+ * 연결 풀 (슬랩): 시작할 때 Connection 배열 영역을 한 번에 잡아두고, 빈 슬롯은
+ * 인덱스 연결 리스트(free list)로 관리 -> accept/close 때 new/delete 없음.
+ * 영역은 mmap(0으로 채워진 페이지)이라 한 번도 안 쓴 슬롯은 메모리를 안 먹음.
+ * 리액터 스레드마다 하나씩 (스레드 간 공유 X, 락 X).
+ */
+struct ConnectionPool {
+  Connection *slots;
+  uint32_t capacity;
+  uint32_t nextUnused; // 아직 한 번도 안 쓴 첫 슬롯
+  uint32_t freeHead;   // 반납된 슬롯 목록 (NO_FREE_SLOT이면 비어 있음)
+  uint32_t used;
+  uint32_t peak;
+};
+
+// 리액터별 통계
+struct ReactorStats {
+  uint64_t accepts;
+  uint64_t acceptWakeups; // 리스너 이벤트 수 (accepts / acceptWakeups = 배치 크기)
+  uint64_t closes;
+  uint64_t rejected;      // 풀이 가득 차서 바로 닫은 연결
+  uint64_t staleEvents;   // 이미 닫힌 연결에 대한 늦은 이벤트
+  uint64_t hotPathAllocs; // accept/close 경로에서 일어난 힙 할당
+  uint64_t splicedBytes;  // splice로 받은 바이트
+  uint64_t copiedBytes;   // recv()로 받은 바이트 (복사 경로)
+  uint64_t spliceOff;     // splice가 안 돼서 복사 경로로 돌린 연결
+  uint64_t offloaded;     // 워커 풀로 넘긴 메시지
+  uint64_t offloadInline; // 버퍼 풀이 바닥나서 리액터에서 바로 처리한 메시지
+};
+
+thread_local ConnectionPool *t_pool = nullptr;
+thread_local BufferPool *t_buffers = nullptr;
+thread_local PipePool *t_pipes = nullptr;
+thread_local ReactorStats t_stats;
+
+/**
+ * [Task 15] 관리 포트로 내보내는 지표 (main에서 스레드 시작 전에 등록).
+ * ReactorStats는 종료 시 리액터별 요약, 이쪽은 실행 중 전체 합계.
+ */
+struct EchoMetrics {
+  metrics::Counter accepts;
+  metrics::Counter closes;
+  metrics::Counter rejected;
+  metrics::Counter bytesIn;
+  metrics::Counter bytesOut;
+  metrics::Counter eagainAccept;
+  metrics::Counter eagainRecv;
+  metrics::Counter eagainSend;
+  metrics::Gauge connections;
+  metrics::Gauge sendQueueBytes; // outBuf + 파이프에 밀린 바이트
+  metrics::Gauge pipesInUse;
+  metrics::Counter offloaded;
+  metrics::Gauge offloadInFlight;
+  metrics::Histogram eventsPerWait;
+  metrics::Histogram loopIterationNs;
+  metrics::Counter ticks;         // [Task 17]
+  metrics::Counter tickOverruns;
+  metrics::Histogram tickDurationNs;
+  metrics::Histogram tickJitterNs;
+};
+
+EchoMetrics g_metrics;
+int g_metricsPort = 0; // 0: 관리 포트 없음 (지표는 그래도 셈)
+
+void registerMetrics() {
+  g_metrics.accepts =
+      metrics::counter("echo_accepts_total", "Accepted connections");
+  g_metrics.closes = metrics::counter("echo_closes_total", "Closed connections");
+  g_metrics.rejected = metrics::counter(
+      "echo_rejected_total", "Connections closed because the pool was full");
+  g_metrics.bytesIn =
+      metrics::counter("echo_bytes_in_total", "Bytes received from clients");
+  g_metrics.bytesOut =
+      metrics::counter("echo_bytes_out_total", "Bytes sent to clients");
+  g_metrics.eagainAccept = metrics::counter(
+      "echo_eagain_total{op=\"accept\"}", "Calls that returned EAGAIN");
+  g_metrics.eagainRecv = metrics::counter("echo_eagain_total{op=\"recv\"}",
+                                          "Calls that returned EAGAIN");
+  g_metrics.eagainSend = metrics::counter("echo_eagain_total{op=\"send\"}",
+                                          "Calls that returned EAGAIN");
+  g_metrics.connections =
+      metrics::gauge("echo_connections", "Open client connections");
+  g_metrics.sendQueueBytes = metrics::gauge(
+      "echo_send_queue_bytes", "Echo bytes waiting for socket send buffer");
+  g_metrics.pipesInUse =
+      metrics::gauge("echo_splice_pipes_in_use", "Pipes lent to connections");
+  g_metrics.offloaded = metrics::counter(
+      "echo_offloaded_total", "Messages handed to the worker pool");
+  g_metrics.offloadInFlight = metrics::gauge(
+      "echo_offload_in_flight", "Messages being processed by the worker pool");
+  g_metrics.eventsPerWait = metrics::histogram(
+      "echo_epoll_events_per_wait", "Ready events returned by epoll_wait", 1.0,
+      11); // 1 .. 1024 (MAX_EVENTS)
+  g_metrics.loopIterationNs = metrics::histogram(
+      "echo_loop_iteration_seconds",
+      "Time spent handling one epoll_wait batch (1 in 16 sampled)", 1e-9,
+      31); // 1ns .. 1s
+  g_metrics.ticks = metrics::counter("echo_ticks_total", "Simulation ticks run");
+  g_metrics.tickOverruns = metrics::counter(
+      "echo_tick_overruns_total", "Ticks that finished after the next tick was due");
+  g_metrics.tickDurationNs = metrics::histogram(
+      "echo_tick_duration_seconds", "Time spent running one simulation tick",
+      1e-9, 31);
+  g_metrics.tickJitterNs = metrics::histogram(
+      "echo_tick_jitter_seconds", "Delay between scheduled and actual tick start",
+      1e-9, 31);
+}
+
+uint32_t g_poolCapacity = DEFAULT_MAX_CONNECTIONS; // 리액터 하나당 풀 크기
+
+const uint32_t NO_FREE_SLOT = 0xFFFFFFFF;
+
+void poolInit(ConnectionPool &pool, uint32_t capacity) {
+  // 0으로 채워진 페이지 = inUse false, generation 0 인 슬롯
+  bool hugePages = false;
+  pool.slots =
+      (Connection *)mapArena((size_t)capacity * sizeof(Connection), hugePages);
+  pool.capacity = capacity;
+  pool.nextUnused = 0;
+  pool.freeHead = NO_FREE_SLOT;
+  pool.used = 0;
+  pool.peak = 0;
+}
+
+Connection *poolAcquire(ConnectionPool &pool) {
+  Connection *conn;
+  if (pool.freeHead != NO_FREE_SLOT) {
+    conn = &pool.slots[pool.freeHead];
+    pool.freeHead = conn->nextFree;
+  } else if (pool.nextUnused < pool.capacity) {
+    conn = &pool.slots[pool.nextUnused++];
+  } else {
+    return nullptr;
+  }
+  conn->inUse = true;
+  pool.used++;
+  if (pool.used > pool.peak) {
+    pool.peak = pool.used;
   }
+  return conn;
+}
 
-  // Echo: 받은 데이터를 그대로 전송
-  send(clientSock, buffer, bytesRead, 0);
+void poolRelease(ConnectionPool &pool, Connection *conn) {
+  conn->inUse = false;
+  conn->generation++;
+  g_metrics.sendQueueBytes.add(-(int64_t)(conn->pending() + conn->pipeBytes));
+  if (conn->outBuf != nullptr) {
+    bufferRelease(*t_buffers, conn->outBuf, conn->outClass);
+    conn->outBuf = nullptr;
+  }
+  if (conn->pipeIndex >= 0) {
+    pipeRelease(*t_pipes, conn->pipeIndex, conn->pipeBytes);
+    conn->pipeIndex = -1;
+    conn->pipeBytes = 0;
+  }
+  conn->nextFree = (uint32_t)(conn - pool.slots);
+  std::swap(conn->nextFree, pool.freeHead);
+  pool.used--;
 }
 
 /**
- * Task 3-3: 클라이언트 메시지 처리 (Edge Triggered)
- * 주의: EAGAIN이 나올 때까지 반복해서 읽어야 함!
+ * epoll_event.data에 넣을 태그: Connection 포인터(data.ptr) 상위 16비트에
+ * 세대(generation)를 끼워 넣음 (x86-64/AArch64 유저 주소는 하위 48비트).
+ * 같은 epoll_wait 묶음 안에서 닫힌 뒤 다른 연결에 재사용된 슬롯으로
+ * 늦게 온 이벤트가 잘못 전달되는 것을 막음.
  */
-void handleClientET(int clientSock, int epollFd) {
-  char buffer[BUFFER_SIZE];
+uint64_t connectionTag(Connection *conn) {
+  return (uint64_t)(uintptr_t)conn | ((uint64_t)conn->generation << 48);
+}
 
-  // TODO: 구현하세요
-  while (true) {
-    int bytesRead = recv(clientSock, buffer, sizeof(buffer), 0);
+Connection *tagToConnection(uint64_t tag, uint16_t &generation) {
+  generation = (uint16_t)(tag >> 48);
+  return (Connection *)(uintptr_t)(tag & ((1ULL << 48) - 1));
+}
 
-    if (bytesRead < 0) {
+bool isLive(Connection *conn, uint16_t generation) {
+  return conn->inUse && conn->generation == generation;
+}
+
+int64_t nowMs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+struct TickLoop;
+extern thread_local TickLoop *t_tick; // [Task 17] 틱 모드 리액터면 non-null
+
+// 읽기를 멈춘 상태: 송신 대기가 많거나, 워커 풀이 이전 메시지를 처리 중
+// [Task 17] 틱 모드는 이번 틱에 쌓은 입력도 곧 outBuf로 가므로 같이 셈
+// (readPaused는 틱이 끝나야 정해져서, 안 세면 한 틱에 아레나 크기까지
+// 받아 outBuf가 버퍼 풀 최대 클래스를 넘음)
+bool readBlocked(const Connection *conn) {
+  return conn->readPaused || conn->offloadBusy ||
+         (t_tick != nullptr &&
+          conn->pending() + conn->tickQueued >= HIGH_WATER_MARK);
+}
+
+/**
+ * 현재 상태에 맞는 epoll 이벤트 (읽기 중단이면 EPOLLIN 제외, 남은 게 있으면
+ * EPOLLOUT 추가). 바뀐 경우에만 epoll_ctl 호출.
+ */
+void updateInterest(Connection *conn, int epollFd) {
+  uint32_t events = 0;
+  if (!readBlocked(conn)) {
+    events |= EPOLLIN;
+  }
+  if (conn->pending() > 0 || conn->pipeBytes > 0) {
+    events |= EPOLLOUT;
+  }
+  if (conn->edgeTrigger) {
+    events |= EPOLLET;
+  }
+  if (events != conn->events) {
+    epollModify(epollFd, conn->fd, events, connectionTag(conn));
+    conn->events = events;
+  }
+}
+
+/**
+ * 새 연결 슬롯 초기화 (epoll / uring 공통)
+ */
+void initConnection(Connection *conn, int fd, bool edgeTrigger) {
+  conn->fd = fd;
+  conn->edgeTrigger = edgeTrigger;
+  conn->outBuf = nullptr;
+  conn->outLen = 0;
+  conn->outOffset = 0;
+  conn->readPaused = false;
+  conn->offloadBusy = false;
+  conn->tickDirty = false;
+  conn->tickDeferIndex = -1;
+  conn->tickQueued = 0;
+  conn->events = edgeTrigger ? (EPOLLIN | EPOLLET) : EPOLLIN;
+  conn->acceptedAtMs = nowMs();
+  conn->lastActiveMs = conn->acceptedAtMs;
+  conn->bytesIn = 0;
+  conn->bytesOut = 0;
+  conn->heldHead = -1;
+  conn->heldTail = -1;
+  conn->heldBytes = 0;
+  conn->sendOffset = 0;
+  conn->sending = false;
+  conn->recvArmed = false;
+  conn->recvStarved = false;
+  conn->closing = false;
+  conn->pipeIndex = -1;
+  conn->pipeBytes = 0;
+  conn->spliceOff = false;
+}
+
+/**
+ * @param epollFd: uring 모드는 -1 (epoll에 등록 안 됨)
+ */
+void closeConnection(Connection *conn, int epollFd) {
+  uint64_t allocsBefore = t_allocCount;
+
+  alog::info("[-] Client disconnected (fd={})", conn->fd);
+  if (epollFd >= 0) {
+    epollRemove(epollFd, conn->fd);
+  }
+  close(conn->fd);
+  poolRelease(*t_pool, conn);
+
+  t_stats.closes++;
+  g_metrics.closes.inc();
+  t_stats.hotPathAllocs += t_allocCount - allocsBefore;
+}
+
+/**
+ * outBuf에 쌓인 데이터를 보낼 수 있는 만큼 전송
+ * @return false: 연결 에러 (호출 측에서 닫아야 함)
+ */
+bool flushPending(Connection *conn) {
+  while (conn->pending() > 0) {
+    ssize_t sent = send(conn->fd, conn->outBuf + conn->outOffset,
+                        conn->pending(), MSG_NOSIGNAL);
+    if (sent < 0) {
       if (errno == EAGAIN || errno == EWOULDBLOCK) {
-        // 더 이상 읽을 데이터 없음 (정상)
-        break;
+        g_metrics.eagainSend.inc();
+        break; // 소켓 송신 버퍼가 가득 참 -> EPOLLOUT 대기
       }
-      // 실제 에러
-      perror("recv() failed");
-      epollRemove(epollFd, clientSock);
-      close(clientSock);
-      return;
+      if (errno == EINTR) {
+        continue;
+      }
+      alog::warn("send() failed (fd={}): {}", conn->fd, alog::Errno(errno));
+      return false;
     }
+    conn->outOffset += sent;
+    conn->bytesOut += sent;
+    g_metrics.bytesOut.add(sent);
+    g_metrics.sendQueueBytes.add(-sent);
+  }
 
-    if (bytesRead == 0) {
-      // 연결 종료
-      std::cout << "[-] Client disconnected (fd=" << clientSock << ")"
-                << std::endl;
-      epollRemove(epollFd, clientSock);
-      close(clientSock);
-      return;
+  if (conn->pending() == 0 && conn->outBuf != nullptr) {
+    // 다 보냄 -> 버퍼 반납 (다시 밀릴 때 새로 빌림)
+    bufferRelease(*t_buffers, conn->outBuf, conn->outClass);
+    conn->outBuf = nullptr;
+    conn->outLen = 0;
+    conn->outOffset = 0;
+  }
+  return true;
+}
+
+/**
+ * 못 보낸 데이터를 outBuf 뒤에 붙임. 자리가 없으면 앞쪽 보낸 부분을 당기고,
+ * 그래도 모자라면 한 단계 큰 클래스 버퍼로 옮김.
+ * @return false: 버퍼 풀 고갈 (호출 측에서 닫아야 함)
+ */
+bool appendPending(Connection *conn, const char *data, size_t len) {
+  size_t pending = conn->pending();
+  size_t capacity =
+      conn->outBuf ? t_buffers->classes[conn->outClass].bufferSize : 0;
+
+  if (conn->outLen + len > capacity) {
+    if (pending + len <= capacity) {
+      memmove(conn->outBuf, conn->outBuf + conn->outOffset, pending);
+    } else {
+      uint8_t newClass;
+      char *newBuf = bufferAcquire(*t_buffers, pending + len, newClass);
+      if (newBuf == nullptr) {
+        alog::warn("[!] Buffer pool exhausted (fd={})", conn->fd);
+        return false;
+      }
+      if (conn->outBuf != nullptr) {
+        memcpy(newBuf, conn->outBuf + conn->outOffset, pending);
+        bufferRelease(*t_buffers, conn->outBuf, conn->outClass);
+      }
+      conn->outBuf = newBuf;
+      conn->outClass = newClass;
     }
+    conn->outLen = (uint32_t)pending;
+    conn->outOffset = 0;
+  }
+  memcpy(conn->outBuf + conn->outLen, data, len);
+  conn->outLen += (uint32_t)len;
+  g_metrics.sendQueueBytes.add((int64_t)len);
+  return true;
+}
 
-    // Echo
-    send(clientSock, buffer, bytesRead, 0);
+/**
+ * Echo 전송: 밀린 데이터가 없으면 바로 보내고, 못 보낸 나머지는 outBuf에 보관
+ * (순서 보장을 위해 밀린 데이터가 있으면 무조건 뒤에 붙임)
+ */
+bool queueSend(Connection *conn, const char *data, size_t len) {
+  size_t offset = 0;
+  if (conn->pending() == 0) {
+    while (offset < len) {
+      ssize_t sent = send(conn->fd, data + offset, len - offset, MSG_NOSIGNAL);
+      if (sent < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+          g_metrics.eagainSend.inc();
+          break;
+        }
+        if (errno == EINTR) {
+          continue;
+        }
+        alog::warn("send() failed (fd={}): {}", conn->fd, alog::Errno(errno));
+        return false;
+      }
+      offset += sent;
+      conn->bytesOut += sent;
+      g_metrics.bytesOut.add(sent);
+    }
   }
+  if (offset < len && !appendPending(conn, data + offset, len - offset)) {
+    return false;
+  }
+  if (conn->pending() > HIGH_WATER_MARK) {
+    conn->readPaused = true;
+  }
+  return true;
 }
 
-// ============================================================
-// TODO: 메인 이벤트 루프
-// ============================================================
+/**
+ * splice 경로를 탈 수 있는지: 처음 g_spliceAfter 바이트(핸드셰이크/헤더처럼
+ * 내용을 봐야 하는 구간)는 복사 경로, outBuf에 밀린 데이터가 있으면 순서를
+ * 지키기 위해 그것부터 다 보낸 뒤에 splice로 넘어감
+ */
+bool spliceReady(const Connection *conn) {
+  return g_useSplice && !conn->spliceOff && conn->bytesIn >= g_spliceAfter &&
+         conn->pending() == 0;
+}
 
 /**
- * Task 1-3, 1-4: Epoll 이벤트 루프
+ * 파이프에 남은 데이터를 소켓으로 보낼 수 있는 만큼 전송 (flushPending과 같은 역할)
+ * @return false: 연결 에러 (호출 측에서 닫아야 함)
  */
-void eventLoop(int serverSock, int epollFd, bool useEdgeTrigger) {
-  struct epoll_event events[MAX_EVENTS];
+bool flushPipe(Connection *conn) {
+  int readFd = t_pipes->pipes[conn->pipeIndex].readFd;
+  while (conn->pipeBytes > 0) {
+    ssize_t sent = splice(readFd, nullptr, conn->fd, nullptr, conn->pipeBytes,
+                          SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (sent < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        g_metrics.eagainSend.inc();
+        break; // 소켓 송신 버퍼가 가득 참 -> EPOLLOUT 대기
+      }
+      if (errno == EINTR) {
+        continue;
+      }
+      alog::warn("splice(pipe -> socket) failed (fd={}): {}", conn->fd,
+                 alog::Errno(errno));
+      return false;
+    }
+    conn->pipeBytes -= (uint32_t)sent;
+    conn->bytesOut += sent;
+    g_metrics.bytesOut.add(sent);
+    g_metrics.sendQueueBytes.add(-sent);
+  }
+  return true;
+}
 
-  std::cout << "[*] Server running... (Mode: "
-            << (useEdgeTrigger ? "Edge Trigger" : "Level Trigger") << ")"
-            << std::endl;
+/**
+ * splice 에코: 소켓 -> 파이프 -> 소켓. 파이프가 비어 있을 때만 더 받으므로
+ * 못 보낸 데이터는 파이프 용량(SPLICE_PIPE_SIZE)을 넘지 않음 -> 남으면 읽기를
+ * 멈추고 EPOLLOUT 대기 (outBuf의 HIGH_WATER_MARK와 같은 역할).
+ * LT는 이벤트당 한 번, ET는 EAGAIN까지 반복.
+ * @return false: 파이프를 못 빌렸거나 이 소켓은 splice 불가 -> 호출 측이
+ *         복사 경로로 처리 (true면 연결이 닫혔을 수 있음)
+ */
+bool handleSplice(Connection *conn, int epollFd) {
+  if (conn->pipeIndex < 0) {
+    conn->pipeIndex = pipeAcquire(*t_pipes);
+    if (conn->pipeIndex < 0) {
+      return false;
+    }
+  }
+  int writeFd = t_pipes->pipes[conn->pipeIndex].writeFd;
 
-  while (true) {
-    int numEvents = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+  while (conn->pipeBytes == 0) {
+    ssize_t received = splice(conn->fd, nullptr, writeFd, nullptr,
+                              SPLICE_PIPE_SIZE,
+                              SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (received < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        g_metrics.eagainRecv.inc();
+        break;
+      }
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EINVAL) {
+        // splice를 지원하지 않는 소켓 -> 이 연결은 계속 복사 경로
+        conn->spliceOff = true;
+        t_stats.spliceOff++;
+        pipeRelease(*t_pipes, conn->pipeIndex, 0);
+        conn->pipeIndex = -1;
+        return false;
+      }
+      alog::warn("splice(socket -> pipe) failed (fd={}): {}", conn->fd,
+                 alog::Errno(errno));
+      closeConnection(conn, epollFd);
+      return true;
+    }
+    if (received == 0) {
+      closeConnection(conn, epollFd);
+      return true;
+    }
 
-    if (numEvents < 0) {
-      perror("epoll_wait() failed");
+    conn->bytesIn += received;
+    t_stats.splicedBytes += received;
+    g_metrics.bytesIn.add(received);
+    g_metrics.sendQueueBytes.add(received);
+    conn->pipeBytes = (uint32_t)received;
+    if (!flushPipe(conn)) {
+      closeConnection(conn, epollFd);
+      return true;
+    }
+    if (!conn->edgeTrigger) {
       break;
     }
+  }
 
-    // 핵심: 준비된 소켓만 순회 (O(활성 소켓))
-    for (int i = 0; i < numEvents; i++) {
-      int fd = events[i].data.fd;
-
-      if (fd == serverSock) {
-        // 새 연결 요청
-        handleAccept(serverSock, epollFd, useEdgeTrigger);
-      } else {
-        // 클라이언트 데이터
-        if (useEdgeTrigger) {
-          handleClientET(fd, epollFd);
-        } else {
-          handleClientLT(fd, epollFd);
-        }
-      }
-    }
+  if (conn->pipeBytes == 0) {
+    // 다 보냄 -> 파이프 반납 (잠수 연결은 파이프를 잡고 있지 않음)
+    pipeRelease(*t_pipes, conn->pipeIndex, 0);
+    conn->pipeIndex = -1;
   }
+  conn->readPaused = conn->pipeBytes > 0;
+  conn->lastActiveMs = nowMs();
+  updateInterest(conn, epollFd);
+  return true;
 }
 
 // ============================================================
-// Main
+// [Task 16] 비싼 핸들러 떼어내기 (--offload, 작업 훔치기 풀 + 완료 큐)
 // ============================================================
 
-int main(int argc, char *argv[]) {
-  int port = DEFAULT_PORT;
-  bool useEdgeTrigger = false; // true로 바꾸면 ET 모드
+/**
+ * 압축/검증/게임 규칙 계산처럼 CPU를 오래 쓰는 핸들러를 리액터에서 돌리면
+ * 그동안 이 리액터의 다른 연결 에코가 전부 밀린다. --offload ROUNDS 면 받은
+ * 데이터를 워커 풀에 넘기고 (여기서는 "검증" = 페이로드 해시 ROUNDS번),
+ * 워커는 결과를 리액터별 완료 큐에 넣음 -> 완료 큐의 eventfd가 같은 epoll을
+ * 깨우고 리액터가 에코를 보냄.
+ * - 연결당 한 번에 하나만 넘김 (끝날 때까지 그 연결은 읽기 중단) -> 순서 보장
+ * - 데이터는 리액터의 버퍼 풀에서 빌림 (빌리고 반납하는 건 리액터만, 워커는
+ *   내용만 읽음). 풀이 바닥나면 리액터에서 바로 처리
+ * - 제출은 epoll_wait 묶음마다 submitBatch 한 번 (워커당 락 한 번)
+ * - 그 사이 연결이 닫히면 세대 번호로 걸러서 버퍼만 반납
+ */
+struct OffloadDone {
+  Connection *conn;
+  uint16_t generation;
+  uint8_t bufferClass;
+  uint32_t len;
+  char *data;
+  uint32_t digest; // 검증 결과 (여기서는 에코에 영향 없음)
+};
 
-  if (argc >= 2) {
-    port = atoi(argv[1]);
-  }
-  if (argc >= 3 && strcmp(argv[2], "et") == 0) {
-    useEdgeTrigger = true;
-  }
+typedef wsp::CompletionQueue<OffloadDone> OffloadQueue;
 
-  std::cout << "========================================" << std::endl;
-  std::cout << "  Quest 4: Epoll Echo Server (Linux)" << std::endl;
-  std::cout << "========================================" << std::endl;
-  std::cout << "[*] Starting server on port " << port << std::endl;
+wsp::ThreadPool *g_offloadPool = nullptr;
+int g_offloadRounds = 0;  // 0: 떼어내기 안 함
+int g_offloadThreads = 0; // 0: 코어 수
 
-  // 1. 서버 소켓 생성
-  int serverSock = createServerSocket(port);
-  std::cout << "[*] Server socket created (fd=" << serverSock << ")"
-            << std::endl;
+thread_local OffloadQueue *t_offloadDone = nullptr;
+thread_local std::vector<wsp::Task> *t_offloadBatch = nullptr;
+thread_local uint32_t t_offloadInFlight = 0;
 
-  // 2. Epoll 인스턴스 생성
-  int epollFd = createEpoll();
-  if (epollFd < 0) {
-    std::cerr << "[!] TODO: createEpoll() 구현 필요!" << std::endl;
-    close(serverSock);
-    return 1;
+// 검증 흉내: FNV-1a를 rounds번 (라운드마다 이전 결과가 씨앗)
+uint32_t validatePayload(const char *data, uint32_t len, int rounds) {
+  uint32_t hash = 2166136261u;
+  for (int r = 0; r < rounds; r++) {
+    for (uint32_t i = 0; i < len; i++) {
+      hash = (hash ^ (uint8_t)data[i]) * 16777619u;
+    }
   }
-  std::cout << "[*] Epoll instance created (fd=" << epollFd << ")" << std::endl;
+  return hash;
+}
 
-  // 3. 서버 소켓을 Epoll에 등록
-  uint32_t serverEvents = EPOLLIN;
-  if (useEdgeTrigger) {
-    serverEvents |= EPOLLET;
-    setNonBlocking(serverSock);
+/**
+ * 받은 데이터를 워커 풀로 (실제 제출은 flushOffloadBatch에서 묶어서)
+ * @return false: 연결 에러 (바로 처리 경로에서 send 실패)
+ */
+bool offloadEcho(Connection *conn, const char *data, uint32_t len) {
+  OffloadDone done;
+  done.data = bufferAcquire(*t_buffers, len, done.bufferClass);
+  if (done.data == nullptr) {
+    t_stats.offloadInline++;
+    validatePayload(data, len, g_offloadRounds);
+    return queueSend(conn, data, len);
   }
-  epollAdd(epollFd, serverSock, serverEvents);
+  memcpy(done.data, data, len);
+  done.conn = conn;
+  done.generation = conn->generation;
+  done.len = len;
+  done.digest = 0;
+  conn->offloadBusy = true;
 
-  // 4. 이벤트 루프 시작
-  eventLoop(serverSock, epollFd, useEdgeTrigger);
+  OffloadQueue *queue = t_offloadDone;
+  int rounds = g_offloadRounds;
+  t_offloadBatch->push_back([done, queue, rounds]() mutable {
+    done.digest = validatePayload(done.data, done.len, rounds);
+    queue->post(done);
+  });
+  t_offloadInFlight++;
+  t_stats.offloaded++;
+  g_metrics.offloaded.inc();
+  return true;
+}
 
-  // 정리
-  close(epollFd);
+void flushOffloadBatch() {
+  if (!t_offloadBatch->empty()) {
+    g_offloadPool->submitBatch(*t_offloadBatch);
+  }
+}
+
+// ============================================================
+// [Task 17] 고정 틱 시뮬레이션 (--tick HZ, timerfd를 같은 epoll에)
+// ============================================================
+
+/**
+ * 게임 서버처럼 "받은 즉시 에코" 대신 고정 주기(30/60Hz)로 시뮬레이션을 돌린다.
+ * - I/O 구간: 소켓 이벤트에서 받은 데이터는 처리하지 않고 리액터의 입력
+ *   아레나에 프레임으로 쌓기만 함
+ * - 틱 (timerfd, 태그 4): 쌓인 프레임을 순서대로 핸들러에 넣고 (--tick-work
+ *   ROUNDS면 검증 해시), 결과는 연결별 outBuf에 붙인 뒤 연결마다 send 한 번
+ * - 적응형 분할: 틱 비용(ns/입력 단위)을 이동 평균으로 재서, 다음 틱의 예상
+ *   비용이 주기의 TICK_SIM_SHARE를 넘을 만큼 쌓였으면 더 읽지 않음 (남은
+ *   데이터는 커널 버퍼 -> TCP 흐름 제어). 다음 틱 TICK_IO_MARGIN 전에는 남은
+ *   이벤트를 미루고 타이머만 기다림 -> 네트워크 폭주가 틱을 밀어내지 않음
+ * - ET는 미룬 이벤트를 다시 알려주지 않으므로 deferred에 보관했다가 틱 뒤에
+ *   먼저 처리 (LT는 epoll이 다시 알려 줌)
+ */
+struct TickFrame {
+  Connection *conn;
+  uint16_t generation;
+  uint32_t offset; // 입력 아레나 안 위치
+  uint32_t len;
+};
+
+/**
+ * 틱 지연/길이 히스토그램 (log-linear, ns 단위, 종료 시 리액터별 요약).
+ * 관리 포트에는 metrics.h의 2의 거듭제곱 버킷으로 따로 내보냄.
+ */
+struct TickHistogram {
+  static const int SUB_BUCKETS = 16;
+  static const int MAGNITUDES = 40;
+  uint64_t buckets[MAGNITUDES * SUB_BUCKETS];
+  uint64_t count;
+  uint64_t max;
+
+  void record(uint64_t value) {
+    int index = (int)value;
+    if (value >= SUB_BUCKETS) {
+      int magnitude = 63 - __builtin_clzll(value);
+      int sub = (int)((value >> (magnitude - 4)) & (SUB_BUCKETS - 1));
+      index = (magnitude - 3) * SUB_BUCKETS + sub;
+    }
+    if (index >= MAGNITUDES * SUB_BUCKETS) {
+      index = MAGNITUDES * SUB_BUCKETS - 1;
+    }
+    buckets[index]++;
+    count++;
+    if (value > max) {
+      max = value;
+    }
+  }
+
+  // 버킷 상한 기준 (max를 넘지 않게)
+  uint64_t percentile(double p) const {
+    if (count == 0) {
+      return 0;
+    }
+    uint64_t target = (uint64_t)(count * p / 100.0);
+    if (target >= count) {
+      target = count - 1;
+    }
+    uint64_t seen = 0;
+    for (int k = 0; k < MAGNITUDES * SUB_BUCKETS; k++) {
+      seen += buckets[k];
+      if (seen > target) {
+        if (k < SUB_BUCKETS) {
+          return k;
+        }
+        int shift = k / SUB_BUCKETS - 1;
+        uint64_t v = ((uint64_t)(SUB_BUCKETS + k % SUB_BUCKETS) << shift) +
+                     ((1ULL << shift) - 1);
+        return v < max ? v : max;
+      }
+    }
+    return max;
+  }
+};
+
+struct TickLoop {
+  int timerFd;
+  uint64_t periodNs;
+  uint64_t nextTickNs;  // 다음 틱 예정 시각 (CLOCK_MONOTONIC)
+  uint64_t simBudgetNs; // 틱 하나가 쓸 수 있는 시간 (나머지는 I/O)
+  double nsPerUnit;     // 입력 단위(바이트 + 프레임당 고정분)당 틱 비용 (이동 평균)
+
+  std::vector<char> input; // 입력 아레나 (시작 시 한 번 할당)
+  uint32_t inputLen;
+  uint64_t inputUnits;
+  std::vector<TickFrame> frames;
+  std::vector<TickFrame> flushes; // 이번 틱에 outBuf가 생긴 연결 (연결당 하나)
+  std::vector<struct epoll_event> deferred; // ET: 미룬 이벤트
+  std::vector<struct epoll_event> work;
+  bool throttled; // 이번 I/O 구간의 입력 예산을 다 씀
+  bool listenerDeferred;
+  uint32_t digest; // 검증 결과 누적 (에코에 영향 없음, 계산이 지워지지 않게)
+
+  // 통계
+  uint64_t ticks;
+  uint64_t overruns;   // 다음 틱 예정 시각을 넘겨서 끝난 틱
+  uint64_t missed;     // timerfd 만료가 2번 이상 쌓임 = 아예 건너뛴 틱
+  uint64_t throttles;  // 입력 예산 때문에 읽기를 멈춘 I/O 구간
+  uint64_t deferrals;  // 다음 I/O 구간으로 미룬 ET 이벤트
+  uint64_t framesRun;
+  TickHistogram duration; // 틱 시작 ~ 송신까지 끝 (ns)
+  TickHistogram jitter;   // 예정 시각 ~ 실제 시작 (ns)
+};
+
+int g_tickHz = 0;        // 0: 틱 없음 (받은 즉시 에코)
+int g_tickWorkRounds = 0; // 틱 핸들러의 검증 해시 횟수
+bool g_tickAdaptive = true; // false: 입력 예산/미루기 없음 (비교용)
+
+thread_local TickLoop *t_tick = nullptr;
+
+void tickInit(TickLoop &tick, int epollFd) {
+  tick.periodNs = 1000000000ULL / (uint64_t)g_tickHz;
+  tick.simBudgetNs = (uint64_t)(tick.periodNs * TICK_SIM_SHARE);
+  tick.nsPerUnit = 1.0; // 첫 몇 틱 동안 실제 값으로 수렴
+  tick.input.resize(TICK_INPUT_BYTES);
+  tick.inputLen = 0;
+  tick.inputUnits = 0;
+  tick.frames.reserve(4096);
+  tick.flushes.reserve(4096);
+  tick.deferred.reserve(MAX_EVENTS);
+  tick.work.reserve(MAX_EVENTS * 2);
+  tick.throttled = false;
+  tick.listenerDeferred = false;
+  tick.digest = 0;
+  tick.ticks = tick.overruns = tick.missed = 0;
+  tick.throttles = tick.deferrals = tick.framesRun = 0;
+  memset(&tick.duration, 0, sizeof(tick.duration));
+  memset(&tick.jitter, 0, sizeof(tick.jitter));
+
+  tick.timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (tick.timerFd < 0) {
+    errorExit("timerfd_create() failed");
+  }
+  // 절대 시각으로 시작 -> 틱 예정 시각을 nextTickNs로 정확히 따라감
+  tick.nextTickNs = metrics::nowNs() + tick.periodNs;
+  struct itimerspec spec;
+  spec.it_value.tv_sec = tick.nextTickNs / 1000000000ULL;
+  spec.it_value.tv_nsec = tick.nextTickNs % 1000000000ULL;
+  spec.it_interval.tv_sec = tick.periodNs / 1000000000ULL;
+  spec.it_interval.tv_nsec = tick.periodNs % 1000000000ULL;
+  timerfd_settime(tick.timerFd, TFD_TIMER_ABSTIME, &spec, nullptr);
+  epollAdd(epollFd, tick.timerFd, EPOLLIN, TICK_TIMER_TAG);
+}
+
+// 입력을 BUFFER_SIZE 더 받으면 다음 틱이 예산을 넘을지
+bool tickInputFull(TickLoop &tick) {
+  if (tick.inputLen + BUFFER_SIZE > tick.input.size()) {
+    return true;
+  }
+  if (!g_tickAdaptive) {
+    return false;
+  }
+  uint64_t units = tick.inputUnits + BUFFER_SIZE + TICK_FRAME_UNITS;
+  return tick.nsPerUnit * units > tick.simBudgetNs;
+}
+
+// I/O 구간을 끝낼 때인지 (다음 틱 직전이거나 입력 예산을 다 씀)
+bool tickShouldYield(TickLoop &tick) {
+  if (!g_tickAdaptive) {
+    return false;
+  }
+  return tick.throttled ||
+         metrics::nowNs() + TICK_IO_MARGIN_NS >= tick.nextTickNs;
+}
+
+/**
+ * ET 이벤트를 다음 I/O 구간으로 (리스너와 연결만 - 관리 포트는 LT).
+ * 밀린 연결에는 새 데이터마다 엣지가 또 오므로 대상마다 한 칸만 두고,
+ * 이미 있으면 이벤트 비트를 합침 (EPOLLIN으로 미뤄 둔 연결의 EPOLLOUT 엣지를
+ * 버리면 읽기 중단 상태에서 outBuf를 다시 비울 기회가 없음)
+ */
+void tickDefer(TickLoop &tick, const struct epoll_event &ev) {
+  if (ev.data.u64 == LISTENER_TAG) {
+    if (tick.listenerDeferred) {
+      return;
+    }
+    tick.listenerDeferred = true;
+  } else if (ev.data.u64 & 7) {
+    return; // 완료 큐 / 타이머 / 관리 포트 태그
+  } else {
+    uint16_t generation;
+    Connection *conn = tagToConnection(ev.data.u64, generation);
+    if (!isLive(conn, generation)) {
+      return;
+    }
+    if (conn->tickDeferIndex >= 0) {
+      tick.deferred[conn->tickDeferIndex].events |= ev.events;
+      return;
+    }
+    conn->tickDeferIndex = (int32_t)tick.deferred.size();
+  }
+  tick.deferred.push_back(ev);
+  tick.deferrals++;
+}
+
+/**
+ * 양보할 때 묶음의 남은 이벤트를 미룸. 이번 구간에 예산에 걸려 먼저 미뤄진
+ * 연결은 그 뒤로 돌림 (앞에 두면 다음 구간에도 그 연결이 예산을 먼저 다 써서
+ * 나머지 연결이 굶음)
+ */
+void tickDeferRemaining(TickLoop &tick, const struct epoll_event *batch,
+                        int from, int count) {
+  size_t served = tick.deferred.size();
+  for (int j = from; j < count; j++) {
+    tickDefer(tick, batch[j]);
+  }
+  if (served == 0 || served == tick.deferred.size()) {
+    return;
+  }
+  std::rotate(tick.deferred.begin(), tick.deferred.begin() + served,
+              tick.deferred.end());
+  for (size_t k = 0; k < tick.deferred.size(); k++) {
+    uint16_t generation;
+    Connection *conn = tagToConnection(tick.deferred[k].data.u64, generation);
+    if (tick.deferred[k].data.u64 != LISTENER_TAG && isLive(conn, generation)) {
+      conn->tickDeferIndex = (int32_t)k;
+    }
+  }
+}
+
+/**
+ * 틱 모드의 수신: 입력 아레나에 프레임으로 쌓기만 함 (LT는 recv 한 번,
+ * ET는 EAGAIN까지). 예산이 바닥나면 멈추고 ET는 자기 이벤트를 미룸.
+ */
+void handleClientTick(Connection *conn, int epollFd) {
+  TickLoop &tick = *t_tick;
+  while (!readBlocked(conn)) {
+    if (tickInputFull(tick)) {
+      if (!tick.throttled) {
+        tick.throttled = true;
+        tick.throttles++;
+      }
+      if (conn->edgeTrigger) {
+        struct epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.u64 = connectionTag(conn);
+        tickDefer(tick, ev);
+      }
+      break;
+    }
+
+    // 이 연결이 이번 틱에 더 쌓을 수 있는 양 (readBlocked가 0보다 큼을 보장)
+    size_t room = HIGH_WATER_MARK - conn->pending() - conn->tickQueued;
+    char *dst = tick.input.data() + tick.inputLen;
+    int bytesRead =
+        recv(conn->fd, dst, room < BUFFER_SIZE ? room : BUFFER_SIZE, 0);
+    if (bytesRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      g_metrics.eagainRecv.inc();
+      break;
+    }
+    if (bytesRead <= 0) {
+      closeConnection(conn, epollFd); // 쌓인 프레임은 틱에서 세대로 걸러짐
+      return;
+    }
+
+    conn->bytesIn += bytesRead;
+    t_stats.copiedBytes += bytesRead;
+    g_metrics.bytesIn.add(bytesRead);
+
+    TickFrame frame;
+    frame.conn = conn;
+    frame.generation = conn->generation;
+    frame.offset = tick.inputLen;
+    frame.len = (uint32_t)bytesRead;
+    tick.frames.push_back(frame);
+    tick.inputLen += bytesRead;
+    tick.inputUnits += bytesRead + TICK_FRAME_UNITS;
+    conn->tickQueued += bytesRead;
+
+    if (!conn->edgeTrigger) {
+      break; // LT: 남은 건 epoll이 다시 알려 줌
+    }
+  }
+  conn->lastActiveMs = nowMs();
+  updateInterest(conn, epollFd);
+}
+
+/**
+ * 틱 하나: 쌓인 프레임 처리 -> 연결마다 송신 한 번 -> 길이/지연/초과 기록.
+ * timerfd가 아직 안 울렸으면 (이미 읽은 만료의 늦은 epoll 알림) 아무것도 안 함.
+ */
+void runTick(TickLoop &tick, int epollFd) {
+  uint64_t expirations = 0;
+  if (read(tick.timerFd, &expirations, sizeof(expirations)) !=
+          (ssize_t)sizeof(expirations) ||
+      expirations == 0) {
+    return;
+  }
+  uint64_t start = metrics::nowNs();
+  // 만료가 여러 번 쌓였으면 그 사이 틱은 건너뜀 (따라잡기 X, 가장 최근 틱만)
+  uint64_t scheduled = tick.nextTickNs + (expirations - 1) * tick.periodNs;
+  tick.missed += expirations - 1;
+  tick.nextTickNs = scheduled + tick.periodNs;
+
+  // 1. 핸들러: 받은 순서대로 (같은 연결은 순서 보장)
+  for (size_t i = 0; i < tick.frames.size(); i++) {
+    TickFrame &frame = tick.frames[i];
+    Connection *conn = frame.conn;
+    if (!isLive(conn, frame.generation)) {
+      continue; // I/O 구간이나 앞 프레임 처리 중에 닫힌 연결
+    }
+    const char *data = tick.input.data() + frame.offset;
+    if (g_tickWorkRounds > 0) {
+      tick.digest ^= validatePayload(data, frame.len, g_tickWorkRounds);
+    }
+    if (!appendPending(conn, data, frame.len)) {
+      closeConnection(conn, epollFd);
+      continue;
+    }
+    if (!conn->tickDirty) {
+      conn->tickDirty = true;
+      tick.flushes.push_back(frame);
+    }
+  }
+  tick.framesRun += tick.frames.size();
+
+  // 2. 출력: 연결마다 한 번에 (못 보낸 건 EPOLLOUT 경로)
+  for (size_t i = 0; i < tick.flushes.size(); i++) {
+    Connection *conn = tick.flushes[i].conn;
+    if (!isLive(conn, tick.flushes[i].generation)) {
+      continue;
+    }
+    conn->tickDirty = false;
+    conn->tickQueued = 0; // 다 outBuf로 옮겨짐 -> 아래 updateInterest가 읽기 재개
+    if (!flushPending(conn)) {
+      closeConnection(conn, epollFd);
+      continue;
+    }
+    if (conn->pending() > HIGH_WATER_MARK) {
+      conn->readPaused = true;
+    }
+    updateInterest(conn, epollFd);
+  }
+
+  uint64_t end = metrics::nowNs();
+  uint64_t elapsed = end - start;
+  if (tick.inputUnits > 0) {
+    // 이동 평균 (1/8): 핸들러 비용이 바뀌면 몇 틱 안에 입력 예산이 따라감
+    double sample = (double)elapsed / tick.inputUnits;
+    tick.nsPerUnit += (sample - tick.nsPerUnit) / 8;
+  }
+  tick.frames.clear();
+  tick.flushes.clear();
+  tick.inputLen = 0;
+  tick.inputUnits = 0;
+  tick.throttled = false;
+
+  tick.ticks++;
+  tick.duration.record(elapsed);
+  tick.jitter.record(start - scheduled);
+  g_metrics.tickDurationNs.record(elapsed);
+  g_metrics.tickJitterNs.record(start - scheduled);
+  g_metrics.ticks.inc();
+  if (end > tick.nextTickNs) {
+    tick.overruns++;
+    g_metrics.tickOverruns.inc();
+  }
+}
+
+/**
+ * I/O 구간을 끝냄: 다음 틱까지 타이머만 기다렸다가 틱 실행
+ * (그 사이 들어온 소켓 데이터는 커널 버퍼에서 기다림)
+ */
+void tickWaitAndRun(TickLoop &tick, int epollFd) {
+  struct pollfd pfd;
+  pfd.fd = tick.timerFd;
+  pfd.events = POLLIN;
+  while (!g_stop) {
+    uint64_t now = metrics::nowNs();
+    int timeoutMs = now >= tick.nextTickNs
+                        ? 0
+                        : (int)((tick.nextTickNs - now) / 1000000) + 1;
+    int ready = poll(&pfd, 1, timeoutMs);
+    if (ready > 0) {
+      runTick(tick, epollFd);
+      return;
+    }
+    if (ready < 0 && errno != EINTR) {
+      return;
+    }
+  }
+}
+
+/**
+ * epoll_wait 묶음 준비: 타이머가 울렸으면 틱부터 돌리고, 미룬 ET 이벤트가
+ * 있으면 그것을 앞에 두고 이번 묶음을 뒤에 붙인 목록을 돌려줌
+ * @return batch에 든 이벤트 수
+ */
+int tickCollect(TickLoop &tick, struct epoll_event *events, int numEvents,
+                struct epoll_event *&batch, int epollFd) {
+  for (int i = 0; i < numEvents; i++) {
+    if (events[i].data.u64 == TICK_TIMER_TAG) {
+      runTick(tick, epollFd);
+    }
+  }
+  if (tick.deferred.empty()) {
+    batch = events;
+    return numEvents;
+  }
+  tick.work.swap(tick.deferred); // 처리 중에 새로 미루는 건 deferred로
+  tick.deferred.clear();
+  tick.listenerDeferred = false;
+  for (size_t i = 0; i < tick.work.size(); i++) {
+    uint16_t generation;
+    Connection *conn = tagToConnection(tick.work[i].data.u64, generation);
+    if (tick.work[i].data.u64 != LISTENER_TAG && isLive(conn, generation)) {
+      conn->tickDeferIndex = -1;
+    }
+  }
+  tick.work.insert(tick.work.end(), events, events + numEvents);
+  batch = tick.work.data();
+  return (int)tick.work.size();
+}
+
+/**
+ * 종료 시 리액터별 틱 요약 (us)
+ */
+void printTickStats(const TickLoop &tick) {
+  std::cout << "[*] Tick: hz=" << g_tickHz << " ticks=" << tick.ticks
+            << " overruns=" << tick.overruns << " missed=" << tick.missed
+            << " frames=" << tick.framesRun << " throttles=" << tick.throttles
+            << " deferred=" << tick.deferrals
+            << " ns_per_unit=" << tick.nsPerUnit << " digest=" << tick.digest
+            << std::endl;
+  const TickHistogram *hists[] = {&tick.duration, &tick.jitter};
+  const char *names[] = {"duration", "jitter"};
+  for (int h = 0; h < 2; h++) {
+    std::cout << "[*] Tick " << names[h]
+              << " (us): p50=" << hists[h]->percentile(50) / 1000.0
+              << " p99=" << hists[h]->percentile(99) / 1000.0
+              << " p99.9=" << hists[h]->percentile(99.9) / 1000.0
+              << " max=" << hists[h]->max / 1000.0 << std::endl;
+  }
+}
+
+// ============================================================
+// TODO: 이벤트 핸들러
+// ============================================================
+
+/**
+ * Task 1-3, 2-1: 새 클라이언트 연결 처리
+ *
+ * 연결당 시스템 콜: accept4(Non-blocking + CLOEXEC를 한 번에) + epoll_ctl(ADD).
+ * 리스너는 Non-blocking이라 EAGAIN에서 멈춤.
+ * - LT: 한 번에 ACCEPT_BATCH개까지만 받고 이벤트 루프로 돌아감 -> 재접속
+ *   폭주 중에도 이미 붙은 연결들의 에코가 밀리지 않음 (남은 연결은 epoll이
+ *   다시 알려줌)
+ * - ET: 엣지를 놓치면 다시 알려주지 않으므로 EAGAIN까지 전부 받음
+ */
+void handleAccept(int serverSock, int epollFd, bool useEdgeTrigger) {
+  t_stats.acceptWakeups++;
+  for (int n = 0; useEdgeTrigger || n < ACCEPT_BATCH; n++) {
+    struct sockaddr_in clientAddr;
+    socklen_t clientLen = sizeof(clientAddr);
+
+    int clientSock =
+        accept4(serverSock, (struct sockaddr *)&clientAddr, &clientLen,
+                SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (clientSock < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        g_metrics.eagainAccept.inc();
+        break; // 더 이상 대기 중인 연결 없음 (다른 리액터가 먼저 가져갔을 수도)
+      }
+      if (errno == EINTR || errno == ECONNABORTED) {
+        continue; // 큐에서 꺼내기 전에 클라이언트가 끊음
+      }
+      alog::error("accept4() failed: {}", alog::Errno(errno));
+      return;
+    }
+
+    uint64_t allocsBefore = t_allocCount;
+
+    Connection *conn = poolAcquire(*t_pool);
+    if (conn == nullptr) {
+      // 풀이 가득 참 -> 받자마자 닫음 (메모리 한도 보호)
+      close(clientSock);
+      t_stats.rejected++;
+      g_metrics.rejected.inc();
+      continue;
+    }
+
+    // 포맷팅과 write()는 로거 스레드에서 (여기서는 레코드 하나만 씀)
+    alog::info("[+] Client connected: {}:{} (fd={})",
+               alog::Ipv4(clientAddr.sin_addr.s_addr),
+               ntohs(clientAddr.sin_port), clientSock);
+
+    // LT 모드도 Non-blocking (accept4에서 설정): 송신 버퍼가 가득 찼을 때
+    // send()에서 루프 전체가 멈추지 않고 EAGAIN -> outBuf -> EPOLLOUT 경로로
+    initConnection(conn, clientSock, useEdgeTrigger);
+
+    // data.ptr(+세대 태그)로 등록 -> 이벤트에서 fd로 다시 찾을 필요 없음
+    epollAdd(epollFd, clientSock, conn->events, connectionTag(conn));
+
+    t_stats.accepts++;
+    g_metrics.accepts.inc();
+    t_stats.hotPathAllocs += t_allocCount - allocsBefore;
+  }
+}
+
+/**
+ * Task 2-2, 2-3: 클라이언트 메시지 처리 (Level Triggered)
+ */
+void handleClientLT(Connection *conn, int epollFd) {
+  if (t_tick != nullptr) {
+    handleClientTick(conn, epollFd); // [Task 17] 틱까지 쌓아 둠
+    return;
+  }
+  if (spliceReady(conn) && handleSplice(conn, epollFd)) {
+    return;
+  }
+
+  char buffer[BUFFER_SIZE];
+
+  int bytesRead = recv(conn->fd, buffer, sizeof(buffer), 0);
+
+  if (bytesRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+    g_metrics.eagainRecv.inc();
+    return;
+  }
+  if (bytesRead <= 0) {
+    // 연결 종료 또는 에러
+    closeConnection(conn, epollFd);
+    return;
+  }
+
+  conn->bytesIn += bytesRead;
+  t_stats.copiedBytes += bytesRead;
+  g_metrics.bytesIn.add(bytesRead);
+  conn->lastActiveMs = nowMs();
+
+  // Echo: 받은 데이터를 그대로 전송 (못 보낸 건 outBuf로)
+  // [Task 16] --offload 면 워커 풀을 거쳐서 (완료 큐에서 전송)
+  bool ok = g_offloadPool != nullptr ? offloadEcho(conn, buffer, bytesRead)
+                                     : queueSend(conn, buffer, bytesRead);
+  if (!ok) {
+    closeConnection(conn, epollFd);
+    return;
+  }
+  updateInterest(conn, epollFd);
+}
+
+/**
+ * Task 3-3: 클라이언트 메시지 처리 (Edge Triggered)
+ * 주의: EAGAIN이 나올 때까지 반복해서 읽어야 함!
+ * (단, outBuf가 HIGH_WATER_MARK를 넘으면 읽기를 멈춤 -> 재개 시 직접 다시 호출)
+ */
+void handleClientET(Connection *conn, int epollFd) {
+  if (t_tick != nullptr) {
+    handleClientTick(conn, epollFd); // [Task 17]
+    return;
+  }
+  char buffer[BUFFER_SIZE];
+
+  while (!readBlocked(conn)) {
+    // 검사 구간을 넘었으면 나머지는 splice로
+    if (spliceReady(conn) && handleSplice(conn, epollFd)) {
+      return;
+    }
+
+    int bytesRead = recv(conn->fd, buffer, sizeof(buffer), 0);
+
+    if (bytesRead < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        // 더 이상 읽을 데이터 없음 (정상)
+        g_metrics.eagainRecv.inc();
+        break;
+      }
+      // 실제 에러
+      alog::warn("recv() failed (fd={}): {}", conn->fd, alog::Errno(errno));
+      closeConnection(conn, epollFd);
+      return;
+    }
+
+    if (bytesRead == 0) {
+      // 연결 종료
+      closeConnection(conn, epollFd);
+      return;
+    }
+
+    conn->bytesIn += bytesRead;
+    t_stats.copiedBytes += bytesRead;
+    g_metrics.bytesIn.add(bytesRead);
+
+    // Echo (--offload 면 워커 풀로 넘기고 끝날 때까지 읽기 중단)
+    bool ok = g_offloadPool != nullptr ? offloadEcho(conn, buffer, bytesRead)
+                                       : queueSend(conn, buffer, bytesRead);
+    if (!ok) {
+      closeConnection(conn, epollFd);
+      return;
+    }
+  }
+  conn->lastActiveMs = nowMs();
+  updateInterest(conn, epollFd);
+}
+
+/**
+ * EPOLLOUT: 밀린 데이터 전송, LOW_WATER_MARK 아래로 내려가면 읽기 재개
+ */
+void handleWritable(Connection *conn, int epollFd) {
+  if (conn->pipeBytes > 0) {
+    // splice 모드: 파이프에 남은 것 전송, 다 보내면 파이프 반납 후 읽기 재개
+    if (!flushPipe(conn)) {
+      closeConnection(conn, epollFd);
+      return;
+    }
+    if (conn->pipeBytes == 0) {
+      pipeRelease(*t_pipes, conn->pipeIndex, 0);
+      conn->pipeIndex = -1;
+      conn->readPaused = false;
+      if (conn->edgeTrigger) {
+        handleClientET(conn, epollFd);
+        return;
+      }
+    }
+    updateInterest(conn, epollFd);
+    return;
+  }
+
+  if (!flushPending(conn)) {
+    closeConnection(conn, epollFd);
+    return;
+  }
+
+  if (conn->readPaused && conn->pending() < LOW_WATER_MARK) {
+    conn->readPaused = false;
+    if (conn->edgeTrigger) {
+      // ET는 멈춘 동안 들어온 데이터에 대해 다시 알려주지 않으므로 직접 읽음
+      handleClientET(conn, epollFd);
+      return;
+    }
+  }
+  updateInterest(conn, epollFd);
+}
+
+/**
+ * [Task 16] 완료 큐 eventfd: 끝난 메시지를 에코하고 그 연결의 읽기 재개.
+ * drain()이 0을 돌려줄 때까지 (그때 다시 잠들 준비까지 끝남)
+ */
+void handleOffloadDone(int epollFd) {
+  OffloadDone done[OFFLOAD_DRAIN_BATCH];
+  size_t n;
+  while ((n = t_offloadDone->drain(done, OFFLOAD_DRAIN_BATCH)) > 0) {
+    for (size_t i = 0; i < n; i++) {
+      Connection *conn = done[i].conn;
+      t_offloadInFlight--;
+      if (!isLive(conn, done[i].generation)) {
+        // 처리 중에 닫힌 연결 (슬롯은 다른 연결이 쓰고 있을 수도)
+        bufferRelease(*t_buffers, done[i].data, done[i].bufferClass);
+        continue;
+      }
+      bool ok = queueSend(conn, done[i].data, done[i].len);
+      bufferRelease(*t_buffers, done[i].data, done[i].bufferClass);
+      conn->offloadBusy = false;
+      if (!ok) {
+        closeConnection(conn, epollFd);
+        continue;
+      }
+      if (conn->edgeTrigger && !conn->readPaused) {
+        // 처리하는 동안 들어온 데이터는 ET가 다시 알려주지 않으므로 직접 읽음
+        handleClientET(conn, epollFd);
+      } else {
+        updateInterest(conn, epollFd);
+      }
+    }
+  }
+  g_metrics.offloadInFlight.set(t_offloadInFlight);
+}
+
+// ============================================================
+// TODO: 메인 이벤트 루프
+// ============================================================
+
+/**
+ * 종료 시 리액터별 통계 (연결 풀 + 버퍼 풀)
+ */
+void printReactorStats(const ConnectionPool &pool, const BufferPool &buffers) {
+  alog::flush(); // 이 리액터가 남긴 로그가 통계보다 먼저 나오도록
+  std::cout << "[*] Reactor stats: accepts=" << t_stats.accepts
+            << " accept_wakeups=" << t_stats.acceptWakeups
+            << " closes=" << t_stats.closes << " rejected=" << t_stats.rejected
+            << " stale_events=" << t_stats.staleEvents
+            << " pool_peak=" << pool.peak << "/" << pool.capacity
+            << " hot_path_allocs=" << t_stats.hotPathAllocs << std::endl;
+  std::cout << "[*] Buffer pool" << (buffers.hugePages ? " (hugetlb)" : "")
+            << ": exhausted=" << buffers.exhausted;
+  for (int c = 0; c < NUM_BUFFER_CLASSES; c++) {
+    const BufferClass &bc = buffers.classes[c];
+    std::cout << " " << bc.bufferSize / 1024 << "K=" << bc.peak << "/"
+              << bc.capacity;
+  }
+  std::cout << " (peak/capacity)" << std::endl;
+}
+
+/**
+ * splice 모드 통계: splice로 옮긴 바이트 비율과 파이프 풀 사용량
+ */
+void printSpliceStats(const PipePool &pipes) {
+  std::cout << "[*] Splice: spliced_bytes=" << t_stats.splicedBytes
+            << " copied_bytes=" << t_stats.copiedBytes
+            << " splice_off_conns=" << t_stats.spliceOff
+            << " pipes_peak=" << pipes.peak << "/" << pipes.capacity
+            << " pipes_created=" << pipes.created
+            << " pipe_exhausted=" << pipes.exhausted << std::endl;
+}
+
+/**
+ * [Task 15] 관리 포트 이벤트: 리스너면 연결을 받아 같은 epoll에 등록하고,
+ * 연결이면 요청을 읽고 지표를 응답한 뒤 닫음 (close가 epoll 등록도 지움)
+ */
+void handleAdminEvent(uint64_t tag, int adminSock, int epollFd) {
+  if (tag == ADMIN_LISTENER_TAG) {
+    for (;;) {
+      int fd = accept4(adminSock, nullptr, nullptr,
+                       SOCK_NONBLOCK | SOCK_CLOEXEC);
+      if (fd < 0) {
+        break; // EAGAIN 또는 에러 (관리 포트라 무시)
+      }
+      epollAdd(epollFd, fd, EPOLLIN, ((uint64_t)fd << 2) | ADMIN_CLIENT_BIT);
+    }
+    return;
+  }
+  metrics::serveAdmin((int)(tag >> 2));
+}
+
+/**
+ * 이벤트 하나 처리 (epoll_data 태그로 리스너 / 완료 큐 / 관리 포트 / 연결 구분)
+ */
+void handleEvent(const struct epoll_event &event, int serverSock, int epollFd,
+                 bool useEdgeTrigger, int adminSock) {
+  if (event.data.u64 == LISTENER_TAG) {
+    // 새 연결 요청
+    handleAccept(serverSock, epollFd, useEdgeTrigger);
+    return;
+  }
+  if (event.data.u64 == OFFLOAD_DONE_TAG) {
+    handleOffloadDone(epollFd);
+    return;
+  }
+  if (event.data.u64 == TICK_TIMER_TAG) {
+    return; // [Task 17] 묶음 처리 전에 tickCollect가 이미 돌림
+  }
+  if (event.data.u64 & (ADMIN_LISTENER_TAG | ADMIN_CLIENT_BIT)) {
+    handleAdminEvent(event.data.u64, adminSock, epollFd);
+    return;
+  }
+
+  uint16_t generation;
+  Connection *conn = tagToConnection(event.data.u64, generation);
+  if (!isLive(conn, generation)) {
+    // 같은 묶음 앞쪽에서 이미 닫힌 연결 (슬롯이 재사용됐을 수도 있음)
+    t_stats.staleEvents++;
+    return;
+  }
+  uint32_t ev = event.events;
+
+  // 보낼 수 있게 됨 -> 밀린 데이터부터 (핸들러 안에서 닫힐 수 있으므로
+  // 이후에는 세대로 다시 확인)
+  if (ev & EPOLLOUT) {
+    handleWritable(conn, epollFd);
+    if (!isLive(conn, generation)) {
+      return;
+    }
+  }
+
+  // 클라이언트 데이터 (에러/끊김도 recv()에서 0 또는 -1로 확인)
+  if ((ev & (EPOLLIN | EPOLLHUP | EPOLLERR)) && !readBlocked(conn)) {
+    if (useEdgeTrigger) {
+      handleClientET(conn, epollFd);
+    } else {
+      handleClientLT(conn, epollFd);
+    }
+  } else if ((ev & (EPOLLHUP | EPOLLERR)) && readBlocked(conn)) {
+    closeConnection(conn, epollFd);
+  }
+}
+
+/**
+ * Task 1-3, 1-4: Epoll 이벤트 루프
+ * @param adminSock: 지표 관리 포트 리스너 (-1이면 없음, 리액터 하나만 가짐)
+ */
+void eventLoop(int serverSock, int epollFd, bool useEdgeTrigger,
+               int adminSock) {
+  struct epoll_event events[MAX_EVENTS];
+
+  // 이 리액터 전용 연결 풀 (시작 시 한 번만 할당)
+  ConnectionPool pool;
+  poolInit(pool, g_poolCapacity);
+  t_pool = &pool;
+  BufferPool buffers;
+  bufferPoolInit(buffers, g_bufferMemPerReactor, g_useHugePages);
+  t_buffers = &buffers;
+  PipePool pipes;
+  pipePoolInit(pipes, g_useSplice ? DEFAULT_SPLICE_PIPES : 0);
+  t_pipes = &pipes;
+  memset(&t_stats, 0, sizeof(t_stats));
+  if (adminSock >= 0) {
+    epollAdd(epollFd, adminSock, EPOLLIN, ADMIN_LISTENER_TAG);
+  }
+  // [Task 16] 워커 풀 결과가 돌아오는 완료 큐 (--offload 일 때만 epoll에 등록)
+  OffloadQueue offloadDone(g_offloadPool != nullptr ? OFFLOAD_QUEUE_SIZE : 2);
+  std::vector<wsp::Task> offloadBatch;
+  t_offloadDone = &offloadDone;
+  t_offloadBatch = &offloadBatch;
+  t_offloadInFlight = 0;
+  if (g_offloadPool != nullptr) {
+    epollAdd(epollFd, offloadDone.fd(), EPOLLIN, OFFLOAD_DONE_TAG);
+  }
+  // [Task 17] 고정 틱 (--tick HZ 일 때만 timerfd 등록)
+  TickLoop tick;
+  t_tick = nullptr;
+  if (g_tickHz > 0) {
+    tickInit(tick, epollFd);
+    t_tick = &tick;
+  }
+  uint64_t iteration = 0;
+
+  std::cout << "[*] Server running... (Mode: "
+            << (useEdgeTrigger ? "Edge Trigger" : "Level Trigger") << ")"
+            << std::endl;
+
+  while (!g_stop) {
+    // 1초마다 깨어나서 종료 신호 확인 (미룬 이벤트가 있으면 기다리지 않음)
+    bool hasDeferred = t_tick != nullptr && !tick.deferred.empty();
+    int numEvents =
+        epoll_wait(epollFd, events, MAX_EVENTS, hasDeferred ? 0 : 1000);
+
+    if (numEvents < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      perror("epoll_wait() failed");
+      break;
+    }
+    if (numEvents == 0 && !hasDeferred) {
+      continue; // 타임아웃 (지표에 안 넣음)
+    }
+    // 시계 읽기(묶음당 2번)는 이벤트 처리 비용과 맞먹을 수 있어서 표본만
+    bool sampled = (++iteration & LOOP_SAMPLE_MASK) == 0;
+    uint64_t iterationStart = sampled ? metrics::nowNs() : 0;
+
+    // [Task 17] 틱 모드: 타이머부터 (틱이 소켓 처리 뒤로 밀리지 않게),
+    // 지난번에 미룬 ET 이벤트는 이번 묶음 앞에 붙임
+    struct epoll_event *batch = events;
+    int batchSize = numEvents;
+    if (t_tick != nullptr) {
+      batchSize = tickCollect(tick, events, numEvents, batch, epollFd);
+    }
+
+    // 핵심: 준비된 소켓만 순회 (O(활성 소켓))
+    for (int i = 0; i < batchSize; i++) {
+      // [Task 17] 다음 틱이 가깝거나 입력 예산을 다 썼으면 남은 이벤트는
+      // 틱 뒤로 (LT는 epoll이 다시 알려 주고, ET만 보관)
+      if (t_tick != nullptr && tickShouldYield(tick)) {
+        if (useEdgeTrigger) {
+          tickDeferRemaining(tick, batch, i, batchSize);
+        }
+        tickWaitAndRun(tick, epollFd);
+        break;
+      }
+      handleEvent(batch[i], serverSock, epollFd, useEdgeTrigger, adminSock);
+    }
+
+    // 이번 묶음에서 떼어낸 메시지를 한 번에 제출
+    if (g_offloadPool != nullptr) {
+      flushOffloadBatch();
+      g_metrics.offloadInFlight.set(t_offloadInFlight);
+    }
+
+    // 지표: 묶음 하나 처리 시간(표본) + 묶음 크기, 큐 깊이 (묶음당 한 번)
+    if (sampled) {
+      g_metrics.loopIterationNs.record(metrics::nowNs() - iterationStart);
+    }
+    g_metrics.eventsPerWait.record((uint64_t)numEvents);
+    g_metrics.connections.set(pool.used);
+    g_metrics.pipesInUse.set(pipes.used);
+  }
+
+  // 워커가 아직 들고 있는 메시지: 완료 큐가 이 스택에 있으므로 다 돌아올
+  // 때까지 기다렸다가 버퍼만 반납 (연결은 아래 종료와 함께 정리)
+  while (t_offloadInFlight > 0) {
+    OffloadDone done[OFFLOAD_DRAIN_BATCH];
+    size_t n = offloadDone.waitDrain(done, OFFLOAD_DRAIN_BATCH);
+    for (size_t i = 0; i < n; i++) {
+      bufferRelease(buffers, done[i].data, done[i].bufferClass);
+    }
+    t_offloadInFlight -= (uint32_t)n;
+  }
+
+  printReactorStats(pool, buffers);
+  if (g_useSplice) {
+    printSpliceStats(pipes);
+  }
+  if (g_offloadPool != nullptr) {
+    std::cout << "[*] Offload: offloaded=" << t_stats.offloaded
+              << " inline=" << t_stats.offloadInline << std::endl;
+  }
+  if (t_tick != nullptr) {
+    printTickStats(tick);
+    close(tick.timerFd);
+    t_tick = nullptr;
+  }
+}
+
+// ============================================================
+// io_uring 엔진 (uring 모드)
+// ============================================================
+
+/**
+ * epoll: 준비 알림(epoll_wait) -> recv() -> send() = 이벤트마다 시스템 콜 3번.
+ * io_uring: 요청(SQE)을 공유 링에 쌓아 두고 io_uring_enter() 한 번으로
+ * 제출 + 완료(CQE) 대기. liburing 없이 시스템 콜과 mmap으로 링을 직접 다룸.
+ *
+ * - multishot accept : 한 번 걸어 두면 연결마다 CQE가 계속 나옴
+ * - multishot recv + provided buffer ring : 데이터가 오면 커널이 링에서 버퍼를
+ *   골라 씀 (연결마다 버퍼를 미리 걸어 둘 필요 X)
+ * - send : 받은 provided buffer를 연결별 목록에 걸어 두고 그 버퍼에서 바로 보냄
+ *   (유저 공간 복사 0회), 한 바퀴 동안 쌓인 send는 다음 io_uring_enter() 한 번에
+ * - --sqpoll : 커널 스레드가 SQ를 폴링 -> 제출에도 시스템 콜이 필요 없음
+ *
+ * 순서 보장: 연결마다 send는 한 번에 하나만, 목록 앞에서부터.
+ * 흐름 제어: 연결이 붙잡은 버퍼가 HIGH_WATER_MARK를 넘으면 recv 취소, 전체는
+ * provided buffer 개수로 묶임 (바닥나면 ENOBUFS -> 반납될 때 다시 recv).
+ * 닫기: 걸려 있는 recv/send가 모두 끝난 뒤에 슬롯/버퍼 반납 (커널이 아직 쓰는
+ * 버퍼를 다른 연결이 재사용하지 않도록).
+ */
+
+#define URING_ENTRIES 4096
+#define RECV_BUFFER_COUNT 4096 // provided buffer 개수 (2의 거듭제곱)
+#define RECV_BUFFER_SIZE 4096
+#define RECV_BUFFER_GROUP 0
+
+// user_data 하위 3비트 = 요청 종류 (Connection은 8바이트 정렬)
+enum UringOp { OP_ACCEPT = 1, OP_RECV = 2, OP_SEND = 3, OP_CANCEL = 4 };
+const uint64_t OP_MASK = 7;
+
+bool g_useUring = false;
+bool g_useSqpoll = false;
+
+struct Uring {
+  int fd;
+  bool sqpoll;
+
+  // SQ (제출 링)
+  unsigned *sqHead;
+  unsigned *sqTail;
+  unsigned *sqMask;
+  unsigned *sqFlags;
+  unsigned sqEntries;
+  struct io_uring_sqe *sqes;
+  unsigned sqLocalTail; // 채웠지만 아직 커널에 알리지 않은 위치까지
+  unsigned sqSubmitted;
+
+  // CQ (완료 링)
+  unsigned *cqHead;
+  unsigned *cqTail;
+  unsigned *cqMask;
+  struct io_uring_cqe *cqes;
+
+  // provided buffer ring (recv용)
+  struct io_uring_buf_ring *bufRing;
+  char *recvArena;
+  uint16_t bufTail;
+  int32_t *bufNext;  // 연결별 보낼 목록 (버퍼 ID 연결 리스트)
+  uint32_t *bufLen;  // 버퍼에 받은 바이트
+  uint32_t recycled; // 이번 바퀴에 반납된 버퍼 수
+  std::vector<uint64_t> starved; // 버퍼를 기다리는 연결 (태그)
+
+  // 통계
+  uint64_t enterCalls;
+  uint64_t sqesSubmitted;
+  uint64_t noBuffers; // provided buffer가 바닥나서 recv가 멈춘 횟수
+};
+
+int uringSetup(unsigned entries, struct io_uring_params *params) {
+  return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+int uringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags,
+               void *arg, size_t argSize) {
+  return (int)syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags,
+                      arg, argSize);
+}
+
+int uringRegister(int fd, unsigned opcode, void *arg, unsigned nrArgs) {
+  return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs);
+}
+
+void *mapRing(int fd, size_t bytes, uint64_t offset) {
+  void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, fd, (off_t)offset);
+  if (p == MAP_FAILED) {
+    errorExit("mmap(io_uring) failed");
+  }
+  return p;
+}
+
+/**
+ * provided buffer를 링에 돌려줌 (커널이 다음 recv에 다시 씀)
+ */
+void uringRecycleBuffer(Uring &ring, uint16_t bid) {
+  // 주의: C++에서는 헤더의 flexible array(bufs)가 빈 구조체 때문에 8바이트
+  // 밀려서 잡힘 -> 링 시작 주소를 io_uring_buf 배열로 직접 씀
+  struct io_uring_buf *bufs = (struct io_uring_buf *)ring.bufRing;
+  struct io_uring_buf *buf = &bufs[ring.bufTail & (RECV_BUFFER_COUNT - 1)];
+  buf->addr = (uint64_t)(uintptr_t)(ring.recvArena +
+                                    (size_t)bid * RECV_BUFFER_SIZE);
+  buf->len = RECV_BUFFER_SIZE;
+  buf->bid = bid;
+  ring.bufTail++;
+  ring.recycled++;
+  __atomic_store_n(&ring.bufRing->tail, ring.bufTail, __ATOMIC_RELEASE);
+}
+
+void uringInit(Uring &ring, bool sqpoll) {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = URING_ENTRIES * 4; // 한 바퀴에 CQE가 몰려도 안 넘치게
+  if (sqpoll) {
+    params.flags |= IORING_SETUP_SQPOLL;
+    params.sq_thread_idle = 1000; // 1초 동안 일이 없으면 폴링 스레드 잠듦
+  } else {
+    params.flags |= IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_COOP_TASKRUN;
+  }
+
+  ring.fd = uringSetup(URING_ENTRIES, &params);
+  if (ring.fd < 0 && errno == EINVAL && !sqpoll) {
+    // 오래된 커널: 최적화 플래그 없이 다시
+    params.flags = IORING_SETUP_CQSIZE;
+    ring.fd = uringSetup(URING_ENTRIES, &params);
+  }
+  if (ring.fd < 0) {
+    errorExit("io_uring_setup() failed");
+  }
+  ring.sqpoll = sqpoll;
+
+  // 링 3개를 mmap (SINGLE_MMAP이면 SQ/CQ 링이 한 영역)
+  size_t sqBytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  size_t cqBytes =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (singleMmap && cqBytes > sqBytes) {
+    sqBytes = cqBytes;
+  }
+  char *sq = (char *)mapRing(ring.fd, sqBytes, IORING_OFF_SQ_RING);
+  char *cq =
+      singleMmap ? sq : (char *)mapRing(ring.fd, cqBytes, IORING_OFF_CQ_RING);
+  ring.sqes = (struct io_uring_sqe *)mapRing(
+      ring.fd, params.sq_entries * sizeof(struct io_uring_sqe),
+      IORING_OFF_SQES);
+
+  ring.sqHead = (unsigned *)(sq + params.sq_off.head);
+  ring.sqTail = (unsigned *)(sq + params.sq_off.tail);
+  ring.sqMask = (unsigned *)(sq + params.sq_off.ring_mask);
+  ring.sqFlags = (unsigned *)(sq + params.sq_off.flags);
+  ring.sqEntries = params.sq_entries;
+  unsigned *sqArray = (unsigned *)(sq + params.sq_off.array);
+  for (unsigned i = 0; i < params.sq_entries; i++) {
+    sqArray[i] = i; // SQE 인덱스 = 링 위치 (고정)
+  }
+  ring.sqLocalTail = *ring.sqTail;
+  ring.sqSubmitted = ring.sqLocalTail;
+
+  ring.cqHead = (unsigned *)(cq + params.cq_off.head);
+  ring.cqTail = (unsigned *)(cq + params.cq_off.tail);
+  ring.cqMask = (unsigned *)(cq + params.cq_off.ring_mask);
+  ring.cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+
+  // provided buffer ring 등록 + 버퍼 전부 넣어 두기
+  bool hugePages = g_useHugePages;
+  ring.bufRing = (struct io_uring_buf_ring *)mapArena(
+      RECV_BUFFER_COUNT * sizeof(struct io_uring_buf), hugePages);
+  hugePages = g_useHugePages;
+  ring.recvArena =
+      mapArena((size_t)RECV_BUFFER_COUNT * RECV_BUFFER_SIZE, hugePages);
+
+  struct io_uring_buf_reg reg;
+  memset(&reg, 0, sizeof(reg));
+  reg.ring_addr = (uint64_t)(uintptr_t)ring.bufRing;
+  reg.ring_entries = RECV_BUFFER_COUNT;
+  reg.bgid = RECV_BUFFER_GROUP;
+  if (uringRegister(ring.fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+    errorExit("io_uring_register(PBUF_RING) failed");
+  }
+  ring.starved.reserve(g_poolCapacity);
+  ring.bufNext = new int32_t[RECV_BUFFER_COUNT];
+  ring.bufLen = new uint32_t[RECV_BUFFER_COUNT];
+  ring.bufTail = 0;
+  for (int bid = 0; bid < RECV_BUFFER_COUNT; bid++) {
+    uringRecycleBuffer(ring, (uint16_t)bid);
+  }
+
+  ring.enterCalls = 0;
+  ring.sqesSubmitted = 0;
+  ring.noBuffers = 0;
+}
+
+/**
+ * 쌓인 SQE를 커널에 알리고, waitNr > 0이면 CQE가 올 때까지 (최대 1초) 대기
+ */
+void uringSubmitAndWait(Uring &ring, unsigned waitNr) {
+  __atomic_store_n(ring.sqTail, ring.sqLocalTail, __ATOMIC_RELEASE);
+  unsigned toSubmit = ring.sqLocalTail - ring.sqSubmitted;
+  ring.sqSubmitted = ring.sqLocalTail;
+  ring.sqesSubmitted += toSubmit;
+
+  unsigned flags = 0;
+  if (ring.sqpoll) {
+    // 폴링 스레드가 잠들었을 때만 깨움 (평소에는 tail만 올리면 알아서 가져감)
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (toSubmit > 0 &&
+        (__atomic_load_n(ring.sqFlags, __ATOMIC_RELAXED) & IORING_SQ_NEED_WAKEUP)) {
+      flags |= IORING_ENTER_SQ_WAKEUP;
+    }
+    toSubmit = 0;
+  }
+  if (waitNr == 0 && toSubmit == 0 && flags == 0) {
+    return;
+  }
+
+  struct __kernel_timespec timeout;
+  timeout.tv_sec = 1; // 종료 신호 확인용
+  timeout.tv_nsec = 0;
+  struct io_uring_getevents_arg arg;
+  memset(&arg, 0, sizeof(arg));
+  arg.ts = (uint64_t)(uintptr_t)&timeout;
+  void *argPtr = nullptr;
+  size_t argSize = 0;
+  if (waitNr > 0) {
+    flags |= IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+    argPtr = &arg;
+    argSize = sizeof(arg);
+  }
+
+  ring.enterCalls++;
+  if (uringEnter(ring.fd, toSubmit, waitNr, flags, argPtr, argSize) < 0 &&
+      errno != EINTR && errno != ETIME && errno != EBUSY) {
+    perror("io_uring_enter() failed");
+  }
+}
+
+/**
+ * 빈 SQE 하나 (SQ가 가득 차면 먼저 제출)
+ */
+struct io_uring_sqe *uringGetSqe(Uring &ring) {
+  while (ring.sqLocalTail - __atomic_load_n(ring.sqHead, __ATOMIC_ACQUIRE) >=
+         ring.sqEntries) {
+    uringSubmitAndWait(ring, 0);
+    if (ring.sqpoll) {
+      uringEnter(ring.fd, 0, 0, IORING_ENTER_SQ_WAIT, nullptr, 0);
+    }
+  }
+  struct io_uring_sqe *sqe = &ring.sqes[ring.sqLocalTail & *ring.sqMask];
+  memset(sqe, 0, sizeof(*sqe));
+  ring.sqLocalTail++;
+  return sqe;
+}
+
+void uringPrepAccept(Uring &ring, int serverSock) {
+  struct io_uring_sqe *sqe = uringGetSqe(ring);
+  sqe->opcode = IORING_OP_ACCEPT;
+  sqe->fd = serverSock;
+  sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+  sqe->user_data = OP_ACCEPT;
+}
+
+void uringPrepRecv(Uring &ring, Connection *conn) {
+  struct io_uring_sqe *sqe = uringGetSqe(ring);
+  sqe->opcode = IORING_OP_RECV;
+  sqe->fd = conn->fd;
+  sqe->ioprio = IORING_RECV_MULTISHOT;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = RECV_BUFFER_GROUP;
+  sqe->user_data = connectionTag(conn) | OP_RECV;
+  conn->recvArmed = true;
+}
+
+/**
+ * 목록 맨 앞 버퍼의 남은 부분 전송
+ */
+void uringPrepSend(Uring &ring, Connection *conn) {
+  int32_t bid = conn->heldHead;
+  struct io_uring_sqe *sqe = uringGetSqe(ring);
+  sqe->opcode = IORING_OP_SEND;
+  sqe->fd = conn->fd;
+  sqe->addr = (uint64_t)(uintptr_t)(ring.recvArena +
+                                    (size_t)bid * RECV_BUFFER_SIZE +
+                                    conn->sendOffset);
+  sqe->len = ring.bufLen[bid] - conn->sendOffset;
+  sqe->msg_flags = MSG_NOSIGNAL;
+  sqe->user_data = connectionTag(conn) | OP_SEND;
+  conn->sending = true;
+}
+
+void uringPrepCancelRecv(Uring &ring, Connection *conn) {
+  struct io_uring_sqe *sqe = uringGetSqe(ring);
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->fd = -1;
+  sqe->addr = connectionTag(conn) | OP_RECV;
+  sqe->user_data = connectionTag(conn) | OP_CANCEL;
+}
+
+/**
+ * 받은 버퍼를 연결의 보낼 목록 뒤에 붙임
+ */
+void uringHoldBuffer(Uring &ring, Connection *conn, uint16_t bid, int len) {
+  ring.bufNext[bid] = -1;
+  ring.bufLen[bid] = (uint32_t)len;
+  if (conn->heldTail >= 0) {
+    ring.bufNext[conn->heldTail] = bid;
+  } else {
+    conn->heldHead = bid;
+  }
+  conn->heldTail = bid;
+  conn->heldBytes += len;
+}
+
+/**
+ * 다 보낸 맨 앞 버퍼를 링에 반납
+ */
+void uringPopBuffer(Uring &ring, Connection *conn) {
+  int32_t bid = conn->heldHead;
+  conn->heldBytes -= ring.bufLen[bid] - conn->sendOffset;
+  conn->heldHead = ring.bufNext[bid];
+  if (conn->heldHead < 0) {
+    conn->heldTail = -1;
+  }
+  conn->sendOffset = 0;
+  uringRecycleBuffer(ring, (uint16_t)bid);
+}
+
+void uringTryFinishClose(Uring &ring, Connection *conn) {
+  if (conn->closing && !conn->recvArmed && !conn->sending) {
+    while (conn->heldHead >= 0) {
+      uringPopBuffer(ring, conn);
+    }
+    closeConnection(conn, -1);
+  }
+}
+
+/**
+ * 닫기 시작: shutdown으로 걸린 recv/send를 끝내고, 완료가 다 오면 반납
+ */
+void uringClose(Uring &ring, Connection *conn) {
+  if (!conn->closing) {
+    conn->closing = true;
+    shutdown(conn->fd, SHUT_RDWR);
+    if (conn->recvArmed) {
+      uringPrepCancelRecv(ring, conn);
+    }
+  }
+  uringTryFinishClose(ring, conn);
+}
+
+void uringOnAccept(Uring &ring, int serverSock, int res, unsigned flags) {
+  if (res >= 0) {
+    uint64_t allocsBefore = t_allocCount;
+
+    Connection *conn = poolAcquire(*t_pool);
+    if (conn == nullptr) {
+      close(res);
+      t_stats.rejected++;
+      g_metrics.rejected.inc();
+    } else {
+      alog::info("[+] Client connected (fd={})", res);
+      initConnection(conn, res, false);
+      uringPrepRecv(ring, conn);
+      t_stats.accepts++;
+      g_metrics.accepts.inc();
+    }
+    t_stats.hotPathAllocs += t_allocCount - allocsBefore;
+  } else if (res != -ECANCELED) {
+    alog::error("[!] accept failed: {}", alog::Errno(-res));
+  }
+
+  // multishot이 끝났으면 (에러 등) 다시 검
+  if (!(flags & IORING_CQE_F_MORE)) {
+    uringPrepAccept(ring, serverSock);
+  }
+}
+
+void uringOnRecv(Uring &ring, Connection *conn, int res, unsigned flags) {
+  if (!(flags & IORING_CQE_F_MORE)) {
+    conn->recvArmed = false;
+  }
+
+  if (res > 0) {
+    uint16_t bid = (uint16_t)(flags >> IORING_CQE_BUFFER_SHIFT);
+    conn->bytesIn += res;
+    g_metrics.bytesIn.add(res);
+    conn->lastActiveMs = nowMs();
+
+    if (conn->closing) {
+      uringRecycleBuffer(ring, bid);
+    } else {
+      // Echo: 받은 버퍼 그대로 전송 (send 완료 후 링에 반납)
+      uringHoldBuffer(ring, conn, bid, res);
+      if (!conn->sending) {
+        uringPrepSend(ring, conn);
+      }
+      if (conn->heldBytes > HIGH_WATER_MARK && !conn->readPaused) {
+        // 상대가 안 읽음 -> recv를 내려서 TCP 흐름 제어에 맡김
+        // (multishot은 취소가 늦을수록 버퍼를 더 잡으므로 바로 제출)
+        conn->readPaused = true;
+        if (conn->recvArmed) {
+          uringPrepCancelRecv(ring, conn);
+          uringSubmitAndWait(ring, 0);
+        }
+      }
+    }
+  } else if (res == -ENOBUFS) {
+    // 바로 다시 걸면 헛돌기만 함 -> 버퍼가 반납될 때까지 대기 목록에
+    ring.noBuffers++;
+    if (!conn->recvArmed && !conn->recvStarved) {
+      conn->recvStarved = true;
+      ring.starved.push_back(connectionTag(conn));
+    }
+  } else if (res != -ECANCELED) {
+    // 0 = 연결 종료, 그 외 에러
+    uringClose(ring, conn);
+    return;
+  }
+
+  if (!conn->recvArmed && !conn->recvStarved && !conn->readPaused &&
+      !conn->closing) {
+    uringPrepRecv(ring, conn);
+  }
+  uringTryFinishClose(ring, conn);
+}
+
+/**
+ * 버퍼가 반납됐으면 기다리던 연결들의 recv를 다시 검 (먼저 기다린 순서로,
+ * 반납된 버퍼 수만큼만 -> 한꺼번에 깨워서 다시 ENOBUFS 나는 것을 줄임)
+ */
+void uringWakeStarved(Uring &ring) {
+  size_t budget = ring.recycled;
+  size_t i = 0;
+  for (; i < ring.starved.size() && budget > 0; i++) {
+    uint16_t generation;
+    Connection *conn = tagToConnection(ring.starved[i], generation);
+    if (!isLive(conn, generation)) {
+      continue;
+    }
+    conn->recvStarved = false;
+    if (!conn->recvArmed && !conn->readPaused && !conn->closing) {
+      uringPrepRecv(ring, conn);
+      budget--;
+    }
+  }
+  ring.starved.erase(ring.starved.begin(), ring.starved.begin() + i);
+}
+
+void uringOnSend(Uring &ring, Connection *conn, int res) {
+  conn->sending = false;
+  if (res <= 0 || conn->closing) {
+    uringClose(ring, conn);
+    return;
+  }
+
+  conn->sendOffset += res;
+  conn->heldBytes -= res;
+  conn->bytesOut += res;
+  g_metrics.bytesOut.add(res);
+  if (conn->sendOffset == ring.bufLen[conn->heldHead]) {
+    uringPopBuffer(ring, conn);
+  }
+  // 일부만 나갔으면 같은 버퍼 나머지, 아니면 다음 버퍼
+  if (conn->heldHead >= 0) {
+    uringPrepSend(ring, conn);
+  }
+
+  if (conn->readPaused && conn->heldBytes < LOW_WATER_MARK) {
+    conn->readPaused = false;
+    if (!conn->recvArmed && !conn->recvStarved) {
+      uringPrepRecv(ring, conn);
+    }
+  }
+}
+
+/**
+ * 완료된 CQE를 전부 처리 (처리 중에 쌓인 SQE는 다음 enter에서 한 번에 제출)
+ */
+void uringDrainCompletions(Uring &ring, int serverSock) {
+  unsigned head = *ring.cqHead;
+
+  while (head != __atomic_load_n(ring.cqTail, __ATOMIC_ACQUIRE)) {
+    struct io_uring_cqe *cqe = &ring.cqes[head & *ring.cqMask];
+    uint64_t userData = cqe->user_data;
+    int res = cqe->res;
+    unsigned flags = cqe->flags;
+    head++;
+    __atomic_store_n(ring.cqHead, head, __ATOMIC_RELEASE);
+
+    uint64_t op = userData & OP_MASK;
+    if (op == OP_ACCEPT) {
+      uringOnAccept(ring, serverSock, res, flags);
+      continue;
+    }
+    if (op == OP_CANCEL) {
+      continue;
+    }
+
+    uint16_t generation;
+    Connection *conn = tagToConnection(userData & ~OP_MASK, generation);
+    if (!isLive(conn, generation)) {
+      t_stats.staleEvents++;
+      if (flags & IORING_CQE_F_BUFFER) {
+        uringRecycleBuffer(ring, (uint16_t)(flags >> IORING_CQE_BUFFER_SHIFT));
+      }
+      continue;
+    }
+    if (op == OP_RECV) {
+      uringOnRecv(ring, conn, res, flags);
+    } else if (op == OP_SEND) {
+      uringOnSend(ring, conn, res);
+    }
+  }
+}
+
+/**
+ * uring 모드 이벤트 루프: 제출 + 대기(io_uring_enter 1회) -> CQE 처리 반복
+ */
+void uringEventLoop(int serverSock) {
+  ConnectionPool pool;
+  poolInit(pool, g_poolCapacity);
+  t_pool = &pool;
+  BufferPool buffers;
+  bufferPoolInit(buffers, g_bufferMemPerReactor, g_useHugePages);
+  t_buffers = &buffers;
+  memset(&t_stats, 0, sizeof(t_stats));
+
+  Uring ring;
+  uringInit(ring, g_useSqpoll);
+  uringPrepAccept(ring, serverSock);
+
+  std::cout << "[*] Server running... (Mode: io_uring"
+            << (ring.sqpoll ? " + SQPOLL" : "") << ")" << std::endl;
+
+  while (!g_stop) {
+    uringSubmitAndWait(ring, 1);
+    ring.recycled = 0;
+    uringDrainCompletions(ring, serverSock);
+    uringWakeStarved(ring);
+  }
+
+  printReactorStats(pool, buffers);
+  std::cout << "[*] io_uring: enter_calls=" << ring.enterCalls
+            << " sqes=" << ring.sqesSubmitted
+            << " no_buffers=" << ring.noBuffers << std::endl;
+  close(ring.fd);
+}
+
+// ============================================================
+// 멀티 리액터 (--threads N)
+// ============================================================
+
+enum SteerMode { STEER_NONE, STEER_CPU, STEER_BPF, STEER_EXCLUSIVE };
+
+/**
+ * 현재 스레드를 cpu 코어에 고정
+ */
+void pinToCpu(int cpu) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  if (err != 0) {
+    std::cerr << "[!] pthread_setaffinity_np(" << cpu
+              << ") failed: " << strerror(err) << std::endl;
+  }
+}
+
+/**
+ * reuseport 그룹에 CBPF 프로그램 부착: "SYN을 처리한 코어 번호 % N" 번째
+ * 리스너를 고름. 리스너를 리액터 순서대로 bind 했으므로 i번 리스너 = i번 코어.
+ */
+void attachCpuSteering(int serverSock, int numReactors) {
+  struct sock_filter code[] = {
+      // A = 현재 CPU 번호
+      {BPF_LD | BPF_W | BPF_ABS, 0, 0, (uint32_t)(SKF_AD_OFF + SKF_AD_CPU)},
+      // A = A % N
+      {BPF_ALU | BPF_MOD | BPF_K, 0, 0, (uint32_t)numReactors},
+      // return A (리스너 인덱스)
+      {BPF_RET | BPF_A, 0, 0, 0},
+  };
+  struct sock_fprog prog;
+  prog.len = sizeof(code) / sizeof(code[0]);
+  prog.filter = code;
+
+  if (setsockopt(serverSock, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog,
+                 sizeof(prog)) < 0) {
+    errorExit("setsockopt(SO_ATTACH_REUSEPORT_CBPF) failed");
+  }
+}
+
+/**
+ * 리액터 1개 = 스레드 1개 + epoll 1개 + 리스너 1개.
+ * 연결은 accept한 리액터에서만 처리 -> 스레드 간 공유 상태/이동 없음.
+ * @param sharedListener: --steer exclusive (리스너 하나를 모든 리액터가 공유,
+ *        EPOLLEXCLUSIVE로 등록해서 연결 하나에 리액터 하나만 깨어남)
+ */
+void runReactor(int index, int serverSock, int cpu, bool useEdgeTrigger,
+                bool sharedListener, int adminSock) {
+  pinToCpu(cpu);
+
+  if (g_useUring) {
+    std::cout << "[*] Reactor " << index << " on CPU " << cpu
+              << " (listen fd=" << serverSock << ", io_uring)" << std::endl;
+    uringEventLoop(serverSock);
+    if (!sharedListener) {
+      close(serverSock);
+    }
+    return;
+  }
+
+  int epollFd = createEpoll();
+
+  uint32_t serverEvents = EPOLLIN;
+  if (useEdgeTrigger) {
+    serverEvents |= EPOLLET;
+  }
+  if (sharedListener) {
+    serverEvents |= EPOLLEXCLUSIVE;
+  }
+  epollAdd(epollFd, serverSock, serverEvents, LISTENER_TAG);
+
+  std::cout << "[*] Reactor " << index << " on CPU " << cpu
+            << " (listen fd=" << serverSock << ", epoll fd=" << epollFd << ")"
+            << std::endl;
+
+  eventLoop(serverSock, epollFd, useEdgeTrigger, adminSock);
+
+  close(epollFd);
+  if (!sharedListener) {
+    close(serverSock);
+  }
+}
+
+int runMultiReactor(int port, int numReactors, SteerMode steer,
+                    bool useEdgeTrigger, int adminSock) {
+  int numCpus = (int)std::thread::hardware_concurrency();
+  if (numCpus <= 0) {
+    numCpus = 1;
+  }
+
+  // exclusive: 리스너(= accept 큐) 하나를 공유. 연결이 오면 커널이 기다리는
+  // 리액터 중 하나만 깨움 (EPOLLEXCLUSIVE 없이는 전부 깨어나서 한 명만 성공)
+  bool sharedListener = steer == STEER_EXCLUSIVE;
+  std::vector<int> listeners;
+  if (sharedListener) {
+    int serverSock = createServerSocket(port, false);
+    if (!g_useUring) {
+      setNonBlocking(serverSock);
+    }
+    listeners.assign(numReactors, serverSock);
+  }
+
+  // 리스너를 먼저 전부 bind 해 둬야 reuseport 그룹 순서가 리액터 순서와 같음
+  for (int i = 0; !sharedListener && i < numReactors; i++) {
+    int serverSock = createServerSocket(port, true);
+    if (!g_useUring) {
+      setNonBlocking(serverSock); // accept4가 EAGAIN에서 멈추도록 (LT도)
+    }
+    if (steer == STEER_CPU) {
+      int cpu = i % numCpus;
+      setsockopt(serverSock, SOL_SOCKET, SO_INCOMING_CPU, &cpu, sizeof(cpu));
+    }
+    listeners.push_back(serverSock);
+  }
+  if (steer == STEER_BPF) {
+    attachCpuSteering(listeners[0], numReactors);
+  }
+
+  std::vector<std::thread> reactors;
+  for (int i = 0; i < numReactors; i++) {
+    // 관리 포트는 0번 리액터가 같이 처리 (지표는 모든 리액터 샤드의 합)
+    reactors.emplace_back(runReactor, i, listeners[i], i % numCpus,
+                          useEdgeTrigger, sharedListener,
+                          i == 0 ? adminSock : -1);
+  }
+  for (size_t i = 0; i < reactors.size(); i++) {
+    reactors[i].join();
+  }
+  if (sharedListener) {
+    close(listeners[0]);
+  }
+  return 0;
+}
+
+// ============================================================
+// Main
+// ============================================================
+
+/**
+ * [Task 16] --offload 일 때만 만드는 워커 풀. 함수 안 static이라 리액터가 전부
+ * 끝난 뒤 프로그램 종료 때 정리됨 (남은 작업은 리액터가 종료 전에 다 받아 감)
+ */
+void startOffloadPool() {
+  static wsp::ThreadPool pool(g_offloadThreads);
+  g_offloadPool = &pool;
+}
+
+/**
+ * 남은 로그를 모두 쓰고 로거 통계 출력 (링이 넘쳐서 버린 수)
+ */
+void stopLogger() {
+  alog::stop();
+  alog::Stats st = alog::stats();
+  std::cout << "[*] Log: written=" << st.written << " dropped=" << st.dropped
+            << " threads=" << st.threads << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  int port = DEFAULT_PORT;
+  bool useEdgeTrigger = false; // true로 바꾸면 ET 모드
+  int numReactors = 0;         // 0: 기존 단일 스레드 모드
+  int maxConnections = DEFAULT_MAX_CONNECTIONS;
+  int bufferMemMb = DEFAULT_BUFFER_MEM_MB;
+  SteerMode steer = STEER_NONE;
+
+  if (argc >= 2) {
+    port = atoi(argv[1]);
+  }
+  for (int i = 2; i < argc; i++) {
+    if (strcmp(argv[i], "et") == 0) {
+      useEdgeTrigger = true;
+    } else if (strcmp(argv[i], "uring") == 0) {
+      g_useUring = true;
+    } else if (strcmp(argv[i], "--sqpoll") == 0) {
+      g_useSqpoll = true;
+    } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      numReactors = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--max-conns") == 0 && i + 1 < argc) {
+      maxConnections = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--buffer-mem") == 0 && i + 1 < argc) {
+      bufferMemMb = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--hugepages") == 0) {
+      g_useHugePages = true;
+    } else if (strcmp(argv[i], "--backlog") == 0 && i + 1 < argc) {
+      g_listenBacklog = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--metrics-port") == 0 && i + 1 < argc) {
+      g_metricsPort = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--offload") == 0 && i + 1 < argc) {
+      g_offloadRounds = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--offload-threads") == 0 && i + 1 < argc) {
+      g_offloadThreads = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--tick") == 0 && i + 1 < argc) {
+      g_tickHz = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--tick-work") == 0 && i + 1 < argc) {
+      g_tickWorkRounds = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--tick-fixed") == 0) {
+      g_tickAdaptive = false;
+    } else if (strcmp(argv[i], "--splice") == 0) {
+      g_useSplice = true;
+    } else if (strcmp(argv[i], "--splice-after") == 0 && i + 1 < argc) {
+      g_spliceAfter = strtoull(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--steer") == 0 && i + 1 < argc) {
+      const char *mode = argv[++i];
+      if (strcmp(mode, "cpu") == 0) {
+        steer = STEER_CPU;
+      } else if (strcmp(mode, "bpf") == 0) {
+        steer = STEER_BPF;
+      } else if (strcmp(mode, "exclusive") == 0) {
+        steer = STEER_EXCLUSIVE;
+      }
+    }
+  }
+
+  std::cout << "========================================" << std::endl;
+  std::cout << "  Quest 4: Epoll Echo Server (Linux)" << std::endl;
+  std::cout << "========================================" << std::endl;
+  std::cout << "[*] Starting server on port " << port << std::endl;
+
+  raiseFdLimit();
+  alog::start();
+  registerMetrics();
+
+  int adminSock = -1;
+  if (g_metricsPort > 0) {
+    if (g_useUring) {
+      std::cout << "[!] --metrics-port is epoll only (ignored in uring mode)"
+                << std::endl;
+    } else {
+      adminSock = metrics::createAdminListener(g_metricsPort);
+      if (adminSock < 0) {
+        errorExit("metrics admin port bind failed");
+      }
+      std::cout << "[*] Metrics on http://127.0.0.1:" << g_metricsPort
+                << "/metrics" << std::endl;
+    }
+  }
+
+  // 종료 신호: SA_RESTART 없이 등록해서 epoll_wait이 EINTR로 깨어나게 함
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = onStopSignal;
+  sigaction(SIGINT, &sa, nullptr);
+  sigaction(SIGTERM, &sa, nullptr);
+
+  // [Task 17] 틱 모드는 받은 데이터를 틱까지 들고 있어야 하므로 바로 넘기는
+  // 경로(splice, 워커 풀)와 같이 못 씀
+  if (g_tickHz > 0) {
+    if (g_useUring) {
+      std::cout << "[!] --tick is epoll only (ignored in uring mode)"
+                << std::endl;
+      g_tickHz = 0;
+    } else {
+      if (g_useSplice || g_offloadRounds > 0) {
+        std::cout << "[!] --tick disables --splice and --offload" << std::endl;
+        g_useSplice = false;
+        g_offloadRounds = 0;
+      }
+      std::cout << "[*] Tick: " << g_tickHz << " Hz, work x" << g_tickWorkRounds
+                << (g_tickAdaptive ? ", adaptive input budget" : ", fixed")
+                << std::endl;
+    }
+  }
+
+  if (g_useSplice) {
+    // send()는 MSG_NOSIGNAL로 막지만 splice()는 플래그가 없으므로 끊긴 상대에게
+    // 보낼 때 SIGPIPE로 죽지 않도록 무시 (EPIPE로 받아서 연결만 닫음)
+    signal(SIGPIPE, SIG_IGN);
+    if (g_useUring) {
+      std::cout << "[!] --splice is epoll only (ignored in uring mode)"
+                << std::endl;
+    }
+  }
+
+  if (g_offloadRounds > 0) {
+    if (g_useUring) {
+      std::cout << "[!] --offload is epoll only (ignored in uring mode)"
+                << std::endl;
+    } else {
+      startOffloadPool();
+      std::cout << "[*] Offload: " << g_offloadPool->size()
+                << " workers, validate x" << g_offloadRounds << std::endl;
+    }
+  }
+
+  // 풀은 리액터마다 따로: 전체 한도를 나누고 25% 여유 (reuseport 분배 편차)
+  int reactors = numReactors > 0 ? numReactors : 1;
+  g_poolCapacity = (uint32_t)((long long)maxConnections * 5 / 4 / reactors + 1);
+  g_bufferMemPerReactor = (size_t)bufferMemMb * 1024 * 1024 / reactors;
+
+  if (numReactors > 0) {
+    std::cout << "[*] Multi-reactor mode: " << numReactors << " threads"
+              << std::endl;
+    int result =
+        runMultiReactor(port, numReactors, steer, useEdgeTrigger, adminSock);
+    if (adminSock >= 0) {
+      close(adminSock);
+    }
+    stopLogger();
+    return result;
+  }
+
+  // 1. 서버 소켓 생성
+  int serverSock = createServerSocket(port, false);
+  std::cout << "[*] Server socket created (fd=" << serverSock << ")"
+            << std::endl;
+
+  if (g_useUring) {
+    uringEventLoop(serverSock);
+    close(serverSock);
+    stopLogger();
+    return 0;
+  }
+
+  // 2. Epoll 인스턴스 생성
+  int epollFd = createEpoll();
+  if (epollFd < 0) {
+    std::cerr << "[!] TODO: createEpoll() 구현 필요!" << std::endl;
+    close(serverSock);
+    return 1;
+  }
+  std::cout << "[*] Epoll instance created (fd=" << epollFd << ")" << std::endl;
+
+  // 3. 서버 소켓을 Epoll에 등록 (LT도 Non-blocking: accept 배치가 EAGAIN에서 멈춤)
+  uint32_t serverEvents = EPOLLIN;
+  if (useEdgeTrigger) {
+    serverEvents |= EPOLLET;
+  }
+  setNonBlocking(serverSock);
+  epollAdd(epollFd, serverSock, serverEvents, LISTENER_TAG);
+
+  // 4. 이벤트 루프 시작
+  eventLoop(serverSock, epollFd, useEdgeTrigger, adminSock);
+
+  // 정리
+  close(epollFd);
   close(serverSock);
+  if (adminSock >= 0) {
+    close(adminSock);
+  }
+  stopLogger();
 
   return 0;
 }
@@ -0,0 +1,52 @@
+#!/usr/bin/env bash
+# ⚔️ Quest 4: Idle Connection Memory Test
+#
+# 1) 파이프라인 에코 부하로 버퍼 풀을 한 번 크게 써 보고 (버퍼 빌림/반납)
+# 2) 잠수 연결(zombie)을 N개 붙여 둔 상태에서 서버 RSS를 재서
+#    "잠수 연결 1개당 RSS"를 출력한다.
+#
+# 사용법: ./idle_rss_test.sh [idle_conns] [hold_sec]
+# 예시:   ./idle_rss_test.sh 100000 20
+#
+# 준비:
+#   g++ -o epoll_server epoll_echo_server.cpp -std=c++11 -O2 -pthread
+#   g++ -o load_generator load_generator.cpp -std=c++11 -O2
+#   ulimit -n 250000   (서버와 부하 생성기 모두 연결 수보다 커야 함)
+
+CONNS=${1:-100000}
+HOLD=${2:-20}
+PORT=${PORT:-9100}
+MODE=${MODE:-et}
+SRC=${SRC:-127.0.0.1,127.0.0.2,127.0.0.3,127.0.0.4,127.0.0.5}
+
+rss_kb() {
+  awk '/VmRSS/ { print $2 }' "/proc/$1/status"
+}
+
+log=$(mktemp)
+./epoll_server "$PORT" "$MODE" --max-conns "$CONNS" $SERVER_ARGS > "$log" 2>&1 &
+server_pid=$!
+sleep 0.5
+
+# 1) 버퍼 풀 데우기: 응답을 기다리지 않고 연속 송신 -> outBuf가 생김
+./load_generator --port "$PORT" --conns 200 --rate 2000 --pipeline 32 \
+  --msg-size 65536 --duration 3 | grep "Echo verify"
+sleep 1
+
+# 2) 잠수 연결 유지 (모두 붙은 뒤 hold 끝나기 전에 측정)
+base_kb=$(rss_kb "$server_pid")
+./load_generator --port "$PORT" --scenario zombie --conns "$CONNS" \
+  --rate 20000 --duration "$HOLD" --src "$SRC" > /dev/null &
+loadgen_pid=$!
+sleep $((HOLD - 2))
+idle_kb=$(rss_kb "$server_pid")
+wait "$loadgen_pid"
+
+kill -INT "$server_pid"
+wait "$server_pid"
+grep -E "Reactor stats|Buffer pool" "$log"
+rm -f "$log"
+
+echo "RSS before: ${base_kb} KB, with ${CONNS} idle: ${idle_kb} KB"
+awk -v b="$base_kb" -v i="$idle_kb" -v n="$CONNS" \
+  'BEGIN { printf "RSS per idle connection: %.0f bytes\n", (i - b) * 1024 / n }'
@@ -0,0 +1,884 @@
+/**
+ * ⚔️ Quest 4: Epoll Load Generator (Linux)
+ *
+ * stress_test.rb(클라이언트 1명 = Ruby 스레드 1개)를 대체하는 부하 생성기.
+ * 서버와 같은 epoll + Non-blocking 소켓으로, 프로세스 하나에서 10만 개 이상의
+ * 연결을 열고 시나리오를 돌린다.
+ *
+ * 시나리오:
+ *   echo   : 메시지 송신 -> 같은 크기만큼 에코 수신 (epoll_echo_server 용)
+ *            --pipeline K 로 연결마다 K개를 응답 없이 연속 송신하고,
+ *            돌아온 바이트를 송신 패턴과 한 바이트씩 비교 (byte-exact 검증)
+ *   chat   : 환영 메시지 -> /join -> 주기적으로 채팅 (q2 채팅 서버 용)
+ *            채팅에 송신 시각을 실어서 송신자 -> 수신자 지연도 측정
+ *            (같은 호스트의 CLOCK_MONOTONIC 기준이라 부하 생성기 1대일 때만 유효)
+ *   zombie : 접속 후 아무 말도 안 함 -> 서버가 끊을 때까지의 시간 측정
+ *   storm  : 접속 -> 에코 1회 -> RST로 끊고 바로 재접속 반복 (재시작 후
+ *            재접속 폭주 재현), --conns개가 동시에 돌면서 초당 연결 수(CPS) 측정.
+ *            RST(SO_LINGER 0)로 끊어서 출발지 포트가 TIME_WAIT에 묶이지 않음
+ *
+ * 리포트: 연결 성공/실패, RPS, 연결 지연 / 응답 지연 백분위수(p50~p99.9)
+ *
+ * 컴파일: g++ -o load_generator load_generator.cpp -std=c++11 -O2
+ * 실행: ./load_generator --port 9000 --scenario echo --conns 10000 --rate 2000
+ *       ./load_generator --port 9000 --scenario storm --conns 2000 --duration 5
+ *
+ * 10만 연결 팁:
+ * - ulimit -n 을 충분히 올릴 것 (시작 시 soft limit을 hard limit까지 올림)
+ * - 출발지 포트(약 28k~60k개)가 모자라면 --src 127.0.0.1,127.0.0.2,... 로
+ *   출발지 IP를 여러 개 지정 (IP마다 포트 공간이 따로 생김)
+ * - q2 채팅 서버는 select 기반이라 FD_SETSIZE(1024) 이상은 받지 못함
+ */
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <queue>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#ifndef IP_BIND_ADDRESS_NO_PORT
+#define IP_BIND_ADDRESS_NO_PORT 24
+#endif
+
+#define MAX_EVENTS 1024
+#define BUFFER_SIZE 4096
+
+// ============================================================
+// 설정
+// ============================================================
+
+enum Scenario { SCENARIO_ECHO, SCENARIO_CHAT, SCENARIO_ZOMBIE, SCENARIO_STORM };
+
+struct Options {
+  std::string host;
+  int port;
+  Scenario scenario;
+  int conns;          // 총 연결 수
+  double rate;        // 초당 새 연결 수 (0 = 제한 없음)
+  double rampSecs;    // 0 -> rate 까지 선형 증가에 걸리는 시간
+  double durationSecs; // 마지막 연결 시작 후 측정 시간
+  int msgSize;        // echo 메시지 크기 (bytes, '\n' 포함)
+  int pipeline;       // echo: 연결마다 동시에 보내 둘 메시지 수
+  int talkIntervalMs; // chat 채팅 주기
+  int room;           // chat 방 번호
+  std::vector<std::string> sourceIps; // 출발지 IP 목록 (비어 있으면 OS 선택)
+};
+
+// ============================================================
+// 지연 히스토그램 (log-linear 버킷, us 단위)
+// ============================================================
+
+/**
+ * 2의 거듭제곱 구간마다 16칸으로 나눈 버킷 -> 상대 오차 약 6% 이내.
+ * 샘플을 저장하지 않으므로 수백만 개를 넣어도 메모리가 일정함.
+ */
+struct Histogram {
+  static const int SUB_BUCKETS = 16;
+  static const int MAGNITUDES = 40;
+  uint64_t buckets[MAGNITUDES * SUB_BUCKETS];
+  uint64_t count;
+  uint64_t sum;
+  uint64_t max;
+
+  Histogram() : count(0), sum(0), max(0) {
+    memset(buckets, 0, sizeof(buckets));
+  }
+
+  static int indexOf(uint64_t value) {
+    if (value < SUB_BUCKETS) {
+      return (int)value;
+    }
+    int magnitude = 63 - __builtin_clzll(value); // value >= 16 -> 4 이상
+    int shift = magnitude - 4;
+    int sub = (int)((value >> shift) & (SUB_BUCKETS - 1));
+    return (magnitude - 3) * SUB_BUCKETS + sub;
+  }
+
+  static uint64_t valueOf(int index) {
+    if (index < SUB_BUCKETS) {
+      return index;
+    }
+    int magnitude = index / SUB_BUCKETS + 3;
+    int sub = index % SUB_BUCKETS;
+    int shift = magnitude - 4;
+    return ((uint64_t)(SUB_BUCKETS + sub) << shift) + ((1ULL << shift) - 1);
+  }
+
+  void record(uint64_t value) {
+    int index = indexOf(value);
+    if (index >= MAGNITUDES * SUB_BUCKETS) {
+      index = MAGNITUDES * SUB_BUCKETS - 1;
+    }
+    buckets[index]++;
+    count++;
+    sum += value;
+    if (value > max) {
+      max = value;
+    }
+  }
+
+  uint64_t percentile(double p) const {
+    if (count == 0) {
+      return 0;
+    }
+    uint64_t target = (uint64_t)(count * p / 100.0);
+    if (target >= count) {
+      target = count - 1;
+    }
+    uint64_t seen = 0;
+    for (int k = 0; k < MAGNITUDES * SUB_BUCKETS; ++k) {
+      seen += buckets[k];
+      if (seen > target) {
+        uint64_t v = valueOf(k);
+        return v < max ? v : max;
+      }
+    }
+    return max;
+  }
+
+  void print(const char *name) const {
+    std::cout << "[*] " << name << " (us): n=" << count;
+    if (count > 0) {
+      std::cout << " avg=" << sum / count << " p50=" << percentile(50)
+                << " p90=" << percentile(90) << " p99=" << percentile(99)
+                << " p99.9=" << percentile(99.9) << " max=" << max;
+    }
+    std::cout << std::endl;
+  }
+};
+
+// ============================================================
+// 연결 상태
+// ============================================================
+
+enum ConnState {
+  STATE_CONNECTING,
+  STATE_WAIT_WELCOME, // chat/zombie: 환영 메시지 대기
+  STATE_WAIT_JOIN,    // chat: /join 응답 대기
+  STATE_RUNNING,      // echo 왕복 / chat 대화 / zombie 잠수
+  STATE_CLOSED
+};
+
+struct Conn {
+  int fd;
+  ConnState state;
+  int64_t connectStart; // connect() 호출 시각
+  int64_t requestStart; // 마지막 요청 송신 시각 (응답 지연 측정)
+  uint64_t echoSent;     // echo: 보낸 총 바이트 (= 다음 패턴 위치)
+  uint64_t echoReceived; // echo: 돌려받은 총 바이트
+  // echo: 응답을 기다리는 메시지들의 송신 시각 (크기 = pipeline인 링)
+  std::vector<int64_t> inflight;
+  size_t inflightHead;
+  size_t inflightCount;
+  std::string out;      // 다 못 보낸 데이터
+  size_t outOffset;
+  std::string inLine;   // chat: 아직 '\n'이 안 온 줄 조각
+  int64_t joinedAt;     // chat: /join 보낸 시각 (이전에 보낸 줄은 히스토리 재생)
+};
+
+struct Stats {
+  uint64_t connected;
+  uint64_t connectFailed;
+  uint64_t closedByServer;
+  uint64_t requests;  // 보낸 요청(echo 메시지 / 채팅) 수
+  uint64_t responses; // 완료된 응답 수 (echo 왕복 / chat 수신 줄 수)
+  uint64_t bytesIn;
+  uint64_t bytesOut;
+  Histogram connectLatency;
+  Histogram responseLatency;
+  Histogram zombieKick; // zombie: 접속 ~ 서버가 끊기까지
+  Histogram wireLatency; // chat: 송신자 send() ~ 수신자 recv()
+  uint64_t bytesVerified; // echo: 패턴과 비교한 바이트
+  uint64_t bytesMismatch; // echo: 패턴과 다른 바이트 (0이어야 정상)
+  uint64_t cycles;        // storm: 접속 -> 에코 -> 끊기를 마친 횟수
+};
+
+Options opts;
+Stats stats;
+std::vector<Conn> conns;
+std::string echoMessage; // echo 송신용 임시 버퍼 (메시지 1개 크기)
+int epollFd = -1;
+
+// 채팅 스케줄 (min-heap: <다음 채팅 시각, 연결 번호>)
+typedef std::pair<int64_t, int> Timer;
+std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer> > talkTimers;
+
+// ============================================================
+// 유틸리티
+// ============================================================
+
+int64_t nowUs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+void errorExit(const char *msg) {
+  perror(msg);
+  exit(1);
+}
+
+void raiseFdLimit() {
+  struct rlimit rl;
+  if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur < rl.rlim_max) {
+    rl.rlim_cur = rl.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &rl);
+  }
+  getrlimit(RLIMIT_NOFILE, &rl);
+  std::cout << "[*] fd limit: " << rl.rlim_cur << std::endl;
+}
+
+/**
+ * --host 해석: 숫자 IP면 그대로, 아니면 DNS 조회 (docker compose의 서비스
+ * 이름 등). 연결마다 조회하지 않도록 시작할 때 한 번만 (IPv4 첫 주소)
+ */
+bool resolveHost(const std::string &host, struct in_addr *out) {
+  if (inet_pton(AF_INET, host.c_str(), out) == 1) {
+    return true;
+  }
+  struct addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  struct addrinfo *result = nullptr;
+  int rc = getaddrinfo(host.c_str(), nullptr, &hints, &result);
+  if (rc != 0) {
+    std::cerr << "[!] Cannot resolve " << host << ": " << gai_strerror(rc)
+              << std::endl;
+    return false;
+  }
+  *out = ((struct sockaddr_in *)result->ai_addr)->sin_addr;
+  freeaddrinfo(result);
+  return true;
+}
+
+void epollSet(int op, int id, uint32_t events) {
+  struct epoll_event ev;
+  ev.events = events;
+  ev.data.u64 = (uint64_t)id;
+  epoll_ctl(epollFd, op, conns[id].fd, &ev);
+}
+
+void closeConn(int id) {
+  Conn &c = conns[id];
+  if (c.state == STATE_CLOSED) {
+    return;
+  }
+  epoll_ctl(epollFd, EPOLL_CTL_DEL, c.fd, nullptr);
+  close(c.fd);
+  c.fd = -1;
+  c.state = STATE_CLOSED;
+  std::string().swap(c.out);
+  std::string().swap(c.inLine);
+  std::vector<int64_t>().swap(c.inflight);
+}
+
+void startConnect(int id);
+
+// storm: RST로 끊고 같은 자리에서 바로 다시 접속
+void reconnect(int id) {
+  struct linger lg;
+  lg.l_onoff = 1;
+  lg.l_linger = 0;
+  setsockopt(conns[id].fd, SOL_SOCKET, SO_LINGER, &lg, sizeof(lg));
+  closeConn(id);
+  startConnect(id);
+}
+
+// 보낼 데이터를 큐에 넣고 가능한 만큼 바로 전송
+void sendData(int id, const char *data, size_t len) {
+  Conn &c = conns[id];
+  bool wasEmpty = c.out.size() == c.outOffset;
+  c.out.append(data, len);
+  if (!wasEmpty) {
+    return; // EPOLLOUT이 이미 걸려 있음
+  }
+
+  while (c.outOffset < c.out.size()) {
+    ssize_t n = send(c.fd, c.out.data() + c.outOffset,
+                     c.out.size() - c.outOffset, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        epollSet(EPOLL_CTL_MOD, id, EPOLLIN | EPOLLOUT);
+        return;
+      }
+      closeConn(id);
+      return;
+    }
+    c.outOffset += n;
+    stats.bytesOut += n;
+  }
+  c.out.clear();
+  c.outOffset = 0;
+}
+
+void flushOut(int id) {
+  Conn &c = conns[id];
+  while (c.outOffset < c.out.size()) {
+    ssize_t n = send(c.fd, c.out.data() + c.outOffset,
+                     c.out.size() - c.outOffset, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return;
+      }
+      closeConn(id);
+      return;
+    }
+    c.outOffset += n;
+    stats.bytesOut += n;
+  }
+  c.out.clear();
+  c.outOffset = 0;
+  epollSet(EPOLL_CTL_MOD, id, EPOLLIN);
+}
+
+// ============================================================
+// 시나리오 동작
+// ============================================================
+
+// echo 스트림의 pos번째 바이트 (연결마다 다른 패턴, 메시지 끝은 '\n')
+char echoPatternByte(int id, uint64_t pos) {
+  if (pos % opts.msgSize == (uint64_t)opts.msgSize - 1) {
+    return '\n';
+  }
+  return (char)('A' + (pos * 7 + (uint64_t)id * 13 + pos / opts.msgSize) % 26);
+}
+
+void sendEcho(int id) {
+  Conn &c = conns[id];
+  for (int k = 0; k < opts.msgSize; ++k) {
+    echoMessage[k] = echoPatternByte(id, c.echoSent + k);
+  }
+  c.echoSent += opts.msgSize;
+  if (c.inflight.empty()) {
+    c.inflight.resize(opts.pipeline);
+  }
+  c.inflight[(c.inflightHead + c.inflightCount) % c.inflight.size()] = nowUs();
+  c.inflightCount++;
+  stats.requests++;
+  sendData(id, echoMessage.data(), echoMessage.size());
+}
+
+// echo 수신: 패턴과 비교하고, 메시지 경계를 넘을 때마다 지연 기록 + 새 메시지 송신
+void onEchoData(int id, const char *data, size_t len) {
+  Conn &c = conns[id];
+  for (size_t k = 0; k < len; ++k) {
+    if (data[k] != echoPatternByte(id, c.echoReceived + k)) {
+      stats.bytesMismatch++;
+    }
+  }
+  stats.bytesVerified += len;
+
+  uint64_t before = c.echoReceived / opts.msgSize;
+  c.echoReceived += len;
+  uint64_t after = c.echoReceived / opts.msgSize;
+
+  int64_t now = nowUs();
+  for (uint64_t m = before; m < after && c.inflightCount > 0; ++m) {
+    stats.responseLatency.record(now - c.inflight[c.inflightHead]);
+    stats.responses++;
+    c.inflightHead = (c.inflightHead + 1) % c.inflight.size();
+    c.inflightCount--;
+    if (opts.scenario == SCENARIO_STORM) {
+      stats.cycles++;
+      reconnect(id);
+      return;
+    }
+    sendEcho(id);
+    if (c.state == STATE_CLOSED) {
+      return;
+    }
+  }
+}
+
+// "talk <보낸 연결> <송신 시각 us>\n"
+void sendTalk(int id) {
+  conns[id].requestStart = nowUs();
+  stats.requests++;
+  std::string line = "talk " + std::to_string(id) + " " +
+                     std::to_string(conns[id].requestStart) + "\n";
+  sendData(id, line.data(), line.size());
+}
+
+void sendJoin(int id) {
+  conns[id].requestStart = nowUs();
+  conns[id].joinedAt = conns[id].requestStart;
+  conns[id].state = STATE_WAIT_JOIN;
+  std::string line = "/join " + std::to_string(opts.room) + "\n";
+  sendData(id, line.data(), line.size());
+}
+
+// 연결 완료 직후 (connect 성공)
+void onConnected(int id) {
+  Conn &c = conns[id];
+  stats.connected++;
+  stats.connectLatency.record(nowUs() - c.connectStart);
+  epollSet(EPOLL_CTL_MOD, id, EPOLLIN);
+
+  if (opts.scenario == SCENARIO_ECHO || opts.scenario == SCENARIO_STORM) {
+    c.state = STATE_RUNNING;
+    for (int k = 0; k < opts.pipeline && c.state != STATE_CLOSED; ++k) {
+      sendEcho(id);
+    }
+  } else {
+    c.state = STATE_WAIT_WELCOME;
+  }
+}
+
+// chat: 다른 멤버의 "talk <id> <sendUs>" 줄에서 송신 시각을 꺼내 지연 기록.
+// 입장 전에 보낸 줄은 /join 때 재생된 히스토리라서 지연에 넣지 않음
+void onChatLine(const Conn &c, const std::string &line, int64_t now) {
+  if (line.compare(0, 5, "talk ") != 0) {
+    return;
+  }
+  size_t space = line.find(' ', 5);
+  if (space == std::string::npos) {
+    return;
+  }
+  int64_t sentAt = strtoll(line.c_str() + space + 1, nullptr, 10);
+  if (sentAt >= c.joinedAt && sentAt <= now) {
+    stats.wireLatency.record(now - sentAt);
+  }
+}
+
+// 수신 데이터 처리
+void onData(int id, const char *data, size_t len) {
+  Conn &c = conns[id];
+  stats.bytesIn += len;
+
+  switch (c.state) {
+  case STATE_WAIT_WELCOME:
+    if (opts.scenario == SCENARIO_CHAT) {
+      sendJoin(id);
+    } else {
+      c.state = STATE_RUNNING; // zombie: 환영 메시지만 읽고 잠수
+    }
+    break;
+
+  case STATE_WAIT_JOIN:
+    if (memmem(data, len, "Moved", 5) != nullptr) {
+      stats.responseLatency.record(nowUs() - c.requestStart);
+      stats.responses++;
+      c.state = STATE_RUNNING;
+      talkTimers.push(Timer(nowUs() + opts.talkIntervalMs * 1000LL, id));
+    }
+    break;
+
+  case STATE_RUNNING:
+    if (opts.scenario == SCENARIO_ECHO || opts.scenario == SCENARIO_STORM) {
+      onEchoData(id, data, len);
+    } else if (opts.scenario == SCENARIO_CHAT) {
+      // 다른 멤버가 보낸 채팅 (줄 단위로 셈)
+      int64_t now = nowUs();
+      for (size_t k = 0; k < len; ++k) {
+        if (data[k] != '\n') {
+          c.inLine += data[k];
+          continue;
+        }
+        stats.responses++;
+        onChatLine(c, c.inLine, now);
+        c.inLine.clear();
+      }
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+// 한 이벤트에서 읽는 최대 횟수: 에코가 계속 돌아오는 연결 하나가 루프를 독점해서
+// 다른 연결과 종료 시간 검사가 굶지 않도록 (epoll은 LT라 남은 데이터는 다시 알림)
+#define MAX_READS_PER_EVENT 16
+
+void onReadable(int id) {
+  char buffer[BUFFER_SIZE];
+  // storm은 처리 중에 같은 자리로 재접속하므로 STATE_CONNECTING이면 멈춤
+  for (int reads = 0; reads < MAX_READS_PER_EVENT &&
+                      conns[id].state != STATE_CLOSED &&
+                      conns[id].state != STATE_CONNECTING;
+       ++reads) {
+    ssize_t n = recv(conns[id].fd, buffer, sizeof(buffer), 0);
+    if (n > 0) {
+      onData(id, buffer, n);
+      continue;
+    }
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      return;
+    }
+    // 서버가 연결을 끊음 (EOF 또는 RST)
+    stats.closedByServer++;
+    if (opts.scenario == SCENARIO_ZOMBIE) {
+      stats.zombieKick.record(nowUs() - conns[id].connectStart);
+    }
+    if (opts.scenario == SCENARIO_STORM) {
+      reconnect(id); // 서버가 거절해도 계속 두드림
+      return;
+    }
+    closeConn(id);
+    return;
+  }
+}
+
+void onEvent(int id, uint32_t events) {
+  Conn &c = conns[id];
+  if (c.state == STATE_CLOSED) {
+    return;
+  }
+
+  if (c.state == STATE_CONNECTING) {
+    int err = 0;
+    socklen_t len = sizeof(err);
+    getsockopt(c.fd, SOL_SOCKET, SO_ERROR, &err, &len);
+    if (err != 0 || (events & (EPOLLERR | EPOLLHUP))) {
+      stats.connectFailed++;
+      if (opts.scenario == SCENARIO_STORM) {
+        reconnect(id);
+        return;
+      }
+      closeConn(id);
+      return;
+    }
+    onConnected(id);
+    return;
+  }
+
+  if (events & EPOLLOUT) {
+    flushOut(id);
+  }
+  if (events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+    onReadable(id);
+  }
+}
+
+// ============================================================
+// 연결 생성
+// ============================================================
+
+struct sockaddr_in serverAddr;
+
+void startConnect(int id) {
+  Conn &c = conns[id];
+  c.fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  c.state = STATE_CONNECTING;
+  c.connectStart = nowUs();
+  c.joinedAt = 0;
+  c.outOffset = 0;
+  c.echoSent = 0;
+  c.echoReceived = 0;
+  c.inflightHead = 0;
+  c.inflightCount = 0;
+  if (c.fd < 0) {
+    stats.connectFailed++;
+    c.state = STATE_CLOSED;
+    return;
+  }
+
+  // 출발지 IP 지정: 포트는 connect() 시점에 고르게 해서 IP마다 포트 공간 확보
+  if (!opts.sourceIps.empty()) {
+    int one = 1;
+    setsockopt(c.fd, IPPROTO_IP, IP_BIND_ADDRESS_NO_PORT, &one, sizeof(one));
+
+    struct sockaddr_in src;
+    memset(&src, 0, sizeof(src));
+    src.sin_family = AF_INET;
+    src.sin_port = 0;
+    inet_pton(AF_INET, opts.sourceIps[id % opts.sourceIps.size()].c_str(),
+              &src.sin_addr);
+    if (bind(c.fd, (struct sockaddr *)&src, sizeof(src)) < 0) {
+      stats.connectFailed++;
+      close(c.fd);
+      c.fd = -1;
+      c.state = STATE_CLOSED;
+      return;
+    }
+  }
+
+  int ret = connect(c.fd, (struct sockaddr *)&serverAddr, sizeof(serverAddr));
+  if (ret < 0 && errno != EINPROGRESS) {
+    stats.connectFailed++;
+    close(c.fd);
+    c.fd = -1;
+    c.state = STATE_CLOSED;
+    return;
+  }
+
+  struct epoll_event ev;
+  ev.events = EPOLLOUT;
+  ev.data.u64 = (uint64_t)id;
+  epoll_ctl(epollFd, EPOLL_CTL_ADD, c.fd, &ev);
+}
+
+// 램프업: rate가 0에서 opts.rate까지 rampSecs 동안 선형 증가할 때
+// t초까지 시작했어야 하는 연결 수 (= rate 곡선의 적분)
+int targetStarted(double t) {
+  if (opts.rate <= 0) {
+    return opts.conns;
+  }
+  double started;
+  if (t < opts.rampSecs) {
+    started = opts.rate * t * t / (2.0 * opts.rampSecs);
+  } else {
+    started = opts.rate * (t - opts.rampSecs / 2.0);
+  }
+  return started >= opts.conns ? opts.conns : (int)started;
+}
+
+// ============================================================
+// 메인 루프 / 리포트
+// ============================================================
+
+void printReport(double elapsed) {
+  std::cout << "==========================================" << std::endl;
+  std::cout << "  Results" << std::endl;
+  std::cout << "==========================================" << std::endl;
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "[*] Time elapsed: " << elapsed << " seconds" << std::endl;
+  std::cout << "[*] Connections successful: " << stats.connected << "/"
+            << opts.conns << std::endl;
+  std::cout << "[*] Connection failures: " << stats.connectFailed << std::endl;
+  uint64_t stillConnecting = 0;
+  for (size_t k = 0; k < conns.size(); ++k) {
+    if (conns[k].state == STATE_CONNECTING) {
+      stillConnecting++;
+    }
+  }
+  std::cout << "[*] Still connecting: " << stillConnecting << std::endl;
+  std::cout << "[*] Closed by server: " << stats.closedByServer << std::endl;
+  std::cout << "[*] Requests sent: " << stats.requests << std::endl;
+  std::cout << "[*] Responses received: " << stats.responses << std::endl;
+  std::cout << "[*] Bytes out/in: " << stats.bytesOut << " / " << stats.bytesIn
+            << std::endl;
+  if (elapsed > 0) {
+    std::cout << "[*] RPS (requests): " << stats.requests / elapsed
+              << std::endl;
+    std::cout << "[*] RPS (responses): " << stats.responses / elapsed
+              << std::endl;
+  }
+  stats.connectLatency.print("Connect latency");
+  stats.responseLatency.print(opts.scenario == SCENARIO_CHAT
+                                  ? "Join latency"
+                                  : "Response latency");
+  if (opts.scenario == SCENARIO_ECHO) {
+    uint64_t inflightBytes = 0;
+    for (size_t k = 0; k < conns.size(); ++k) {
+      if (conns[k].state != STATE_CLOSED) {
+        inflightBytes += conns[k].echoSent - conns[k].echoReceived;
+      }
+    }
+    std::cout << "[*] Echo verify: " << stats.bytesVerified
+              << " bytes checked, " << stats.bytesMismatch
+              << " mismatched, " << inflightBytes << " in flight "
+              << (stats.bytesMismatch == 0 && stats.closedByServer == 0
+                      ? "[PASS]"
+                      : "[FAIL]")
+              << std::endl;
+  }
+  if (opts.scenario == SCENARIO_CHAT) {
+    stats.wireLatency.print("Sender->receiver latency");
+  }
+  if (opts.scenario == SCENARIO_ZOMBIE) {
+    stats.zombieKick.print("Zombie kick after");
+  }
+  if (opts.scenario == SCENARIO_STORM && elapsed > 0) {
+    std::cout << "[*] Storm cycles: " << stats.cycles << std::endl;
+    std::cout << "[*] CPS (connect+echo+close): " << stats.cycles / elapsed
+              << std::endl;
+  }
+}
+
+void runLoop() {
+  struct epoll_event events[MAX_EVENTS];
+  int started = 0;
+  int64_t startTime = nowUs();
+  int64_t allStartedAt = 0;
+
+  while (true) {
+    int64_t now = nowUs();
+    double elapsed = (now - startTime) / 1e6;
+
+    // 1. 램프업 일정에 맞춰 새 연결 시작
+    int target = targetStarted(elapsed);
+    while (started < target) {
+      startConnect(started++);
+    }
+    if (started == opts.conns && allStartedAt == 0) {
+      allStartedAt = now;
+      std::cout << "[*] All " << opts.conns << " connections started in "
+                << elapsed << " seconds" << std::endl;
+    }
+    if (allStartedAt != 0 &&
+        now - allStartedAt >= (int64_t)(opts.durationSecs * 1e6)) {
+      printReport(elapsed);
+      return;
+    }
+
+    // 2. 채팅 주기가 된 연결들이 말하기
+    while (!talkTimers.empty() && talkTimers.top().first <= now) {
+      int id = talkTimers.top().second;
+      talkTimers.pop();
+      if (conns[id].state == STATE_RUNNING) {
+        sendTalk(id);
+        talkTimers.push(Timer(now + opts.talkIntervalMs * 1000LL, id));
+      }
+    }
+
+    // 3. 이벤트 처리 (램프업 중에는 1ms마다 깨어남)
+    int timeoutMs = 1;
+    int numEvents = epoll_wait(epollFd, events, MAX_EVENTS, timeoutMs);
+    if (numEvents < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      errorExit("epoll_wait() failed");
+    }
+    for (int i = 0; i < numEvents; i++) {
+      onEvent((int)events[i].data.u64, events[i].events);
+    }
+  }
+}
+
+void printUsage() {
+  std::cout << "Usage: ./load_generator [options]\n"
+               "  --host <host>          server ip or name (default 127.0.0.1)\n"
+               "  --port <port>          server port (default 9000)\n"
+               "  --scenario <name>      echo | chat | zombie | storm (default echo)\n"
+               "  --conns <n>            connections (default 1000)\n"
+               "  --rate <n>             new connections/sec, 0 = all at once\n"
+               "  --ramp <sec>           seconds to ramp up to --rate\n"
+               "  --duration <sec>       run time after all connects (10)\n"
+               "  --msg-size <bytes>     echo message size (default 64)\n"
+               "  --pipeline <n>         echo messages in flight per conn (1)\n"
+               "  --talk-interval <ms>   chat talk interval (default 1000)\n"
+               "  --room <n>             chat room (default 1)\n"
+               "  --src <ip,ip,...>      source IPs (port space per IP)\n";
+}
+
+bool parseOptions(int argc, char *argv[]) {
+  opts.host = "127.0.0.1";
+  opts.port = 9000;
+  opts.scenario = SCENARIO_ECHO;
+  opts.conns = 1000;
+  opts.rate = 0;
+  opts.rampSecs = 0;
+  opts.durationSecs = 10;
+  opts.msgSize = 64;
+  opts.pipeline = 1;
+  opts.talkIntervalMs = 1000;
+  opts.room = 1;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string key = argv[i];
+    std::string value = argv[i + 1];
+    if (key == "--host") {
+      opts.host = value;
+    } else if (key == "--port") {
+      opts.port = atoi(value.c_str());
+    } else if (key == "--scenario") {
+      if (value == "echo") {
+        opts.scenario = SCENARIO_ECHO;
+      } else if (value == "chat") {
+        opts.scenario = SCENARIO_CHAT;
+      } else if (value == "zombie") {
+        opts.scenario = SCENARIO_ZOMBIE;
+      } else if (value == "storm") {
+        opts.scenario = SCENARIO_STORM;
+      } else {
+        return false;
+      }
+    } else if (key == "--conns") {
+      opts.conns = atoi(value.c_str());
+    } else if (key == "--rate") {
+      opts.rate = atof(value.c_str());
+    } else if (key == "--ramp") {
+      opts.rampSecs = atof(value.c_str());
+    } else if (key == "--duration") {
+      opts.durationSecs = atof(value.c_str());
+    } else if (key == "--msg-size") {
+      opts.msgSize = atoi(value.c_str());
+    } else if (key == "--pipeline") {
+      opts.pipeline = atoi(value.c_str());
+    } else if (key == "--talk-interval") {
+      opts.talkIntervalMs = atoi(value.c_str());
+    } else if (key == "--room") {
+      opts.room = atoi(value.c_str());
+    } else if (key == "--src") {
+      size_t pos = 0;
+      while (pos <= value.size()) {
+        size_t comma = value.find(',', pos);
+        if (comma == std::string::npos) {
+          comma = value.size();
+        }
+        if (comma > pos) {
+          opts.sourceIps.push_back(value.substr(pos, comma - pos));
+        }
+        pos = comma + 1;
+      }
+    } else {
+      return false;
+    }
+  }
+  if ((argc - 1) % 2 != 0) {
+    return false;
+  }
+  return opts.conns > 0 && opts.msgSize > 0 && opts.pipeline > 0;
+}
+
+int main(int argc, char *argv[]) {
+  if (!parseOptions(argc, argv)) {
+    printUsage();
+    return 1;
+  }
+
+  const char *names[] = {"echo", "chat", "zombie", "storm"};
+  std::cout << "==========================================" << std::endl;
+  std::cout << "  Quest 4: Epoll Load Generator" << std::endl;
+  std::cout << "==========================================" << std::endl;
+  std::cout << "[*] Target: " << opts.host << ":" << opts.port << std::endl;
+  std::cout << "[*] Scenario: " << names[opts.scenario] << std::endl;
+  std::cout << "[*] Connections: " << opts.conns << " (rate "
+            << (opts.rate > 0 ? std::to_string((int)opts.rate) : "unlimited")
+            << "/s, ramp " << opts.rampSecs << "s)" << std::endl;
+  raiseFdLimit();
+
+  memset(&serverAddr, 0, sizeof(serverAddr));
+  serverAddr.sin_family = AF_INET;
+  serverAddr.sin_port = htons(opts.port);
+  if (!resolveHost(opts.host, &serverAddr.sin_addr)) {
+    return 1;
+  }
+
+  echoMessage.resize(opts.msgSize);
+
+  epollFd = epoll_create1(0);
+  if (epollFd < 0) {
+    errorExit("epoll_create1() failed");
+  }
+
+  conns.resize(opts.conns);
+  for (size_t k = 0; k < conns.size(); ++k) {
+    conns[k].fd = -1;
+    conns[k].state = STATE_CLOSED;
+  }
+
+  runLoop();
+
+  for (size_t k = 0; k < conns.size(); ++k) {
+    closeConn((int)k);
+  }
+  close(epollFd);
+  return 0;
+}
@@ -0,0 +1,413 @@
+/**
+ * [Task 15] 런타임 지표 레지스트리 + Prometheus 텍스트 출력 (헤더 전용, C++11)
+ *
+ *   metrics::Counter accepts =
+ *       metrics::counter("echo_accepts_total", "Accepted connections");
+ *   accepts.inc();                                   // 핫 패스 (락 X, 원자 RMW X)
+ *
+ *   int admin = metrics::createAdminListener(9100);  // 127.0.0.1 전용
+ *   // 리액터의 epoll / select에 admin을 같이 등록하고, 읽을 수 있으면:
+ *   metrics::serveAdmin(clientFd);                   // GET /metrics 응답
+ *
+ * - 스레드마다 샤드(값 배열) 하나: 쓰는 스레드가 자기 샤드만 고치므로
+ *   load + store (relaxed) 두 개로 끝남 -> lock add / 캐시 라인 핑퐁 X
+ * - 샤드는 스레드별로 mmap (페이지 단위라 다른 스레드와 캐시 라인 공유 X)
+ * - 읽을 때(스크레이프) 모든 샤드를 더함 -> 쓰기 비용 최소, 읽기는 드물게
+ * - Gauge도 스레드별 값의 합 (예: 리액터별 접속 수 -> 전체 접속 수)
+ * - Histogram은 2의 거듭제곱 버킷 (le = 2^k * scale), 누적 합은 출력 때 계산
+ * - 지표 등록(counter/gauge/histogram)은 스레드를 띄우기 전에 main에서
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace metrics {
+
+const int MAX_VALUES = 64;     // counter + gauge 합계
+const int MAX_HISTOGRAMS = 8;
+const int HISTOGRAM_BUCKETS = 32; // le = 2^0 .. 2^31 (x scale), 나머지는 +Inf
+const int MAX_SHARDS = 256;       // 지표를 남기는 스레드 수 한도
+
+enum Kind { KIND_COUNTER, KIND_GAUGE };
+
+struct ValueDesc {
+  const char *name; // 라벨 포함 가능: "echo_eagain_total{op=\"send\"}"
+  const char *help;
+  int kind;
+};
+
+struct HistogramDesc {
+  const char *name;
+  const char *help;
+  double scale;    // 기록 단위 -> 출력 단위 (ns -> 초면 1e-9)
+  int buckets;     // 출력할 버킷 수 (<= HISTOGRAM_BUCKETS)
+};
+
+struct HistogramCells {
+  std::atomic<uint64_t> buckets[HISTOGRAM_BUCKETS + 1]; // 마지막 = 범위 밖
+  std::atomic<uint64_t> count;
+  std::atomic<uint64_t> sum;
+};
+
+struct Shard {
+  std::atomic<int64_t> values[MAX_VALUES];
+  HistogramCells histograms[MAX_HISTOGRAMS];
+};
+
+struct Registry {
+  ValueDesc values[MAX_VALUES];
+  std::atomic<int> valueCount;
+  HistogramDesc histograms[MAX_HISTOGRAMS];
+  std::atomic<int> histogramCount;
+  std::atomic<Shard *> shards[MAX_SHARDS];
+  std::atomic<int> shardCount;
+
+  Registry() : valueCount(0), histogramCount(0), shardCount(0) {
+    for (int i = 0; i < MAX_SHARDS; i++) {
+      shards[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+};
+
+inline Registry &registry() {
+  static Registry r;
+  return r;
+}
+
+// 0으로 채워진 mmap 페이지 (operator new X -> 핫 패스 할당 계수에 안 잡힘)
+inline Shard *mapShard() {
+  void *p = mmap(nullptr, sizeof(Shard), PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  return p == MAP_FAILED ? nullptr : static_cast<Shard *>(p);
+}
+
+/**
+ * 이 스레드의 샤드. 한도를 넘은 스레드는 아무도 읽지 않는 샤드에 씀 (유실).
+ */
+inline Shard *threadShard() {
+  static thread_local Shard *shard = nullptr;
+  if (shard == nullptr) {
+    Registry &r = registry();
+    int index = r.shardCount.fetch_add(1, std::memory_order_relaxed);
+    shard = mapShard();
+    if (shard == nullptr) {
+      static Shard *lost = mapShard();
+      shard = lost;
+    } else if (index < MAX_SHARDS) {
+      r.shards[index].store(shard, std::memory_order_release);
+    }
+  }
+  return shard;
+}
+
+// 단일 작성자 증가: 같은 샤드는 자기 스레드만 쓰므로 RMW 불필요
+inline void bump(std::atomic<int64_t> &cell, int64_t delta) {
+  cell.store(cell.load(std::memory_order_relaxed) + delta,
+             std::memory_order_relaxed);
+}
+
+inline void bump(std::atomic<uint64_t> &cell, uint64_t delta) {
+  cell.store(cell.load(std::memory_order_relaxed) + delta,
+             std::memory_order_relaxed);
+}
+
+class Counter {
+public:
+  explicit Counter(int id = -1) : id_(id) {}
+  void inc() const { add(1); }
+  void add(uint64_t n) const {
+    if (id_ >= 0) {
+      bump(threadShard()->values[id_], (int64_t)n);
+    }
+  }
+
+private:
+  int id_;
+};
+
+class Gauge {
+public:
+  explicit Gauge(int id = -1) : id_(id) {}
+  // 이 스레드 몫을 설정 (출력은 모든 스레드 몫의 합)
+  void set(int64_t v) const {
+    if (id_ >= 0) {
+      threadShard()->values[id_].store(v, std::memory_order_relaxed);
+    }
+  }
+  void add(int64_t delta) const {
+    if (id_ >= 0) {
+      bump(threadShard()->values[id_], delta);
+    }
+  }
+
+private:
+  int id_;
+};
+
+class Histogram {
+public:
+  explicit Histogram(int id = -1) : id_(id) {}
+  void record(uint64_t value) const {
+    if (id_ < 0) {
+      return;
+    }
+    // 버킷 k: value <= 2^k 인 가장 작은 k
+    int k = value <= 1 ? 0 : 64 - __builtin_clzll(value - 1);
+    if (k > HISTOGRAM_BUCKETS) {
+      k = HISTOGRAM_BUCKETS;
+    }
+    HistogramCells &cells = threadShard()->histograms[id_];
+    bump(cells.buckets[k], 1);
+    bump(cells.count, 1);
+    bump(cells.sum, value);
+  }
+
+private:
+  int id_;
+};
+
+inline int addValue(const char *name, const char *help, int kind) {
+  Registry &r = registry();
+  int id = r.valueCount.load(std::memory_order_relaxed);
+  if (id >= MAX_VALUES) {
+    return -1; // 한도 초과: 아무것도 안 하는 핸들
+  }
+  r.values[id].name = name;
+  r.values[id].help = help;
+  r.values[id].kind = kind;
+  r.valueCount.store(id + 1, std::memory_order_release);
+  return id;
+}
+
+inline Counter counter(const char *name, const char *help) {
+  return Counter(addValue(name, help, KIND_COUNTER));
+}
+
+inline Gauge gauge(const char *name, const char *help) {
+  return Gauge(addValue(name, help, KIND_GAUGE));
+}
+
+inline Histogram histogram(const char *name, const char *help, double scale,
+                           int buckets) {
+  Registry &r = registry();
+  int id = r.histogramCount.load(std::memory_order_relaxed);
+  if (id >= MAX_HISTOGRAMS) {
+    return Histogram(-1);
+  }
+  r.histograms[id].name = name;
+  r.histograms[id].help = help;
+  r.histograms[id].scale = scale;
+  r.histograms[id].buckets =
+      buckets < HISTOGRAM_BUCKETS ? buckets : HISTOGRAM_BUCKETS;
+  r.histogramCount.store(id + 1, std::memory_order_release);
+  return Histogram(id);
+}
+
+inline uint64_t nowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// ============================================================
+// 읽기 (모든 샤드 합산) + Prometheus 텍스트
+// ============================================================
+
+inline int64_t readValue(int id) {
+  Registry &r = registry();
+  int64_t total = 0;
+  int count = r.shardCount.load(std::memory_order_acquire);
+  for (int i = 0; i < count && i < MAX_SHARDS; i++) {
+    Shard *shard = r.shards[i].load(std::memory_order_acquire);
+    if (shard != nullptr) {
+      total += shard->values[id].load(std::memory_order_relaxed);
+    }
+  }
+  return total;
+}
+
+// "name{labels}" 에서 name 부분 길이
+inline size_t baseNameLength(const char *name) {
+  const char *brace = strchr(name, '{');
+  return brace ? (size_t)(brace - name) : strlen(name);
+}
+
+inline void appendHeader(std::string &out, const char *name, size_t len,
+                         const char *help, const char *type) {
+  out += "# HELP ";
+  out.append(name, len);
+  out += ' ';
+  out += help;
+  out += "\n# TYPE ";
+  out.append(name, len);
+  out += ' ';
+  out += type;
+  out += '\n';
+}
+
+inline void appendNumber(std::string &out, double v) {
+  char tmp[32];
+  snprintf(tmp, sizeof(tmp), "%.15g", v);
+  out += tmp;
+}
+
+inline void appendNumber(std::string &out, int64_t v) {
+  char tmp[24];
+  snprintf(tmp, sizeof(tmp), "%lld", (long long)v);
+  out += tmp;
+}
+
+inline void render(std::string &out) {
+  Registry &r = registry();
+
+  // counter / gauge: 같은 이름(라벨만 다름)은 HELP/TYPE를 한 번만
+  int valueCount = r.valueCount.load(std::memory_order_acquire);
+  const char *prevName = nullptr;
+  size_t prevLen = 0;
+  for (int id = 0; id < valueCount; id++) {
+    const ValueDesc &d = r.values[id];
+    size_t len = baseNameLength(d.name);
+    if (prevName == nullptr || len != prevLen ||
+        strncmp(prevName, d.name, len) != 0) {
+      appendHeader(out, d.name, len, d.help,
+                   d.kind == KIND_COUNTER ? "counter" : "gauge");
+      prevName = d.name;
+      prevLen = len;
+    }
+    out += d.name;
+    out += ' ';
+    appendNumber(out, readValue(id));
+    out += '\n';
+  }
+
+  int histogramCount = r.histogramCount.load(std::memory_order_acquire);
+  int shardCount = r.shardCount.load(std::memory_order_acquire);
+  for (int id = 0; id < histogramCount; id++) {
+    const HistogramDesc &d = r.histograms[id];
+    uint64_t buckets[HISTOGRAM_BUCKETS + 1] = {0};
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    for (int i = 0; i < shardCount && i < MAX_SHARDS; i++) {
+      Shard *shard = r.shards[i].load(std::memory_order_acquire);
+      if (shard == nullptr) {
+        continue;
+      }
+      const HistogramCells &cells = shard->histograms[id];
+      for (int k = 0; k <= HISTOGRAM_BUCKETS; k++) {
+        buckets[k] += cells.buckets[k].load(std::memory_order_relaxed);
+      }
+      count += cells.count.load(std::memory_order_relaxed);
+      sum += cells.sum.load(std::memory_order_relaxed);
+    }
+
+    size_t len = strlen(d.name);
+    appendHeader(out, d.name, len, d.help, "histogram");
+    uint64_t cumulative = 0;
+    for (int k = 0; k < d.buckets; k++) {
+      cumulative += buckets[k];
+      out += d.name;
+      out += "_bucket{le=\"";
+      appendNumber(out, (double)(1ULL << k) * d.scale);
+      out += "\"} ";
+      appendNumber(out, (int64_t)cumulative);
+      out += '\n';
+    }
+    // 출력 범위 밖 버킷과 +Inf (count와 같아야 함)
+    out += d.name;
+    out += "_bucket{le=\"+Inf\"} ";
+    appendNumber(out, (int64_t)count);
+    out += '\n';
+    out += d.name;
+    out += "_sum ";
+    appendNumber(out, (double)sum * d.scale);
+    out += '\n';
+    out += d.name;
+    out += "_count ";
+    appendNumber(out, (int64_t)count);
+    out += '\n';
+  }
+}
+
+// ============================================================
+// 관리 포트 (127.0.0.1, HTTP/1.0 한 번 응답 후 닫음)
+// ============================================================
+
+/**
+ * 관리 포트 리스너 (Non-blocking, 로컬 전용)
+ * @return -1: 실패
+ */
+inline int createAdminListener(int port) {
+  int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    return -1;
+  }
+  int one = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(port);
+  if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+      listen(fd, 16) < 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+/**
+ * 요청이 도착한 관리 연결에 지표를 응답하고 닫음.
+ * 요청 내용은 보지 않음 (경로와 상관없이 /metrics). 응답은 수십 KB 이하라
+ * 소켓을 blocking으로 돌려서 한 번에 보냄 (스크레이프는 드물고 로컬이라 짧음).
+ * @return false: 아직 요청이 안 옴 (EAGAIN) -> 다음 읽기 이벤트에서 다시
+ */
+inline bool serveAdmin(int fd) {
+  char request[2048];
+  ssize_t n = recv(fd, request, sizeof(request), 0);
+  if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+    return false;
+  }
+  if (n > 0) {
+    std::string body;
+    body.reserve(16 * 1024);
+    render(body);
+
+    char header[160];
+    int headerLen =
+        snprintf(header, sizeof(header),
+                 "HTTP/1.0 200 OK\r\n"
+                 "Content-Type: text/plain; version=0.0.4\r\n"
+                 "Content-Length: %zu\r\n\r\n",
+                 body.size());
+    body.insert(0, header, (size_t)headerLen);
+
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags & ~O_NONBLOCK);
+    size_t off = 0;
+    while (off < body.size()) {
+      ssize_t sent =
+          send(fd, body.data() + off, body.size() - off, MSG_NOSIGNAL);
+      if (sent <= 0) {
+        break;
+      }
+      off += (size_t)sent;
+    }
+  }
+  close(fd);
+  return true;
+}
+
+} // namespace metrics
@@ -0,0 +1,61 @@
+#!/usr/bin/env bash
+# ⚔️ Quest 4: Multi-reactor Scaling Benchmark
+#
+# 리액터 수를 1 -> N 으로 늘려가며 echo 처리량(RPS)을 측정하고 CSV로 출력.
+# 부하 생성기 1개가 먼저 포화되지 않도록 LOADGEN_PROCS개를 동시에 돌려서 합산.
+#
+# 사용법: ./scaling_bench.sh [max_threads] [conns_per_loadgen] [duration_sec]
+# 예시:   LOADGEN_PROCS=8 STEER=cpu ./scaling_bench.sh 32 2000 10
+#
+# 준비:
+#   g++ -o epoll_server epoll_echo_server.cpp -std=c++11 -O2 -pthread
+#   g++ -o load_generator load_generator.cpp -std=c++11 -O2
+
+MAX_THREADS=${1:-$(nproc)}
+CONNS=${2:-1000}
+DURATION=${3:-5}
+PORT=${PORT:-9100}
+STEER=${STEER:-none}
+LOADGEN_PROCS=${LOADGEN_PROCS:-4}
+
+# 1, 2, 4, 8 ... MAX_THREADS
+thread_counts=()
+t=1
+while [ "$t" -lt "$MAX_THREADS" ]; do
+  thread_counts+=("$t")
+  t=$((t * 2))
+done
+thread_counts+=("$MAX_THREADS")
+
+echo "threads,rps,speedup"
+base_rps=""
+
+for threads in "${thread_counts[@]}"; do
+  ./epoll_server "$PORT" et --threads "$threads" --steer "$STEER" > /dev/null 2>&1 &
+  server_pid=$!
+  sleep 0.5
+
+  # 부하 생성기 여러 개를 동시에 실행하고 RPS 합산
+  outputs=()
+  pids=()
+  for i in $(seq 1 "$LOADGEN_PROCS"); do
+    out=$(mktemp)
+    outputs+=("$out")
+    ./load_generator --port "$PORT" --conns "$CONNS" --rate 5000 \
+      --duration "$DURATION" > "$out" 2>&1 &
+    pids+=($!)
+  done
+  wait "${pids[@]}"
+
+  rps=$(cat "${outputs[@]}" | awk '/RPS \(responses\)/ { sum += $4 } END { printf "%.0f", sum }')
+  rm -f "${outputs[@]}"
+
+  kill "$server_pid"
+  wait "$server_pid" 2> /dev/null
+
+  if [ -z "$base_rps" ]; then
+    base_rps=$rps
+  fi
+  speedup=$(awk -v r="$rps" -v b="$base_rps" 'BEGIN { if (b > 0) printf "%.2f", r / b; else print 0 }')
+  echo "$threads,$rps,$speedup"
+done
@@ -0,0 +1,127 @@
+#!/usr/bin/env bash
+# ⚔️ Quest 4: Tick Deferral Test
+#
+# 1) 미루기: 틱 모드(ET)에서 --tick-work로 입력 예산이 매 구간 바닥나게 만든
+#    뒤, 여러 연결이 동시에 보내면서 조금씩만 읽는다 (수신 버퍼 8K, 못 돌려받은
+#    양은 1MB까지 - 버퍼 풀 최대 클래스 512K보다 많이). 서버 outBuf가
+#    HIGH_WATER_MARK를 넘나들어 읽기 중단/재개를 반복하는 동안 연결들이
+#    EPOLLIN으로 미뤄지고, 그 사이 EPOLLOUT 엣지가 온다.
+#      - 미뤄 둔 연결에 온 EPOLLOUT을 버리면 밀린 출력이 안 비워져서 멈춤
+#      - 예산에 걸린 연결이 매번 맨 앞에 다시 서면 나머지 연결이 굶음
+#    -> 모든 연결이 보낸 바이트를 전부 돌려받는지 (5초 동안 진척 없으면 실패)
+# 2) 대량 파이프라인: 느린 틱(10Hz, 예산 없음)에 64KB x 64개씩 밀어 넣음.
+#    한 틱에 받는 입력이 연결마다 HIGH_WATER_MARK로 묶이지 않으면 outBuf가
+#    512K를 넘어 "Buffer pool exhausted"로 끊김 -> 끊긴 연결 0, 검증 PASS
+#
+# 사용법: ./tick_defer_test.sh [clients] [bytes_per_client]
+# 예시:   ./tick_defer_test.sh 16 1048576
+#
+# 준비:
+#   g++ -o epoll_server epoll_echo_server.cpp -std=c++11 -O2 -pthread
+#   g++ -o load_generator load_generator.cpp -std=c++11 -O2
+
+CLIENTS=${1:-16}
+BYTES=${2:-1048576}
+PORT=${PORT:-9100}
+
+echo "[1] 미루기 (ET, 입력 예산 소진, 밀린 출력)"
+
+log=$(mktemp)
+./epoll_server "$PORT" et --tick 60 --tick-work 500 > "$log" 2>&1 &
+server_pid=$!
+sleep 0.5
+
+ruby - "$PORT" "$CLIENTS" "$BYTES" <<'RUBY'
+require 'socket'
+
+port, clients, bytes = ARGV[0].to_i, ARGV[1].to_i, ARGV[2].to_i
+chunk = 'x' * 16384
+window = 1024 * 1024
+
+# 예열: 틱마다 조금씩 보내서 입력 예산(틱당 처리 비용 추정)을 먼저 맞춰 둠
+warm = TCPSocket.new('127.0.0.1', port)
+60.times do
+  warm.write('w' * 1024)
+  warm.read(1024)
+  sleep 0.02
+end
+warm.close
+
+results = clients.times.map do
+  Thread.new do
+    # 수신 버퍼를 작게 -> 조금씩만 읽혀서 서버에 EPOLLOUT 엣지가 자주 옴
+    sock = Socket.new(:INET, :STREAM)
+    sock.setsockopt(Socket::SOL_SOCKET, Socket::SO_RCVBUF, 8192)
+    sock.connect(Socket.sockaddr_in(port, '127.0.0.1'))
+    sent = 0
+    received = 0
+    last_progress = Time.now
+    # 보내기와 읽기를 같이, 단 못 돌려받은 양은 WINDOW까지만
+    # (서버 outBuf가 HIGH_WATER_MARK를 넘어 읽기 중단 상태를 오가게)
+    while received < bytes && Time.now - last_progress < 5
+      want_write = sent < bytes && sent - received < window
+      r, w = IO.select([sock], want_write ? [sock] : nil, nil, 0.5)
+      if w && !w.empty?
+        n = sock.write_nonblock(chunk[0, [chunk.size, bytes - sent].min],
+                                exception: false)
+        if n.is_a?(Integer)
+          sent += n
+          last_progress = Time.now
+        end
+      end
+      if r && !r.empty?
+        data = sock.read_nonblock(4096, exception: false)
+        break if data.nil?
+        unless data == :wait_readable
+          received += data.bytesize
+          last_progress = Time.now
+        end
+      end
+    end
+    sock.close
+    [sent, received]
+  end
+end.map(&:value)
+
+stalled = results.count { |sent, received| received < bytes }
+total = results.sum { |sent, _| sent }
+puts "[*] clients=#{clients} sent=#{total} stalled=#{stalled}"
+results.each_with_index { |(s, r), i| puts "    client #{i}: sent=#{s} received=#{r}" if r < bytes }
+exit(stalled.zero? ? 0 : 1)
+RUBY
+status=$?
+
+kill -INT "$server_pid"
+wait "$server_pid"
+
+grep "Tick:" "$log" | tail -1
+if [ "$status" -eq 0 ] && grep "Tick:" "$log" | tail -1 | grep -qv "throttles=0 "; then
+  echo "[PASS] 입력 예산이 바닥난 상태에서도 밀린 출력을 끝까지 보냄"
+else
+  echo "[FAIL] 돌려받지 못한 연결이 있음 (또는 예산이 한 번도 안 걸림)"
+  status=1
+fi
+[ "$status" -eq 0 ] && rm -f "$log" || echo "[*] 서버 로그: $log"
+
+echo "[2] 대량 파이프라인 (10Hz, --tick-fixed, 64KB x 64)"
+log=$(mktemp)
+./epoll_server "$PORT" et --tick 10 --tick-fixed > "$log" 2>&1 &
+server_pid=$!
+sleep 0.5
+report=$(./load_generator --port "$PORT" --scenario echo --conns 4 \
+  --pipeline 64 --msg-size 65536 --duration 3)
+kill -INT "$server_pid"
+wait "$server_pid"
+
+echo "$report" | grep "Closed by server\|Echo verify"
+grep "Buffer pool:" "$log"
+if echo "$report" | grep -q "Closed by server: 0" &&
+  echo "$report" | grep "Echo verify" | grep -q "\[PASS\]" &&
+  grep -q "exhausted=0 " "$log"; then
+  echo "[PASS] 한 틱 입력이 연결마다 HIGH_WATER_MARK로 묶여서 끊긴 연결 없음"
+  rm -f "$log"
+else
+  echo "[FAIL] 대량 파이프라인 연결이 끊김 (서버 로그: $log)"
+  status=1
+fi
+exit "$status"